@@ -336,6 +336,9 @@ void application_impl::set_api_limit() {
    if(_options->count("api-limit-get-htlc-by")) {
       _app_options.api_limit_get_htlc_by = _options->at("api-limit-get-htlc-by").as<uint64_t>();
    }
+   if(_options->count("api-limit-get-blocks")) {
+      _app_options.api_limit_get_blocks = _options->at("api-limit-get-blocks").as<uint64_t>();
+   }
 }
 
 void application_impl::startup(const seeds_type &external_seeds)
@@ -348,7 +351,7 @@ void application_impl::startup(const seeds_type &external_seeds)
       {
          std::string genesis_str;
          fc::read_file_contents( _options->at("genesis-json").as<boost::filesystem::path>(), genesis_str );
-         graphene::chain::genesis_state_type genesis = fc::json::from_string( genesis_str ).as<graphene::chain::genesis_state_type>( 20 );
+         graphene::chain::genesis_state_type genesis = graphene::chain::parse_genesis_state( genesis_str, 20 );
          bool modified_genesis = false;
          if( _options->count("genesis-timestamp") )
          {
@@ -388,7 +391,7 @@ void application_impl::startup(const seeds_type &external_seeds)
          graphene::egenesis::compute_egenesis_json( egenesis_json );
          FC_ASSERT( egenesis_json != "" );
          FC_ASSERT( graphene::egenesis::get_egenesis_json_hash() == fc::sha256::hash( egenesis_json ) );
-         auto genesis = fc::json::from_string( egenesis_json ).as<graphene::chain::genesis_state_type>( 20 );
+         auto genesis = graphene::chain::parse_genesis_state( egenesis_json, 20 );
          genesis.initial_chain_id = fc::sha256::hash( egenesis_json );
          return genesis;
       }
@@ -415,6 +418,17 @@ void application_impl::startup(const seeds_type &external_seeds)
       _chain_db->enable_standby_votes_tracking( _options->at("enable-standby-votes-tracking").as<bool>() );
    }
 
+   if( _options->count("block-header-cache-size") || _options->count("block-cache-size-mb") )
+   {
+      uint32_t max_headers = block_database::default_header_cache_size;
+      uint64_t max_block_bytes = 0;
+      if( _options->count("block-header-cache-size") )
+         max_headers = _options->at("block-header-cache-size").as<uint32_t>();
+      if( _options->count("block-cache-size-mb") )
+         max_block_bytes = _options->at("block-cache-size-mb").as<uint64_t>() * 1024 * 1024;
+      _chain_db->set_block_cache_limits( max_headers, max_block_bytes );
+   }
+
    if( _options->count("replay-blockchain") || _options->count("revalidate-blockchain") )
       _chain_db->wipe( _data_dir / "blockchain", false );
 
@@ -459,6 +473,9 @@ void application_impl::startup(const seeds_type &external_seeds)
    if ( _options->count("enable-subscribe-to-all") )
       _app_options.enable_subscribe_to_all = _options->at( "enable-subscribe-to-all" ).as<bool>();
 
+   if ( _options->count("enable-memory-usage-api") )
+      _app_options.enable_memory_usage_api = _options->at( "enable-memory-usage-api" ).as<bool>();
+
    set_api_limit();
 
    if( _active_plugins.find( "market_history" ) != _active_plugins.end() )
@@ -1009,9 +1026,15 @@ void application::set_program_options(boost::program_options::options_descriptio
          ("io-threads", bpo::value<uint16_t>()->implicit_value(0), "Number of IO threads, default to 0 for auto-configuration")
          ("enable-subscribe-to-all", bpo::value<bool>()->implicit_value(true),
           "Whether allow API clients to subscribe to universal object creation and removal events")
+         ("enable-memory-usage-api", bpo::value<bool>()->implicit_value(true),
+          "Whether allow API clients to request memory usage of the object indexes (walks all objects)")
          ("enable-standby-votes-tracking", bpo::value<bool>()->implicit_value(true),
           "Whether to enable tracking of votes of standby witnesses and committee members. "
           "Set it to true to provide accurate data to API clients, set to false for slightly better performance.")
+         ("block-header-cache-size", bpo::value<uint32_t>()->default_value(block_database::default_header_cache_size),
+          "Number of recently used block headers kept in memory for API and entropy lookups")
+         ("block-cache-size-mb", bpo::value<uint64_t>()->default_value(0),
+          "Memory budget in MB for recently used full blocks kept in memory, 0 to disable")
          ("plugins", bpo::value<string>(), "Space-separated list of plugins to activate")
          ("api-limit-get-account-history-operations",boost::program_options::value<uint64_t>()->default_value(100),
           "For history_api::get_account_history_operations to set its default limit value as 100")
@@ -1027,6 +1050,8 @@ void application::set_program_options(boost::program_options::options_descriptio
           "For asset_api::get_asset_holders to set its default limit value as 100")
 		   ("api-limit-get-key-references",boost::program_options::value<uint64_t>()->default_value(100),
 		    "For database_api_impl::get_key_references to set its default limit value as 100")
+         ("api-limit-get-blocks",boost::program_options::value<uint64_t>()->default_value(100),
+          "For database_api_impl::get_blocks to set its default limit value as 100")
          ("replay-blockchain", "Rebuild object graph by replaying all blocks without validation")
          ("resync-blockchain", "Delete all blocks and re-sync with network from scratch")
          ("revalidate-blockchain", "Rebuild object graph by replaying all blocks with full validation")
@@ -23,6 +23,7 @@
  */
 
 #include <graphene/app/database_api.hpp>
+#include <graphene/app/notification_bus.hpp>
 #include <graphene/app/util.hpp>
 #include <graphene/chain/get_config.hpp>
 #include <graphene/chain/hardfork.hpp>
@@ -37,6 +38,7 @@
 #include <boost/multiprecision/cpp_int.hpp>
 
 #include <cctype>
+#include <mutex>
 
 #include <cfenv>
 #include <iostream>
@@ -47,7 +49,7 @@ typedef std::map< std::pair<graphene::chain::asset_id_type, graphene::chain::ass
 
 namespace graphene { namespace app {
 
-class database_api_impl : public std::enable_shared_from_this<database_api_impl>
+class database_api_impl : public std::enable_shared_from_this<database_api_impl>, public notification_subscriber
 {
    public:
       explicit database_api_impl( graphene::chain::database& db, const application_options* app_options );
@@ -67,6 +69,7 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
       optional<block_header> get_block_header(uint32_t block_num)const;
       map<uint32_t, optional<block_header>> get_block_header_batch(const vector<uint32_t> block_nums)const;
       optional<signed_block> get_block(uint32_t block_num)const;
+      vector<signed_block> get_blocks(uint32_t block_num_from, uint32_t count)const;
       processed_transaction get_transaction( uint32_t block_num, uint32_t trx_in_block )const;
 
       // Globals
@@ -75,6 +78,7 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
       fc::variant_object get_config()const;
       chain_id_type get_chain_id()const;
       dynamic_global_property_object get_dynamic_global_properties()const;
+      vector<index_memory_usage> get_objects_memory_usage()const;
 
       // Keys
       vector<vector<account_id_type>> get_key_references( vector<public_key_type> key )const;
@@ -122,6 +126,7 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
       market_ticker                      get_ticker( const string& base, const string& quote, bool skip_order_book = false )const;
       market_volume                      get_24_volume( const string& base, const string& quote )const;
       order_book                         get_order_book( const string& base, const string& quote, unsigned limit = 50 )const;
+      order_book                         get_order_book_levels( const string& base, const string& quote, unsigned limit = 50 )const;
       vector<market_ticker>              get_top_markets( uint32_t limit )const;
       vector<market_trade>               get_trade_history( const string& base, const string& quote, fc::time_point_sec start, fc::time_point_sec stop, unsigned limit = 100 )const;
       vector<market_trade>               get_trade_history_by_sequence( const string& base, const string& quote, int64_t start, fc::time_point_sec stop, unsigned limit = 100 )const;
@@ -183,6 +188,7 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
          if( !_subscribe_callback )
             return;
 
+         std::lock_guard<std::mutex> guard( _subscription_mutex );
          if( !is_subscribed_to_item(i) )
             _subscribe_filter.insert( vec.data(), vec.size() );
       }
@@ -206,15 +212,6 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
          });
       }
 
-      const std::pair<asset_id_type,asset_id_type> get_order_market( const force_settlement_object& order )
-      {
-         // TODO cache the result to avoid repeatly fetching from db
-         asset_id_type backing_id = order.balance.asset_id( _db ).bitasset_data( _db ).options.short_backing_asset;
-         auto tmp = std::make_pair( order.balance.asset_id, backing_id );
-         if( tmp.first > tmp.second ) std::swap( tmp.first, tmp.second );
-         return tmp;
-      }
-
       const account_object* get_account_from_string( const std::string& name_or_id ) const
       {
          // TODO cache the result to avoid repeatly fetching from db
@@ -296,36 +293,20 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
          return result;
       }
 
-      template<typename T>
-      const std::pair<asset_id_type,asset_id_type> get_order_market( const T& order )
-      {
-         return order.get_market();
-      }
+      void broadcast_updates( const vector<variant>& updates, fc::thread& chain_thread );
+      void broadcast_market_updates( const market_queue_type& queue, fc::thread& chain_thread );
 
-      template<typename T>
-      void enqueue_if_subscribed_to_market(const object* obj, market_queue_type& queue, bool full_object=true)
-      {
-         const T* order = dynamic_cast<const T*>(obj);
-         FC_ASSERT( order != nullptr);
-
-         const auto& market = get_order_market( *order );
+      /// the notifications of the database come through the node-wide bus since the first subscription
+      void enable_notifications();
 
-         auto sub = _market_subscriptions.find( market );
-         if( sub != _market_subscriptions.end() ) {
-            queue[market].emplace_back( full_object ? obj->to_variant() : fc::variant(obj->id, 1) );
-         }
-      }
-
-      void broadcast_updates( const vector<variant>& updates );
-      void broadcast_market_updates( const market_queue_type& queue);
-      void handle_object_changed(bool force_notify, bool full_object, const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts, std::function<const object*(object_id_type id)> find_object);
-
-      /** called every time a block is applied to report the objects that were changed */
-      void on_objects_new(const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts);
-      void on_objects_changed(const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts);
-      void on_objects_removed(const vector<object_id_type>& ids, const vector<const object*>& objs, const flat_set<account_id_type>& impacted_accounts);
-      void on_applied_block();
+      /** called on the thread of the notification bus to report the objects that were changed */
+      void on_objects( const object_notification& n, fc::thread& chain_thread ) override;
+      void on_block( const block_notification& n, fc::thread& chain_thread ) override;
 
+      /// guards the subscriptions read by the filters on the thread of the notification bus
+      mutable std::mutex _subscription_mutex;
+      std::shared_ptr<notification_bus> _notification_bus;
+      bool _notifications_enabled = false;
       bool _notify_remove_create = false;
       mutable fc::bloom_filter _subscribe_filter;
       std::set<account_id_type> _subscribed_accounts;
@@ -333,10 +314,6 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
       std::function<void(const fc::variant&)> _pending_trx_callback;
       std::function<void(const fc::variant&)> _block_applied_callback;
 
-      boost::signals2::scoped_connection                                                                                           _new_connection;
-      boost::signals2::scoped_connection                                                                                           _change_connection;
-      boost::signals2::scoped_connection                                                                                           _removed_connection;
-      boost::signals2::scoped_connection                                                                                           _applied_block_connection;
       boost::signals2::scoped_connection                                                                                           _pending_trx_connection;
       map< pair<asset_id_type,asset_id_type>, std::function<void(const variant&)> >      _market_subscriptions;
       graphene::chain::database&                                                                                                            _db;
@@ -359,16 +336,7 @@ database_api_impl::database_api_impl( graphene::chain::database& db, const appli
 :_db(db), _app_options(app_options)
 {
    dlog("creating database API ${x}", ("x",int64_t(this)) );
-   _new_connection = _db.new_objects.connect([this](const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts) {
-                                on_objects_new(ids, impacted_accounts);
-                                });
-   _change_connection = _db.changed_objects.connect([this](const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts) {
-                                on_objects_changed(ids, impacted_accounts);
-                                });
-   _removed_connection = _db.removed_objects.connect([this](const vector<object_id_type>& ids, const vector<const object*>& objs, const flat_set<account_id_type>& impacted_accounts) {
-                                on_objects_removed(ids, objs, impacted_accounts);
-                                });
-   _applied_block_connection = _db.applied_block.connect([this](const signed_block&){ on_applied_block(); });
+   _notification_bus = notification_bus::get( _db );
 
    _pending_trx_connection = _db.on_pending_transaction.connect([this](const signed_transaction& trx ){
                          if( _pending_trx_callback ) _pending_trx_callback( fc::variant(trx, GRAPHENE_MAX_NESTED_OBJECTS) );
@@ -378,6 +346,7 @@ database_api_impl::database_api_impl( graphene::chain::database& db, const appli
 database_api_impl::~database_api_impl()
 {
    dlog("freeing database API ${x}", ("x",int64_t(this)) );
+   _notification_bus->unsubscribe( this );
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -502,8 +471,13 @@ void database_api_impl::set_subscribe_callback( std::function<void(const variant
 
    cancel_all_subscriptions(false, false);
 
-   _subscribe_callback = cb;
-   _notify_remove_create = notify_remove_create;
+   {
+      std::lock_guard<std::mutex> guard( _subscription_mutex );
+      _subscribe_callback = cb;
+      _notify_remove_create = notify_remove_create;
+   }
+
+   enable_notifications();
 }
 
 void database_api::set_pending_transaction_callback( std::function<void(const variant&)> cb )
@@ -523,7 +497,12 @@ void database_api::set_block_applied_callback( std::function<void(const variant&
 
 void database_api_impl::set_block_applied_callback( std::function<void(const variant& block_id)> cb )
 {
-   _block_applied_callback = cb;
+   {
+      std::lock_guard<std::mutex> guard( _subscription_mutex );
+      _block_applied_callback = cb;
+   }
+
+   enable_notifications();
 }
 
 void database_api::cancel_all_subscriptions()
@@ -533,6 +512,8 @@ void database_api::cancel_all_subscriptions()
 
 void database_api_impl::cancel_all_subscriptions( bool reset_callback, bool reset_market_subscriptions )
 {
+   std::lock_guard<std::mutex> guard( _subscription_mutex );
+
    if ( reset_callback )
       _subscribe_callback = std::function<void(const fc::variant&)>();
 
@@ -558,7 +539,7 @@ optional<block_header> database_api::get_block_header(uint32_t block_num)const
 
 optional<block_header> database_api_impl::get_block_header(uint32_t block_num) const
 {
-   auto result = _db.fetch_block_by_number(block_num);
+   auto result = _db.fetch_block_header_by_number(block_num);
    if(result)
       return *result;
    return {};
@@ -588,6 +569,27 @@ optional<signed_block> database_api_impl::get_block(uint32_t block_num)const
    return _db.fetch_block_by_number(block_num);
 }
 
+vector<signed_block> database_api::get_blocks(uint32_t block_num_from, uint32_t count)const
+{
+   return my->get_blocks( block_num_from, count );
+}
+
+vector<signed_block> database_api_impl::get_blocks(uint32_t block_num_from, uint32_t count)const
+{
+   const uint64_t api_limit_get_blocks = _app_options ? _app_options->api_limit_get_blocks : 100;
+   FC_ASSERT( count <= api_limit_get_blocks );
+   vector<signed_block> result;
+   result.reserve( count );
+   for( uint32_t i = 0; i < count; ++i )
+   {
+      auto block = _db.fetch_block_by_number( block_num_from + i );
+      if( !block )
+         break;
+      result.emplace_back( std::move( *block ) );
+   }
+   return result;
+}
+
 processed_transaction database_api::get_transaction( uint32_t block_num, uint32_t trx_in_block )const
 {
    return my->get_transaction( block_num, trx_in_block );
@@ -602,6 +604,11 @@ optional<signed_transaction> database_api::get_recent_transaction_by_id( const t
    }
 }
 
+block_cache_stats database_api::get_block_cache_stats()const
+{
+   return my->_db.get_block_cache_stats();
+}
+
 processed_transaction database_api_impl::get_transaction(uint32_t block_num, uint32_t trx_num)const
 {
    auto opt_block = _db.fetch_block_by_number(block_num);
@@ -666,6 +673,18 @@ dynamic_global_property_object database_api_impl::get_dynamic_global_properties(
    return _db.get(dynamic_global_property_id_type());
 }
 
+vector<index_memory_usage> database_api::get_objects_memory_usage()const
+{
+   return my->get_objects_memory_usage();
+}
+
+vector<index_memory_usage> database_api_impl::get_objects_memory_usage()const
+{
+   FC_ASSERT( _app_options && _app_options->enable_memory_usage_api,
+              "Memory usage API is disabled in this server." );
+   return _db.get_memory_usage();
+}
+
 //////////////////////////////////////////////////////////////////////
 //                                                                  //
 // Keys                                                             //
@@ -905,7 +924,10 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
       if( subscribe )
       {
          if(_subscribed_accounts.size() < 100) {
-            _subscribed_accounts.insert( account->get_id() );
+            {
+               std::lock_guard<std::mutex> guard( _subscription_mutex );
+               _subscribed_accounts.insert( account->get_id() );
+            }
             subscribe_to_item( account->id );
          }
       }
@@ -1411,7 +1433,12 @@ void database_api_impl::subscribe_to_market(std::function<void(const variant&)>
 
    if(asset_a_id > asset_b_id) std::swap(asset_a_id,asset_b_id);
    FC_ASSERT(asset_a_id != asset_b_id);
-   _market_subscriptions[ std::make_pair(asset_a_id,asset_b_id) ] = callback;
+   {
+      std::lock_guard<std::mutex> guard( _subscription_mutex );
+      _market_subscriptions[ std::make_pair(asset_a_id,asset_b_id) ] = callback;
+   }
+
+   enable_notifications();
 }
 
 void database_api::unsubscribe_from_market(const std::string& a, const std::string& b)
@@ -1426,6 +1453,7 @@ void database_api_impl::unsubscribe_from_market(const std::string& a, const std:
 
    if(a > b) std::swap(asset_a_id,asset_b_id);
    FC_ASSERT(asset_a_id != asset_b_id);
+   std::lock_guard<std::mutex> guard( _subscription_mutex );
    _market_subscriptions.erase(std::make_pair(asset_a_id,asset_b_id));
 }
 
@@ -1464,7 +1492,7 @@ market_ticker database_api_impl::get_ticker( const string& base, const string& q
       order_book orders;
       if (!skip_order_book)
       {
-         orders = get_order_book(assets[0]->symbol, assets[1]->symbol, 1);
+         orders = get_order_book_levels(assets[0]->symbol, assets[1]->symbol, 1);
       }
       return market_ticker(*itr, now, *assets[0], *assets[1], orders);
    }
@@ -1537,6 +1565,50 @@ order_book database_api_impl::get_order_book( const string& base, const string&
    return result;
 }
 
+order_book database_api::get_order_book_levels( const string& base, const string& quote, unsigned limit )const
+{
+   return my->get_order_book_levels( base, quote, limit );
+}
+
+order_book database_api_impl::get_order_book_levels( const string& base, const string& quote, unsigned limit )const
+{
+   FC_ASSERT( _app_options && _app_options->has_market_history_plugin, "Market history plugin is not enabled." );
+
+   const auto& levels_idx = _db.get_index_type< primary_index< limit_order_index > >().get_secondary_index< graphene::market_history::order_book_index >();
+   FC_ASSERT( limit <= levels_idx.depth(), "limit can not be greater than ${d}", ("d", levels_idx.depth()) );
+
+   order_book result;
+   result.base = base;
+   result.quote = quote;
+
+   auto assets = lookup_asset_symbols( {base, quote} );
+   FC_ASSERT( assets[0], "Invalid base asset symbol: ${s}", ("s",base) );
+   FC_ASSERT( assets[1], "Invalid quote asset symbol: ${s}", ("s",quote) );
+
+   auto base_id = assets[0]->id;
+   auto quote_id = assets[1]->id;
+
+   for( const auto& level : levels_idx.get_levels( base_id, quote_id, limit ) )
+   {
+      order ord;
+      ord.price = price_to_string( level.sell_price, *assets[0], *assets[1] );
+      ord.quote = assets[1]->amount_to_string( level.to_receive );
+      ord.base = assets[0]->amount_to_string( level.for_sale );
+      result.bids.push_back( ord );
+   }
+
+   for( const auto& level : levels_idx.get_levels( quote_id, base_id, limit ) )
+   {
+      order ord;
+      ord.price = price_to_string( level.sell_price, *assets[0], *assets[1] );
+      ord.quote = assets[1]->amount_to_string( level.for_sale );
+      ord.base = assets[0]->amount_to_string( level.to_receive );
+      result.asks.push_back( ord );
+   }
+
+   return result;
+}
+
 vector<market_ticker> database_api::get_top_markets(uint32_t limit)const
 {
    return my->get_top_markets(limit);
@@ -1559,7 +1631,7 @@ vector<market_ticker> database_api_impl::get_top_markets(uint32_t limit)const
       const asset_object base = itr->base(_db);
       const asset_object quote = itr->quote(_db);
       order_book orders;
-      orders = get_order_book(base.symbol, quote.symbol, 1);
+      orders = get_order_book_levels(base.symbol, quote.symbol, 1);
 
       result.emplace_back(market_ticker(*itr, now, base, quote, orders));
       ++itr;
@@ -2473,23 +2545,23 @@ vector<htlc_object> database_api_impl::get_htlc_by_to(const std::string account_
 //                                                                  //
 //////////////////////////////////////////////////////////////////////
 
-void database_api_impl::broadcast_updates( const vector<variant>& updates )
+void database_api_impl::broadcast_updates( const vector<variant>& updates, fc::thread& chain_thread )
 {
-   if( updates.size() && _subscribe_callback ) {
+   if( updates.size() ) {
       auto capture_this = shared_from_this();
-      fc::async([capture_this,updates](){
+      chain_thread.async([capture_this,updates](){
           if(capture_this->_subscribe_callback)
             capture_this->_subscribe_callback( fc::variant(updates) );
       });
    }
 }
 
-void database_api_impl::broadcast_market_updates( const market_queue_type& queue)
+void database_api_impl::broadcast_market_updates( const market_queue_type& queue, fc::thread& chain_thread )
 {
    if( queue.size() )
    {
       auto capture_this = shared_from_this();
-      fc::async([capture_this, this, queue](){
+      chain_thread.async([capture_this, this, queue](){
           for( const auto& item : queue )
           {
             auto sub = _market_subscriptions.find(item.first);
@@ -2500,138 +2572,83 @@ void database_api_impl::broadcast_market_updates( const market_queue_type& queue
    }
 }
 
-void database_api_impl::on_objects_removed( const vector<object_id_type>& ids, const vector<const object*>& objs, const flat_set<account_id_type>& impacted_accounts)
+void database_api_impl::enable_notifications()
 {
-   handle_object_changed(_notify_remove_create, false, ids, impacted_accounts,
-      [objs](object_id_type id) -> const object* {
-         auto it = std::find_if(
-               objs.begin(), objs.end(),
-               [id](const object* o) {return o != nullptr && o->id == id;});
-
-         if (it != objs.end())
-            return *it;
-
-         return nullptr;
-      }
-   );
-}
+   if( _notifications_enabled )
+      return;
 
-void database_api_impl::on_objects_new(const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts)
-{
-   handle_object_changed(_notify_remove_create, true, ids, impacted_accounts,
-      std::bind(&object_database::find_object, &_db, std::placeholders::_1)
-   );
+   _notification_bus->subscribe( shared_from_this() );
+   _notifications_enabled = true;
 }
 
-void database_api_impl::on_objects_changed(const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts)
+void database_api_impl::on_objects( const object_notification& n, fc::thread& chain_thread )
 {
-   handle_object_changed(false, true, ids, impacted_accounts,
-      std::bind(&object_database::find_object, &_db, std::placeholders::_1)
-   );
-}
+   vector<variant> updates;
+   market_queue_type broadcast_queue;
 
-void database_api_impl::handle_object_changed(bool force_notify, bool full_object, const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts, std::function<const object*(object_id_type id)> find_object)
-{
-   if( _subscribe_callback )
    {
-      vector<variant> updates;
+      std::lock_guard<std::mutex> guard( _subscription_mutex );
 
-      for(auto id : ids)
+      if( _subscribe_callback )
       {
-         if( force_notify || is_subscribed_to_item(id) || is_impacted_account(impacted_accounts) )
+         const bool force_notify = n.kind != object_notification::changed_objects && _notify_remove_create;
+         const bool impacted = is_impacted_account( n.impacted_accounts );
+
+         for( uint32_t i = 0; i < n.ids.size(); ++i )
          {
-            if( full_object )
-            {
-               auto obj = find_object(id);
-               if( obj )
-               {
-                  updates.emplace_back( obj->to_variant() );
-               }
-            }
-            else
-            {
-               updates.emplace_back( fc::variant( id, 1 ) );
-            }
+            if( !n.has_object( i ) )
+               continue;
+
+            if( force_notify || impacted || is_subscribed_to_item( n.ids[i] ) )
+               updates.emplace_back( n.get_object( i ) );
          }
       }
 
-      if( updates.size() )
-         broadcast_updates(updates);
-   }
-
-   if( _market_subscriptions.size() )
-   {
-      market_queue_type broadcast_queue;
-
-      for(auto id : ids)
+      if( _market_subscriptions.size() )
       {
-         if( id.is<call_order_object>() )
-         {
-            enqueue_if_subscribed_to_market<call_order_object>( find_object(id), broadcast_queue, full_object );
-         }
-         else if( id.is<limit_order_object>() )
-         {
-            enqueue_if_subscribed_to_market<limit_order_object>( find_object(id), broadcast_queue, full_object );
-         }
-         else if( id.is<force_settlement_object>() )
+         for( const auto& market : n.markets )
          {
-            enqueue_if_subscribed_to_market<force_settlement_object>( find_object(id), broadcast_queue, full_object );
+            if( !_market_subscriptions.count( market.first ) )
+               continue;
+
+            auto& queue = broadcast_queue[market.first];
+            for( uint32_t i : market.second )
+               queue.emplace_back( n.get_object( i ) );
          }
       }
-
-      if( broadcast_queue.size() )
-         broadcast_market_updates(broadcast_queue);
    }
+
+   broadcast_updates( updates, chain_thread );
+   broadcast_market_updates( broadcast_queue, chain_thread );
 }
 
-/** note: this method cannot yield because it is called in the middle of
- * apply a block.
- */
-void database_api_impl::on_applied_block()
+void database_api_impl::on_block( const block_notification& n, fc::thread& chain_thread )
 {
-   if (_block_applied_callback)
-   {
-      auto capture_this = shared_from_this();
-      block_id_type block_id = _db.head_block_id();
-      fc::async([this,capture_this,block_id](){
-         _block_applied_callback(fc::variant(block_id, 1));
-      });
-   }
-
-   if(_market_subscriptions.size() == 0)
-      return;
-
-   const auto& ops = _db.get_applied_operations();
+   bool notify_block = false;
    map< std::pair<asset_id_type,asset_id_type>, vector<pair<operation, operation_result>> > subscribed_markets_ops;
-   for(const optional< operation_history_object >& o_op : ops)
+
    {
-      if( !o_op.valid() )
-         continue;
-      const operation_history_object& op = *o_op;
+      std::lock_guard<std::mutex> guard( _subscription_mutex );
+
+      notify_block = (bool)_block_applied_callback;
 
-      optional< std::pair<asset_id_type,asset_id_type> > market;
-      switch(op.op.which())
+      for( const auto& item : n.market_fills )
       {
-         /*  This is sent via the object_changed callback
-         case operation::tag<limit_order_create_operation>::value:
-            market = op.op.get<limit_order_create_operation>().get_market();
-            break;
-         */
-         case operation::tag<fill_order_operation>::value:
-            market = op.op.get<fill_order_operation>().get_market();
-            break;
-            /*
-         case operation::tag<limit_order_cancel_operation>::value:
-         */
-         default: break;
+         if( _market_subscriptions.count( item.first ) )
+            subscribed_markets_ops.emplace( item );
       }
-      if( market.valid() && _market_subscriptions.count(*market) )
-         // FIXME this may cause fill_order_operation be pushed before order creation
-         subscribed_markets_ops[*market].emplace_back(std::make_pair(op.op, op.result));
    }
+
+   if( !notify_block && subscribed_markets_ops.empty() )
+      return;
+
    /// we need to ensure the database_api is not deleted for the life of the async operation
    auto capture_this = shared_from_this();
-   fc::async([this,capture_this,subscribed_markets_ops](){
+   block_id_type block_id = n.block_id;
+   chain_thread.async([this,capture_this,block_id,notify_block,subscribed_markets_ops](){
+      if( notify_block && _block_applied_callback )
+         _block_applied_callback(fc::variant(block_id, 1));
+
       for(auto item : subscribed_markets_ops)
       {
          auto itr = _market_subscriptions.find(item.first);
@@ -43,6 +43,7 @@ namespace graphene { namespace app {
    {
       public:
          bool enable_subscribe_to_all = false;
+         bool enable_memory_usage_api = false;
          bool has_market_history_plugin = false;
          uint64_t api_limit_get_account_history_operations = 100;
          uint64_t api_limit_get_account_history = 100;
@@ -52,6 +53,7 @@ namespace graphene { namespace app {
          uint64_t api_limit_get_asset_holders = 100;
          uint64_t api_limit_get_key_references = 100;
          uint64_t api_limit_get_htlc_by = 100;
+         uint64_t api_limit_get_blocks = 100;
    };
 
    class application
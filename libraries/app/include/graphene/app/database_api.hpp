@@ -210,6 +210,15 @@ class database_api
        */
       optional<signed_block> get_block(uint32_t block_num)const;
 
+      /**
+       * @brief Retrieve a range of full, signed blocks
+       * @param block_num_from Height of the first block to be returned
+       * @param count Maximum number of blocks to return, limited by api-limit-get-blocks
+       * @return consecutive blocks starting with block_num_from, the range ends at the first block
+       *         which is not found
+       */
+      vector<signed_block> get_blocks(uint32_t block_num_from, uint32_t count)const;
+
       /**
        * @brief used to fetch an individual transaction.
        */
@@ -222,6 +231,11 @@ class database_api
        */
       optional<signed_transaction> get_recent_transaction_by_id( const transaction_id_type& id )const;
 
+      /**
+       * @brief Retrieve hit/miss counters of the in-memory block header and block caches
+       */
+      block_cache_stats get_block_cache_stats()const;
+
       /////////////
       // Globals //
       /////////////
@@ -251,6 +265,14 @@ class database_api
        */
       dynamic_global_property_object get_dynamic_global_properties()const;
 
+      /**
+       * @brief Estimate the memory used by every object index
+       * @return object count, object, container, secondary index and undo stack bytes per (space, type)
+       *
+       * This walks all objects of the database, so it is available only if the node enables it
+       */
+      vector<index_memory_usage> get_objects_memory_usage()const;
+
       //////////
       // Keys //
       //////////
@@ -510,6 +532,16 @@ class database_api
        */
       order_book get_order_book( const string& base, const string& quote, unsigned limit = 50 )const;
 
+      /**
+       * @brief Returns the price levels of the order book for the market base:quote
+       * @param base String name of the first asset
+       * @param quote String name of the second asset
+       * @param limit Max number of levels of each asks and bids, capped at the order-book-depth option
+       * of the market history plugin. Prioritizes most moderate of each
+       * @return Order book of the market, every entry sums up all orders with the same price
+       */
+      order_book get_order_book_levels( const string& base, const string& quote, unsigned limit = 50 )const;
+
       /**
        * @brief Returns vector of tickers sorted by reverse base_volume
        * Note: this API is experimental and subject to change in next releases
@@ -800,8 +832,10 @@ FC_API(graphene::app::database_api,
    (get_block_header)
    (get_block_header_batch)
    (get_block)
+   (get_blocks)
    (get_transaction)
    (get_recent_transaction_by_id)
+   (get_block_cache_stats)
 
    // Globals
    (get_chain_properties)
@@ -809,6 +843,7 @@ FC_API(graphene::app::database_api,
    (get_config)
    (get_chain_id)
    (get_dynamic_global_properties)
+   (get_objects_memory_usage)
 
    // Keys
    (get_key_references)
@@ -840,6 +875,7 @@ FC_API(graphene::app::database_api,
 
    // Markets / feeds
    (get_order_book)
+   (get_order_book_levels)
    (get_limit_orders)
    (get_account_limit_orders)
    (get_call_orders)
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/chain/database.hpp>
+
+#include <fc/thread/thread.hpp>
+
+#include <boost/signals2/connection.hpp>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace graphene { namespace app {
+
+   using namespace graphene::chain;
+
+   /// the lesser asset goes first
+   typedef std::pair<asset_id_type, asset_id_type> market_type;
+
+   /**
+    *  @brief objects reported by a single database signal, serialized once for all subscribers
+    *
+    *  The objects are copied on the chain thread and serialized on the thread of the bus when the filter
+    *  of a subscriber asks for them first, so the objects nobody follows are never serialized.
+    */
+   struct object_notification
+   {
+      enum kind_type
+      {
+         new_objects,
+         changed_objects,
+         removed_objects
+      };
+
+      kind_type                               kind = changed_objects;
+      /// in the order of the database signal
+      vector<object_id_type>                  ids;
+      /// copies of the objects at the positions of ids, null if the object is not found, empty for the removed objects
+      vector<std::unique_ptr<object>>         copies;
+      flat_set<account_id_type>               impacted_accounts;
+      /// positions of the order objects by their markets
+      flat_map<market_type, vector<uint32_t>> markets;
+
+      /// false if the object at the position is not found, the removed objects are always reported by their ids
+      bool has_object( uint32_t i )const { return kind == removed_objects || copies[i] != nullptr; }
+
+      /// the full object (the id for a removed object) at the position, serialized on the first call,
+      /// it is called by the filters on the thread of the bus only
+      const variant& get_object( uint32_t i )const;
+
+   private:
+      mutable vector<optional<variant>>       _objects;
+   };
+
+   struct block_notification
+   {
+      block_id_type                                               block_id;
+      map<market_type, vector<pair<operation, operation_result>>> market_fills;
+   };
+
+   /**
+    *  @brief filter of the notifications, called on the thread of the bus
+    *
+    *  The callbacks of the subscriber are expected to be delivered on the chain thread.
+    */
+   class notification_subscriber
+   {
+      public:
+         virtual ~notification_subscriber() {}
+
+         virtual void on_objects( const object_notification& n, fc::thread& chain_thread ) = 0;
+         virtual void on_block( const block_notification& n, fc::thread& chain_thread ) = 0;
+   };
+
+   /**
+    *  @brief node-wide dispatcher of the database object changes
+    *
+    *  The bus is the only listener of the object signals of the database. Every reported object is
+    *  copied once on the chain thread, the filters of the subscribers are run on the thread of the bus
+    *  and serialize the objects they match. So the chain thread does not pay for the number of connected
+    *  API clients nor for the objects nobody follows.
+    */
+   class notification_bus
+   {
+      public:
+         /// the bus of the database shared by all its subscribers, created on the first use
+         static std::shared_ptr<notification_bus> get( database& db );
+
+         explicit notification_bus( database& db );
+         ~notification_bus();
+
+         /// the subscriber is held by a weak pointer
+         void subscribe( const std::shared_ptr<notification_subscriber>& s );
+         void unsubscribe( const notification_subscriber* s );
+
+      private:
+         void on_objects( object_notification::kind_type kind, const vector<object_id_type>& ids,
+                          const flat_set<account_id_type>& impacted_accounts,
+                          const std::function<const object*(object_id_type)>& find_object );
+         void on_applied_block();
+
+         optional<market_type> get_order_market( const object& obj )const;
+
+         vector<std::weak_ptr<notification_subscriber>> get_subscribers()const;
+
+         template<typename Notification>
+         void dispatch( const std::shared_ptr<const Notification>& n );
+
+         database&                                                                          _db;
+         std::shared_ptr<fc::thread>                                                        _thread;
+         mutable std::mutex                                                                 _subscribers_mutex;
+         std::map< const notification_subscriber*, std::weak_ptr<notification_subscriber> > _subscribers;
+
+         boost::signals2::scoped_connection _new_connection;
+         boost::signals2::scoped_connection _change_connection;
+         boost::signals2::scoped_connection _removed_connection;
+         boost::signals2::scoped_connection _applied_block_connection;
+   };
+
+} } // graphene::app
@@ -101,6 +101,38 @@ struct playchain_table_info
     bool                  alive = false;
 };
 
+struct playchain_room_summary
+{
+    room_id_type                        id;
+    account_id_type                     owner;
+    string                              metadata;
+    string                              server_url;
+    int32_t                             rating = 0;
+};
+
+struct playchain_table_summary
+{
+    table_id_type         id;
+    room_id_type          room;
+    string                metadata;
+    amount_type           required_witnesses = 0;
+    uint32_t              occupied_places = 0;
+    bool                  playing = false;
+};
+
+/// Page of compact summaries. next_page_id is set if there are more objects after the page
+struct playchain_rooms_page
+{
+    vector<playchain_room_summary>      items;
+    optional<room_id_type>              next_page_id;
+};
+
+struct playchain_tables_page
+{
+    vector<playchain_table_summary>     items;
+    optional<table_id_type>             next_page_id;
+};
+
 struct playchain_pending_buy_in_proposal_info
 {
     string                              name;
@@ -252,6 +284,13 @@ class playchain_api
        */
       optional< player_object > get_player(const string &account_name_or_id) const;
 
+      /** Get player objects for many accounts at once.
+       *
+       * @param account_names_or_ids Accept: player ID, account ID, account name.
+       * @returns the player objects in the order of input, null if account is not found or it is not player
+       */
+      vector< optional< player_object > > get_players(const vector<string> &account_names_or_ids) const;
+
       /** List player objects.
        *
        * @param last_page_id The player ID from list starting in ascending order (not including)
@@ -285,6 +324,15 @@ class playchain_api
                                        const string &last_page_id,
                                        const uint32_t limit) const;
 
+      /** List compact room summaries page by page.
+       *
+       * @param last_page_id next_page_id of the previous page, null for first page
+       * @param limit The page size (up to PLAYCHAIN_MAX_SIZE_FOR_RESULT_API_PAGE).
+       * @returns the page of rooms in ascending order of ID
+       */
+      playchain_rooms_page list_rooms_page(const optional<room_id_type> &last_page_id,
+                                           const uint32_t limit) const;
+
       /**
        * @brief Light version for database_api::get_objects
        * Check if returned info include field Id corresponds to input Id
@@ -299,6 +347,12 @@ class playchain_api
        */
       optional< playchain_room_info > get_room_info(const string &owner_name_or_id, const string &metadata) const;
 
+      /**
+       * @brief Get rooms info by pairs of owner and metadata.
+       * @return rooms info in the order of input, null if owner or room is not found.
+       */
+      vector< optional< playchain_room_info > > get_rooms_info(const vector< std::pair<string, string> > &owners_and_metadata) const;
+
       /** Get game witness object.
        *
        * @param account_name_or_id Accept owner: game witness ID, player ID, account ID, account name.
@@ -375,6 +429,15 @@ class playchain_api
                                        const string &last_page_id,
                                        const uint32_t limit) const;
 
+      /** List compact table summaries page by page.
+       *
+       * @param last_page_id next_page_id of the previous page, null for first page
+       * @param limit The page size (up to PLAYCHAIN_MAX_SIZE_FOR_RESULT_API_PAGE).
+       * @returns the page of tables in ascending order of ID
+       */
+      playchain_tables_page list_tables_page(const optional<table_id_type> &last_page_id,
+                                             const uint32_t limit) const;
+
       /**
        * @brief Retrieve a block header for last_irreversible_block_num. Helper to build transaction
        * @return header of the referenced block
@@ -428,6 +491,14 @@ class playchain_api
        */
       optional< playchain_table_info > get_table_info_for_pending_buy_in_proposal(const string &name_or_id, const string &uid) const;
 
+      /**
+       * @brief Check many pending buy-in proposals at once
+       * @param names_or_ids_and_uids pairs of player (player ID or account ID or account name) and UID
+       * @returns the tables in the order of input, null if proposal is not found or it has not been allocated yet
+       */
+      vector< optional< playchain_table_info > > get_tables_info_for_pending_buy_in_proposals(
+                                                    const vector< std::pair<string, string> > &names_or_ids_and_uids) const;
+
       /**
        * @brief Retrieve the current @ref playchain_property_object
        */
@@ -441,6 +512,14 @@ class playchain_api
        */
       vector< playchain_player_table_info > list_tables_with_player(const string &name_or_id, const uint32_t limit) const;
 
+      /** Get tables of many players at once
+       *
+       * @param names_or_ids Accept: player ID, account ID, account name.
+       * @param limit The limitation (or single page size) for each player.
+       * @returns the tables lists in the order of input, empty list if player is not found
+       */
+      vector< vector< playchain_player_table_info > > list_tables_with_players(const vector<string> &names_or_ids, const uint32_t limit) const;
+
       /** Get account info if core account and playchain account (player) exist
        *
        * @param name Core account name.
@@ -499,6 +578,29 @@ FC_REFLECT(playchain::app::playchain_table_info,
            (state)
            (alive))
 
+FC_REFLECT(playchain::app::playchain_room_summary,
+           (id)
+           (owner)
+           (metadata)
+           (server_url)
+           (rating))
+
+FC_REFLECT(playchain::app::playchain_table_summary,
+           (id)
+           (room)
+           (metadata)
+           (required_witnesses)
+           (occupied_places)
+           (playing))
+
+FC_REFLECT(playchain::app::playchain_rooms_page,
+           (items)
+           (next_page_id))
+
+FC_REFLECT(playchain::app::playchain_tables_page,
+           (items)
+           (next_page_id))
+
 FC_REFLECT(playchain::app::playchain_pending_buy_in_proposal_info,
            (name)
            (id)
@@ -549,11 +651,14 @@ FC_API(playchain::app::playchain_api,
     (list_all_player_invitations)
     (list_invited_players)
     (get_player)
+    (get_players)
     (list_all_players)
     (list_rooms)
     (list_all_rooms)
+    (list_rooms_page)
     (get_rooms_info_by_id)
     (get_room_info)
+    (get_rooms_info)
     (get_game_witness)
     (list_all_game_witnesses)
     (get_committee_members)
@@ -562,6 +667,7 @@ FC_API(playchain::app::playchain_api,
     (list_tables)
     (get_tables_info_by_metadata)
     (list_all_tables)
+    (list_tables_page)
     (get_last_irreversible_block_header)
     (get_playchain_balance_info)
     (get_account_id_by_name)
@@ -570,8 +676,10 @@ FC_API(playchain::app::playchain_api,
     (cancel_tables_subscribe_callback)
     (cancel_all_tables_subscribe_callback)
     (get_table_info_for_pending_buy_in_proposal)
+    (get_tables_info_for_pending_buy_in_proposals)
     (get_playchain_properties)
     (list_tables_with_player)
+    (list_tables_with_players)
     (get_player_account_by_name)
     (get_version)
 )
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/app/notification_bus.hpp>
+
+#include <graphene/chain/asset_object.hpp>
+#include <graphene/chain/market_object.hpp>
+#include <graphene/chain/operation_history_object.hpp>
+
+namespace graphene { namespace app {
+
+namespace {
+
+   void deliver( notification_subscriber& s, const object_notification& n, fc::thread& chain_thread )
+   {
+      s.on_objects( n, chain_thread );
+   }
+
+   void deliver( notification_subscriber& s, const block_notification& n, fc::thread& chain_thread )
+   {
+      s.on_block( n, chain_thread );
+   }
+
+}
+
+const variant& object_notification::get_object( uint32_t i )const
+{
+   if( _objects.empty() )
+      _objects.resize( ids.size() );
+
+   auto& obj = _objects[i];
+   if( !obj.valid() )
+   {
+      if( kind == removed_objects )
+         obj = variant( ids[i], 1 );
+      else
+         obj = copies[i] ? copies[i]->to_variant() : variant();
+   }
+   return *obj;
+}
+
+std::shared_ptr<notification_bus> notification_bus::get( database& db )
+{
+   static std::mutex buses_mutex;
+   static std::map< const database*, std::weak_ptr<notification_bus> > buses;
+
+   std::lock_guard<std::mutex> guard( buses_mutex );
+   auto& weak_bus = buses[&db];
+   auto bus = weak_bus.lock();
+   if( !bus )
+   {
+      bus = std::make_shared<notification_bus>( db );
+      weak_bus = bus;
+   }
+   return bus;
+}
+
+notification_bus::notification_bus( database& db )
+:_db( db ), _thread( std::make_shared<fc::thread>( "notification_bus" ) )
+{
+   _new_connection = _db.new_objects.connect([this](const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts) {
+      on_objects( object_notification::new_objects, ids, impacted_accounts,
+                  std::bind(&object_database::find_object, &_db, std::placeholders::_1) );
+   });
+   _change_connection = _db.changed_objects.connect([this](const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts) {
+      on_objects( object_notification::changed_objects, ids, impacted_accounts,
+                  std::bind(&object_database::find_object, &_db, std::placeholders::_1) );
+   });
+   _removed_connection = _db.removed_objects.connect([this](const vector<object_id_type>& ids, const vector<const object*>& objs, const flat_set<account_id_type>& impacted_accounts) {
+      // one pass over the removed objects instead of a search for every id
+      flat_map<object_id_type, const object*> removed;
+      removed.reserve( objs.size() );
+      for( const object* o : objs )
+      {
+         if( o != nullptr )
+            removed.emplace( o->id, o );
+      }
+      on_objects( object_notification::removed_objects, ids, impacted_accounts,
+                  [&removed](object_id_type id) -> const object* {
+                     auto it = removed.find( id );
+                     return it != removed.end() ? it->second : nullptr;
+                  } );
+   });
+   _applied_block_connection = _db.applied_block.connect([this](const signed_block&){ on_applied_block(); });
+}
+
+notification_bus::~notification_bus()
+{
+   _new_connection.disconnect();
+   _change_connection.disconnect();
+   _removed_connection.disconnect();
+   _applied_block_connection.disconnect();
+   {
+      std::lock_guard<std::mutex> guard( _subscribers_mutex );
+      if( !_subscribers.empty() )
+         _db.remove_applied_operations_consumer();
+   }
+   _thread->quit();
+}
+
+void notification_bus::subscribe( const std::shared_ptr<notification_subscriber>& s )
+{
+   std::lock_guard<std::mutex> guard( _subscribers_mutex );
+   // the market fills are taken from the applied operations only while somebody listens, from the next block on
+   if( _subscribers.empty() )
+      _db.add_applied_operations_consumer();
+   _subscribers[s.get()] = s;
+}
+
+void notification_bus::unsubscribe( const notification_subscriber* s )
+{
+   std::lock_guard<std::mutex> guard( _subscribers_mutex );
+   if( _subscribers.erase( s ) && _subscribers.empty() )
+      _db.remove_applied_operations_consumer();
+}
+
+vector<std::weak_ptr<notification_subscriber>> notification_bus::get_subscribers()const
+{
+   std::lock_guard<std::mutex> guard( _subscribers_mutex );
+   vector<std::weak_ptr<notification_subscriber>> result;
+   result.reserve( _subscribers.size() );
+   for( const auto& item : _subscribers )
+      result.emplace_back( item.second );
+   return result;
+}
+
+optional<market_type> notification_bus::get_order_market( const object& obj )const
+{
+   market_type market;
+   if( obj.id.is<limit_order_object>() )
+      market = static_cast<const limit_order_object&>( obj ).get_market();
+   else if( obj.id.is<call_order_object>() )
+      market = static_cast<const call_order_object&>( obj ).get_market();
+   else if( obj.id.is<force_settlement_object>() )
+   {
+      const auto& order = static_cast<const force_settlement_object&>( obj );
+      asset_id_type backing_id = order.balance.asset_id( _db ).bitasset_data( _db ).options.short_backing_asset;
+      market = std::make_pair( order.balance.asset_id, backing_id );
+      if( market.first > market.second ) std::swap( market.first, market.second );
+   }
+   else
+      return {};
+   return market;
+}
+
+/** note: this method cannot yield because it is called in the middle of
+ * apply a block.
+ */
+void notification_bus::on_objects( object_notification::kind_type kind, const vector<object_id_type>& ids,
+                                   const flat_set<account_id_type>& impacted_accounts,
+                                   const std::function<const object*(object_id_type)>& find_object )
+{
+   if( ids.empty() || get_subscribers().empty() )
+      return;
+
+   auto n = std::make_shared<object_notification>();
+   n->kind = kind;
+   n->ids = ids;
+   n->impacted_accounts = impacted_accounts;
+
+   // a copy is much cheaper than the serialization, which is left to the filters of the subscribers
+   const bool full_object = kind != object_notification::removed_objects;
+   if( full_object )
+      n->copies.reserve( ids.size() );
+   for( uint32_t i = 0; i < ids.size(); ++i )
+   {
+      const object* obj = find_object( ids[i] );
+      if( full_object )
+         n->copies.emplace_back( obj ? obj->clone() : std::unique_ptr<object>() );
+
+      if( obj )
+      {
+         auto market = get_order_market( *obj );
+         if( market.valid() )
+            n->markets[*market].push_back( i );
+      }
+   }
+
+   dispatch<object_notification>( n );
+}
+
+void notification_bus::on_applied_block()
+{
+   // the subscribers of the middle of the block get the fills from the next one
+   if( get_subscribers().empty() || !_db.applied_operations_recorded() )
+      return;
+
+   auto n = std::make_shared<block_notification>();
+   n->block_id = _db.head_block_id();
+
+   for( const auto& op : _db.get_applied_operations() )
+   {
+      if( op.removed )
+         continue;
+
+      // limit order creation and cancellation are sent with the changed objects
+      if( op.op.which() == operation::tag<fill_order_operation>::value )
+      {
+         // FIXME this may cause fill_order_operation be pushed before order creation
+         n->market_fills[ op.op.get<fill_order_operation>().get_market() ].emplace_back( op.op, op.result );
+      }
+   }
+
+   dispatch<block_notification>( n );
+}
+
+template<typename Notification>
+void notification_bus::dispatch( const std::shared_ptr<const Notification>& n )
+{
+   fc::thread* chain_thread = &fc::thread::current();
+   auto subscribers = get_subscribers();
+   _thread->async( [chain_thread, subscribers, n]() {
+      auto alive = std::make_shared< vector< std::shared_ptr<notification_subscriber> > >();
+      alive->reserve( subscribers.size() );
+      for( const auto& weak_s : subscribers )
+      {
+         if( auto s = weak_s.lock() )
+         {
+            deliver( *s, *n, *chain_thread );
+            alive->emplace_back( std::move( s ) );
+         }
+      }
+      // the last reference to a subscriber must not be released on this thread
+      chain_thread->async( [alive](){ alive->clear(); }, "notification_bus release" );
+   }, "notification_bus dispatch" );
+}
+
+} } // graphene::app
@@ -47,21 +47,71 @@ namespace playchain { namespace app {
 
 namespace
 {
+    /// parses "space.type.instance" of T without exceptions (names can't start with digit)
     template<class T>
     optional<T> maybe_id( const string& name_or_id )
     {
-        if( std::isdigit( name_or_id.front() ) )
+        if( name_or_id.empty() || !std::isdigit( (unsigned char)name_or_id.front() ) )
+            return optional<T>();
+
+        uint64_t parts[3] = {0, 0, 0};
+        size_t part = 0;
+        bool has_digit = false;
+        for( const char c: name_or_id )
         {
-            try
+            if( c == '.' )
             {
-                return fc::variant(name_or_id, 1).as<T>(1);
-            }
-            catch (const fc::exception&)
-            { // not an ID
+                if( !has_digit || ++part > 2 )
+                    return optional<T>();
+                has_digit = false;
+                continue;
             }
+            if( !std::isdigit( (unsigned char)c ) || parts[part] > GRAPHENE_DB_MAX_INSTANCE_ID / 10 )
+                return optional<T>();
+            parts[part] = parts[part] * 10 + (c - '0');
+            has_digit = true;
         }
-        return optional<T>();
+
+        if( part != 2 || !has_digit ||
+            parts[0] != T::space_id || parts[1] != T::type_id ||
+            parts[2] > GRAPHENE_DB_MAX_INSTANCE_ID )
+            return optional<T>();
+
+        return T(parts[2]);
     }
+
+    /**
+     * Resolutions shared by the items of one batch request. Objects are referenced
+     * by pointers because the request is served on the chain thread entirely.
+     */
+    struct lookup_context
+    {
+        explicit lookup_context(const graphene::chain::database& db): db(db) {}
+
+        const account_object &account(const account_id_type &id)
+        {
+            auto it = accounts.find(id);
+            if (accounts.end() == it)
+                it = accounts.emplace(id, &id(db)).first;
+            return *it->second;
+        }
+
+        const room_object &room(const room_id_type &id)
+        {
+            auto it = rooms.find(id);
+            if (rooms.end() == it)
+                it = rooms.emplace(id, &id(db)).first;
+            return *it->second;
+        }
+
+        const graphene::chain::database& db;
+
+        std::map<account_id_type, const account_object *> accounts;
+        std::map<room_id_type, const room_object *> rooms;
+        ///resolved account and player IDs by requested name or ID
+        std::map<string, optional<account_id_type>> account_ids;
+        std::map<string, optional<player_id_type>> player_ids;
+    };
 }
 
 class playchain_api_impl: public std::enable_shared_from_this<playchain_api_impl>
@@ -86,13 +136,13 @@ public:
         dlog("freeing playchain API ${x}", ("x",int64_t(this)) );
     }
 
-    playchain_room_info get_room_info(const room_object& room) const
+    playchain_room_info get_room_info(const room_object& room, lookup_context *ctx = nullptr) const
     {
         playchain_room_info info;
 
         info.id = room.id;
         info.owner = room.owner;
-        info.owner_name = room.owner(_db).name;
+        info.owner_name = ctx ? ctx->account(room.owner).name : room.owner(_db).name;
         info.metadata = room.metadata;
         info.server_url = room.server_url;
         info.rating = room.rating;
@@ -110,15 +160,15 @@ public:
     }
 
     template<typename TableInfo>
-    TableInfo get_table_info(const table_object& table) const
+    TableInfo get_table_info(const table_object& table, lookup_context *ctx = nullptr) const
     {
         TableInfo info;
 
-        const auto &room = table.room(_db);
+        const auto &room = ctx ? ctx->room(table.room) : table.room(_db);
 
         info.id = table.id;
         info.owner = room.owner;
-        info.owner_name = room.owner(_db).name;
+        info.owner_name = ctx ? ctx->account(room.owner).name : room.owner(_db).name;
         info.metadata = table.metadata;
         info.server_url = room.server_url;
         info.required_witnesses = table.required_witnesses;
@@ -404,6 +454,70 @@ public:
         return result;
     }
 
+    template<typename TPage,
+             typename TIndexById,
+             typename TObjectIdType,
+             typename Convert>
+    TPage list_page_impl(const optional<TObjectIdType> &last_page_id,
+                         uint32_t limit,
+                         uint64_t last_special_id_instance,
+                         Convert &&convert) const
+    {
+        FC_ASSERT( limit > 0, "Limit should be greater than 0");
+        FC_ASSERT( limit <= PLAYCHAIN_MAX_SIZE_FOR_RESULT_API_PAGE, "Limit can't be greater than ${l}", ("l", PLAYCHAIN_MAX_SIZE_FOR_RESULT_API_PAGE));
+
+        uint64_t from = last_special_id_instance + 1;
+        if (last_page_id.valid())
+            from = std::max(from, last_page_id->instance.value + 1);
+
+        const auto& objects_by_id = _db.get_index_type<TIndexById>().indices().template get<by_id>();
+
+        TPage result;
+        result.items.reserve(limit);
+
+        auto itr = objects_by_id.lower_bound(TObjectIdType(from));
+        for (; limit && itr != objects_by_id.end(); --limit, ++itr)
+        {
+            result.items.emplace_back(convert(*itr));
+        }
+
+        if (itr != objects_by_id.end() && !result.items.empty())
+            result.next_page_id = result.items.back().id;
+
+        return result;
+    }
+
+    playchain_tables_page list_tables_page(const optional<table_id_type> &last_page_id, uint32_t limit) const
+    {
+        return list_page_impl<playchain_tables_page, table_index>(last_page_id, limit, PLAYCHAIN_NULL_TABLE.instance,
+                                                                  [](const table_object &table)
+        {
+            playchain_table_summary summary;
+            summary.id = table.id;
+            summary.room = table.room;
+            summary.metadata = table.metadata;
+            summary.required_witnesses = table.required_witnesses;
+            summary.occupied_places = table.occupied_places;
+            summary.playing = table.is_playing();
+            return summary;
+        });
+    }
+
+    playchain_rooms_page list_rooms_page(const optional<room_id_type> &last_page_id, uint32_t limit) const
+    {
+        return list_page_impl<playchain_rooms_page, room_index>(last_page_id, limit, PLAYCHAIN_NULL_ROOM.instance,
+                                                                [](const room_object &room)
+        {
+            playchain_room_summary summary;
+            summary.id = room.id;
+            summary.owner = room.owner;
+            summary.metadata = room.metadata;
+            summary.server_url = room.server_url;
+            summary.rating = room.rating;
+            return summary;
+        });
+    }
+
     player_invitation_objects_list_with_blockchain_time list_player_invitations(const string &inviter_name_or_id,
                                                                const string &last_page_uid,
                                                                uint32_t limit) const
@@ -523,6 +637,27 @@ public:
         return _db.get(*opt_id);
     }
 
+    vector< optional< player_object > > get_players(const vector<string> &account_names_or_ids) const
+    {
+        check_limit(account_names_or_ids.size());
+
+        lookup_context ctx(_db);
+
+        vector< optional< player_object > > result;
+        result.reserve(account_names_or_ids.size());
+
+        for (const string &account_name_or_id: account_names_or_ids)
+        {
+            optional<player_id_type> opt_id = find_player_id(account_name_or_id, ctx);
+            if (opt_id.valid())
+                result.emplace_back(_db.get(*opt_id));
+            else
+                result.emplace_back();
+        }
+
+        return result;
+    }
+
     vector< player_object > list_all_players(const string &last_page_id,
                                              uint32_t limit) const
     {
@@ -602,14 +737,49 @@ public:
     {
         account_id_type owner = get_account_id(owner_name_or_id);
 
+        auto interned_metadata = _db.interned_strings().find(metadata);
+        if (!interned_metadata.valid())
+            return {};
+
         const auto& rooms_by_owner_and_metadata = _db.get_index_type<room_index>().indices().get<by_room_owner_and_metadata>();
-        auto itr = rooms_by_owner_and_metadata.find(boost::make_tuple(owner, metadata));
+        auto itr = rooms_by_owner_and_metadata.find(boost::make_tuple(owner, *interned_metadata));
         if( itr == rooms_by_owner_and_metadata.end() )
             return {};
 
         return get_room_info(*itr);
     }
 
+    vector< optional< playchain_room_info > > get_rooms_info(const vector< std::pair<string, string> > &owners_and_metadata) const
+    {
+        check_limit(owners_and_metadata.size());
+
+        lookup_context ctx(_db);
+
+        const auto& rooms_by_owner_and_metadata = _db.get_index_type<room_index>().indices().get<by_room_owner_and_metadata>();
+
+        vector< optional< playchain_room_info > > result;
+        result.reserve(owners_and_metadata.size());
+
+        for (const auto &owner_and_metadata: owners_and_metadata)
+        {
+            optional<account_id_type> owner = find_account_id(owner_and_metadata.first, ctx);
+            auto interned_metadata = _db.interned_strings().find(owner_and_metadata.second);
+            if (!owner.valid() || !interned_metadata.valid())
+            {
+                result.emplace_back();
+                continue;
+            }
+
+            auto itr = rooms_by_owner_and_metadata.find(boost::make_tuple(*owner, *interned_metadata));
+            if( itr == rooms_by_owner_and_metadata.end() )
+                result.emplace_back();
+            else
+                result.emplace_back(get_room_info(*itr, &ctx));
+        }
+
+        return result;
+    }
+
     optional< game_witness_object > get_game_witness(const string &account_name_or_id) const
     {
         optional<game_witness_id_type> opt_id = get_game_witness_id(account_name_or_id);
@@ -641,7 +811,12 @@ public:
         optional<room_id_type> room_id = maybe_id<room_id_type>(room_id_name);
         FC_ASSERT(room_id.valid());
 
-        auto table_range = _db.get_index_type<table_index>().indices().get<by_room_and_metadata>().equal_range(std::make_tuple(*room_id, metadata));
+        // no table has the metadata that has never been interned
+        auto interned_metadata = _db.interned_strings().find(metadata);
+        if (!interned_metadata.valid())
+            return result;
+
+        auto table_range = _db.get_index_type<table_index>().indices().get<by_room_and_metadata>().equal_range(std::make_tuple(*room_id, *interned_metadata));
         for (auto itr = table_range.first; itr !=table_range.second && limit--;)
         {
             const auto &table = *itr++;
@@ -878,6 +1053,37 @@ public:
         return get_table_info_by_id(proposal.table);
     }
 
+    vector< optional< playchain_table_info > > get_tables_info_for_pending_buy_in_proposals(
+                                                  const vector< std::pair<string, string> > &names_or_ids_and_uids) const
+    {
+        check_limit(names_or_ids_and_uids.size());
+
+        lookup_context ctx(_db);
+
+        const auto &index_by_uid = _db.get_index_type<pending_buy_in_index>().indices().get<by_pending_buy_in_uid>();
+
+        vector< optional< playchain_table_info > > result;
+        result.reserve(names_or_ids_and_uids.size());
+
+        for (const auto &name_or_id_and_uid: names_or_ids_and_uids)
+        {
+            optional<account_id_type> id = find_account_id(name_or_id_and_uid.first, ctx);
+            if (!id.valid() || name_or_id_and_uid.second.empty())
+            {
+                result.emplace_back();
+                continue;
+            }
+
+            auto it = index_by_uid.find(std::make_tuple(*id, name_or_id_and_uid.second));
+            if (it == index_by_uid.end() || !it->is_allocated())
+                result.emplace_back();
+            else
+                result.emplace_back(get_table_info<playchain_table_info>(it->table(_db), &ctx));
+        }
+
+        return result;
+    }
+
     playchain_property_object get_playchain_properties() const
     {
         return _db.get(playchain_property_id_type());
@@ -887,20 +1093,48 @@ public:
     {
         check_limit(limit);
 
-        vector<playchain_player_table_info> result;
-
-        result.reserve(limit);
-
         optional<player_id_type> player_id = get_player_id(name_or_id);
 
         FC_ASSERT(player_id.valid(), "Invalid player");
 
+        return list_tables_with_player(*player_id, limit);
+    }
+
+    vector< vector< playchain_player_table_info > > list_tables_with_players(const vector<string> &names_or_ids, uint32_t limit) const
+    {
+        check_limit(names_or_ids.size());
+        check_limit(limit);
+
+        lookup_context ctx(_db);
+
+        vector< vector< playchain_player_table_info > > result;
+        result.reserve(names_or_ids.size());
+
+        for (const string &name_or_id: names_or_ids)
+        {
+            optional<player_id_type> player_id = find_player_id(name_or_id, ctx);
+            if (player_id.valid())
+                result.emplace_back(list_tables_with_player(*player_id, limit, &ctx));
+            else
+                result.emplace_back();
+        }
+
+        return result;
+    }
+
+    vector< playchain_player_table_info > list_tables_with_player(const player_id_type &player, uint32_t limit,
+                                                                  lookup_context *ctx = nullptr) const
+    {
+        vector<playchain_player_table_info> result;
+
+        result.reserve(limit);
+
         const auto& idx = _db.get_index_type<table_index>();
         const auto& idx_impl = dynamic_cast<const base_primary_index&>(idx);
         const auto& second_index = idx_impl.get_secondary_index<table_players_index>();
 
         {
-            auto it = second_index.tables_with_playing_cash_by_player.find(*player_id);
+            auto it = second_index.tables_with_playing_cash_by_player.find(player);
             if (second_index.tables_with_playing_cash_by_player.end() != it)
             {
                 auto && tables = it->second;
@@ -912,21 +1146,21 @@ public:
 
                     asset buyouting_balance;
                     const auto &index_buyouting = _db.get_index_type<pending_buy_out_index>().indices().get<by_player_at_table>();
-                    auto it = index_buyouting.find(std::make_tuple(*player_id, table));
+                    auto it = index_buyouting.find(std::make_tuple(player, table));
                     if (it != index_buyouting.end())
                     {
                         buyouting_balance = it->amount;
                     }
 
                     result.emplace_back(playchain_player_table_state::playing,
-                                        table_object.get_playing_cash_balance(*player_id), buyouting_balance,
-                                        std::move(get_table_info<playchain_table_info>(table_object)));
+                                        table_object.get_playing_cash_balance(player), buyouting_balance,
+                                        std::move(get_table_info<playchain_table_info>(table_object, ctx)));
                 }
             }
         }
 
         {
-            auto it = second_index.tables_with_cash_by_player.find(*player_id);
+            auto it = second_index.tables_with_cash_by_player.find(player);
             if (second_index.tables_with_cash_by_player.end() != it)
             {
                 auto && tables = it->second;
@@ -936,14 +1170,14 @@ public:
                         return result;
                     const table_object &table_object = table(_db);
                     result.emplace_back(playchain_player_table_state::attable,
-                                        table_object.get_cash_balance(*player_id), asset{},
-                                        std::move(get_table_info<playchain_table_info>(table_object)));
+                                        table_object.get_cash_balance(player), asset{},
+                                        std::move(get_table_info<playchain_table_info>(table_object, ctx)));
                 }
             }
         }
 
         {
-            auto it = second_index.tables_with_pending_proposals_by_player.find(*player_id);
+            auto it = second_index.tables_with_pending_proposals_by_player.find(player);
             if (second_index.tables_with_pending_proposals_by_player.end() != it)
             {
                 auto && tables = it->second;
@@ -953,8 +1187,8 @@ public:
                         return result;
                     const table_object &table_object = table(_db);
                     result.emplace_back(playchain_player_table_state::pending,
-                                        table_object.get_pending_balance(_db, *player_id), asset{},
-                                        std::move(get_table_info<playchain_table_info>(table_object)));
+                                        table_object.get_pending_balance(_db, player), asset{},
+                                        std::move(get_table_info<playchain_table_info>(table_object, ctx)));
                 }
             }
         }
@@ -1113,6 +1347,53 @@ private:
         return it->id;
     }
 
+    optional< account_id_type > find_account_id(const string &account_name_or_id, lookup_context &ctx) const
+    {
+        auto it = ctx.account_ids.find(account_name_or_id);
+        if (ctx.account_ids.end() != it)
+            return it->second;
+
+        optional< account_id_type > result;
+        try
+        {
+            result = get_account_id(account_name_or_id);
+        }
+        catch (const fc::assert_exception&)
+        { // invalid or not found
+        }
+
+        ctx.account_ids.emplace(account_name_or_id, result);
+        return result;
+    }
+
+    optional< player_id_type > find_player_id(const string &account_name_or_id, lookup_context &ctx) const
+    {
+        auto it = ctx.player_ids.find(account_name_or_id);
+        if (ctx.player_ids.end() != it)
+            return it->second;
+
+        optional< player_id_type > result = maybe_id<player_id_type>(account_name_or_id);
+        if (result.valid())
+        {
+            if (player_object::is_special_player(*result) || !is_player_exists(_db, *result))
+                result.reset();
+        }
+        else
+        {
+            optional< account_id_type > account_id = find_account_id(account_name_or_id, ctx);
+            if (account_id.valid())
+            {
+                const auto& idx = _db.get_index_type<playchain::chain::player_index>().indices().get<by_playchain_account>();
+                auto player_it = idx.find(*account_id);
+                if (idx.end() != player_it)
+                    result = player_it->id;
+            }
+        }
+
+        ctx.player_ids.emplace(account_name_or_id, result);
+        return result;
+    }
+
     optional< game_witness_id_type > get_game_witness_id(const string &account_name_or_id) const
     {
         optional<game_witness_id_type> opt_game_witness_id = maybe_id<game_witness_id_type>(account_name_or_id);
@@ -1194,6 +1475,11 @@ optional< player_object > playchain_api::get_player(const string &account_name_o
     return _impl->get_player(account_name_or_id);
 }
 
+vector< optional< player_object > > playchain_api::get_players(const vector<string> &account_names_or_ids) const
+{
+    return _impl->get_players(account_names_or_ids);
+}
+
 vector< player_object > playchain_api::list_all_players(const string &last_page_id,
                                          const uint32_t limit) const
 {
@@ -1207,6 +1493,11 @@ vector< room_object > playchain_api::list_rooms(const string &owner_name_or_id,
     return _impl->list_rooms(owner_name_or_id, last_page_id, limit);
 }
 
+playchain_rooms_page playchain_api::list_rooms_page(const optional<room_id_type> &last_page_id, const uint32_t limit) const
+{
+    return _impl->list_rooms_page(last_page_id, limit);
+}
+
 vector< room_object > playchain_api::list_all_rooms(
                                  const string &last_page_id,
                                  const uint32_t limit) const
@@ -1224,6 +1515,11 @@ optional< playchain_room_info > playchain_api::get_room_info(const string &owner
     return _impl->get_room_info(owner_name_or_id, metadata);
 }
 
+vector< optional< playchain_room_info > > playchain_api::get_rooms_info(const vector< std::pair<string, string> > &owners_and_metadata) const
+{
+    return _impl->get_rooms_info(owners_and_metadata);
+}
+
 optional< game_witness_object > playchain_api::get_game_witness(const string &account_name_or_id) const
 {
     return _impl->get_game_witness(account_name_or_id);
@@ -1267,6 +1563,11 @@ vector<playchain_table_info> playchain_api::get_tables_info_by_metadata(const st
     return _impl->get_tables_info_by_metadata(room_id, metadata, limit);
 }
 
+playchain_tables_page playchain_api::list_tables_page(const optional<table_id_type> &last_page_id, const uint32_t limit) const
+{
+    return _impl->list_tables_page(last_page_id, limit);
+}
+
 vector< table_object > playchain_api::list_all_tables(
                                  const string &last_page_id,
                                  const uint32_t limit) const
@@ -1314,6 +1615,12 @@ optional< playchain_table_info > playchain_api::get_table_info_for_pending_buy_i
     return _impl->get_table_info_for_pending_buy_in_proposal(name_or_id, uid);
 }
 
+vector< optional< playchain_table_info > > playchain_api::get_tables_info_for_pending_buy_in_proposals(
+                                                    const vector< std::pair<string, string> > &names_or_ids_and_uids) const
+{
+    return _impl->get_tables_info_for_pending_buy_in_proposals(names_or_ids_and_uids);
+}
+
 playchain_property_object playchain_api::get_playchain_properties() const
 {
     return _impl->get_playchain_properties();
@@ -1324,6 +1631,11 @@ vector< playchain_player_table_info > playchain_api::list_tables_with_player(con
     return _impl->list_tables_with_player(name_or_id, limit);
 }
 
+vector< vector< playchain_player_table_info > > playchain_api::list_tables_with_players(const vector<string> &names_or_ids, const uint32_t limit) const
+{
+    return _impl->list_tables_with_players(names_or_ids, limit);
+}
+
 optional< playchain_account_info > playchain_api::get_player_account_by_name(const string &name) const
 {
     return _impl->get_player_account_by_name(name);
@@ -266,6 +266,37 @@ void account_member_index::object_modified(const object& after)
 
 }
 
+uint64_t account_member_index::get_memory_usage()const
+{
+   return estimate_dynamic_memory_usage( account_to_account_memberships )
+        + estimate_dynamic_memory_usage( account_to_key_memberships )
+        + estimate_dynamic_memory_usage( account_to_address_memberships );
+}
+
+void account_authority_revision_index::object_inserted( const object& obj )
+{
+   ++_revision;
+}
+
+void account_authority_revision_index::object_removed( const object& obj )
+{
+   ++_revision;
+}
+
+void account_authority_revision_index::about_to_modify( const object& before )
+{
+   const account_object& a = static_cast<const account_object&>(before);
+   _owner_before = a.owner;
+   _active_before = a.active;
+}
+
+void account_authority_revision_index::object_modified( const object& after )
+{
+   const account_object& a = static_cast<const account_object&>(after);
+   if( !( a.owner == _owner_before ) || !( a.active == _active_before ) )
+      ++_revision;
+}
+
 void account_referrer_index::object_inserted( const object& obj )
 {
 }
@@ -278,6 +309,10 @@ void account_referrer_index::about_to_modify( const object& before )
 void account_referrer_index::object_modified( const object& after  )
 {
 }
+uint64_t account_referrer_index::get_memory_usage()const
+{
+   return estimate_dynamic_memory_usage( referred_by );
+}
 
 const uint8_t  balances_by_account_index::bits = 20;
 const uint64_t balances_by_account_index::mask = (1ULL << balances_by_account_index::bits) - 1;
@@ -312,6 +347,11 @@ void balances_by_account_index::object_modified( const object& after  )
    ids_being_modified.pop();
 }
 
+uint64_t balances_by_account_index::get_memory_usage()const
+{
+   return estimate_dynamic_memory_usage( balances );
+}
+
 const map< asset_id_type, const account_balance_object* >& balances_by_account_index::get_account_balances( const account_id_type& acct )const
 {
    static const map< asset_id_type, const account_balance_object* > _empty;
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <graphene/chain/block_arena.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <new>
+
+namespace graphene { namespace chain {
+
+block_arena::block_arena( size_t chunk_size ): _chunk_size( std::max<size_t>( chunk_size, 1 ) )
+{
+}
+
+block_arena::~block_arena()
+{
+   for( const auto& c : _chunks )
+      ::operator delete( c.data );
+}
+
+void block_arena::add_chunk( size_t min_size )
+{
+   chunk c;
+   c.size = std::max( _chunk_size, min_size );
+   c.data = static_cast<char*>( ::operator new( c.size ) );
+   ++_heap_allocations;
+   _chunks.push_back( c );
+   _offset = 0;
+}
+
+void* block_arena::allocate( size_t bytes, size_t alignment )
+{
+   ++_allocations;
+   if( !active() )
+   {
+      ++_heap_allocations;
+      return ::operator new( bytes );
+   }
+
+   if( !_chunks.empty() )
+   {
+      const chunk& last = _chunks.back();
+      size_t offset = ( _offset + alignment - 1 ) / alignment * alignment;
+      if( offset + bytes <= last.size )
+      {
+         _used += offset - _offset + bytes;
+         _offset = offset + bytes;
+         return last.data + offset;
+      }
+   }
+
+   // the chunks are allocated by operator new, so their start is aligned for any type
+   add_chunk( bytes );
+   _used += bytes;
+   _offset = bytes;
+   return _chunks.back().data;
+}
+
+bool block_arena::in_chunks( const void* p )const
+{
+   const char* c = static_cast<const char*>( p );
+   for( const auto& ch : _chunks )
+      if( std::less_equal<const char*>()( ch.data, c ) && std::less<const char*>()( c, ch.data + ch.size ) )
+         return true;
+   return false;
+}
+
+void block_arena::deallocate( void* p, size_t )
+{
+   // a container made outside the scope may be grown or dropped inside it and the other way round
+   if( !in_chunks( p ) )
+      ::operator delete( p );
+}
+
+void block_arena::reset()
+{
+   if( _chunks.size() > 1 )
+   {
+      // the next blocks get one chunk large enough for this one
+      const size_t total = capacity();
+      for( const auto& c : _chunks )
+         ::operator delete( c.data );
+      _chunks.clear();
+      add_chunk( total );
+   }
+   _offset = 0;
+   _used = 0;
+   _enabled = _enabled_on_reset;
+}
+
+size_t block_arena::capacity()const
+{
+   size_t result = 0;
+   for( const auto& c : _chunks )
+      result += c.size;
+   return result;
+}
+
+} } // graphene::chain
@@ -38,6 +38,8 @@ FC_REFLECT( graphene::chain::index_entry, (block_pos)(block_size)(block_id) );
 
 namespace graphene { namespace chain {
 
+const uint32_t block_database::default_header_cache_size;
+
 void block_database::open( const fc::path& dbdir )
 { try {
    fc::create_directories(dbdir);
@@ -66,6 +68,7 @@ void block_database::close()
 {
   _blocks.close();
   _block_num_to_pos.close();
+  clear_cache();
 }
 
 void block_database::flush()
@@ -91,6 +94,10 @@ void block_database::store( const block_id_type& _id, const signed_block& b )
    e.block_id   = id;
    _blocks.write( vec.data(), vec.size() );
    _block_num_to_pos.write( (char*)&e, sizeof(e) );
+
+   uncache( block_header::num_from_id(id) );
+   cache_header( id, b );
+   cache_block( id, b, vec.size() );
 }
 
 void block_database::remove( const block_id_type& id )
@@ -106,6 +113,7 @@ void block_database::remove( const block_id_type& id )
 
    if( e.block_id == id )
    {
+      uncache( block_header::num_from_id(id) );
       e.block_size = 0;
       _block_num_to_pos.seekp( sizeof(e) * int64_t(block_header::num_from_id(id)) );
       _block_num_to_pos.write( (char*)&e, sizeof(e) );
@@ -131,6 +139,13 @@ bool block_database::contains( const block_id_type& id )const
 block_id_type block_database::fetch_block_id( uint32_t block_num )const
 {
    assert( block_num != 0 );
+   if( const header_cache_entry* cached = find_cached_header( block_num ) )
+   {
+      ++_cache_stats.header_hits;
+      return cached->block_id;
+   }
+   ++_cache_stats.header_misses;
+
    index_entry e;
    int64_t index_pos = sizeof(e) * int64_t(block_num);
    _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
@@ -148,23 +163,28 @@ optional<signed_block> block_database::fetch_optional( const block_id_type& id )
 {
    try
    {
-      index_entry e;
-      int64_t index_pos = sizeof(e) * int64_t(block_header::num_from_id(id));
-      _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
-      if ( _block_num_to_pos.tellg() <= index_pos )
-         return {};
+      const uint32_t block_num = block_header::num_from_id(id);
+      if( const block_cache_entry* cached = find_cached_block( block_num ) )
+      {
+         if( cached->block_id != id ) return optional<signed_block>();
+         ++_cache_stats.block_hits;
+         return cached->block;
+      }
+      ++_cache_stats.block_misses;
 
-      _block_num_to_pos.seekg( index_pos );
-      _block_num_to_pos.read( (char*)&e, sizeof(e) );
+      optional<index_entry> e = read_index_entry( block_num );
+      if( !e.valid() ) return {};
 
-      if( e.block_id != id ) return optional<signed_block>();
+      if( e->block_id != id ) return optional<signed_block>();
 
-      vector<char> data( e.block_size );
-      _blocks.seekg( e.block_pos );
-      if (e.block_size)
-         _blocks.read( data.data(), e.block_size );
+      vector<char> data( e->block_size );
+      _blocks.seekg( e->block_pos );
+      if (e->block_size)
+         _blocks.read( data.data(), e->block_size );
       auto result = fc::raw::unpack<signed_block>(data);
-      FC_ASSERT( result.id() == e.block_id );
+      FC_ASSERT( result.id() == e->block_id );
+      cache_header( e->block_id, result );
+      cache_block( e->block_id, result, e->block_size );
       return result;
    }
    catch (const fc::exception&)
@@ -180,20 +200,23 @@ optional<signed_block> block_database::fetch_by_number( uint32_t block_num )cons
 {
    try
    {
-      index_entry e;
-      int64_t index_pos = sizeof(e) * int64_t(block_num);
-      _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
-      if ( _block_num_to_pos.tellg() <= index_pos )
-         return {};
+      if( const block_cache_entry* cached = find_cached_block( block_num ) )
+      {
+         ++_cache_stats.block_hits;
+         return cached->block;
+      }
+      ++_cache_stats.block_misses;
 
-      _block_num_to_pos.seekg( index_pos, _block_num_to_pos.beg );
-      _block_num_to_pos.read( (char*)&e, sizeof(e) );
+      optional<index_entry> e = read_index_entry( block_num );
+      if( !e.valid() ) return {};
 
-      vector<char> data( e.block_size );
-      _blocks.seekg( e.block_pos );
-      _blocks.read( data.data(), e.block_size );
+      vector<char> data( e->block_size );
+      _blocks.seekg( e->block_pos );
+      _blocks.read( data.data(), e->block_size );
       auto result = fc::raw::unpack<signed_block>(data);
-      FC_ASSERT( result.id() == e.block_id );
+      FC_ASSERT( result.id() == e->block_id );
+      cache_header( e->block_id, result );
+      cache_block( e->block_id, result, e->block_size );
       return result;
    }
    catch (const fc::exception&)
@@ -205,6 +228,61 @@ optional<signed_block> block_database::fetch_by_number( uint32_t block_num )cons
    return optional<signed_block>();
 }
 
+optional<signed_block_header> block_database::fetch_header_by_number( uint32_t block_num )const
+{
+   try
+   {
+      if( const header_cache_entry* cached = find_cached_header( block_num ) )
+      {
+         ++_cache_stats.header_hits;
+         return cached->header;
+      }
+      if( const block_cache_entry* cached = find_cached_block( block_num ) )
+      {
+         ++_cache_stats.header_hits;
+         cache_header( cached->block_id, cached->block );
+         return signed_block_header( cached->block );
+      }
+      ++_cache_stats.header_misses;
+
+      optional<index_entry> e = read_index_entry( block_num );
+      if( !e.valid() ) return {};
+
+      vector<char> data( e->block_size );
+      _blocks.seekg( e->block_pos );
+      _blocks.read( data.data(), e->block_size );
+
+      // signed_block is serialized as signed_block_header followed by transactions,
+      // so the header can be unpacked without touching the transactions
+      signed_block_header result;
+      fc::datastream<const char*> ds( data.data(), data.size() );
+      fc::raw::unpack( ds, result );
+      FC_ASSERT( result.id() == e->block_id );
+      cache_header( e->block_id, result );
+      return result;
+   }
+   catch (const fc::exception&)
+   {
+   }
+   catch (const std::exception&)
+   {
+   }
+   return optional<signed_block_header>();
+}
+
+optional<index_entry> block_database::read_index_entry( uint32_t block_num )const
+{
+   index_entry e;
+   int64_t index_pos = sizeof(e) * int64_t(block_num);
+   _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
+   if ( _block_num_to_pos.tellg() <= index_pos )
+      return {};
+
+   _block_num_to_pos.seekg( index_pos, _block_num_to_pos.beg );
+   _block_num_to_pos.read( (char*)&e, sizeof(e) );
+   return e;
+}
+
 optional<index_entry> block_database::last_index_entry()const {
    try
    {
@@ -281,4 +359,108 @@ size_t block_database::total_block_size()const
    return (size_t)_blocks.tellg();
 }
 
+void block_database::set_cache_limits( uint32_t max_headers, uint64_t max_block_bytes )
+{
+   _max_cached_headers = max_headers;
+   _max_cached_block_bytes = max_block_bytes;
+
+   while( _header_cache.size() > _max_cached_headers )
+      _header_cache.pop_back();
+   while( !_block_cache.empty() && _cache_stats.cached_block_bytes > _max_cached_block_bytes )
+   {
+      _cache_stats.cached_block_bytes -= _block_cache.back().packed_size;
+      _block_cache.pop_back();
+   }
+}
+
+block_cache_stats block_database::get_cache_stats()const
+{
+   block_cache_stats result = _cache_stats;
+   result.cached_headers = _header_cache.size();
+   result.cached_blocks = _block_cache.size();
+   return result;
+}
+
+void block_database::clear_cache()
+{
+   _header_cache.clear();
+   _block_cache.clear();
+   _cache_stats.cached_block_bytes = 0;
+}
+
+const block_database::header_cache_entry* block_database::find_cached_header( uint32_t block_num )const
+{
+   auto& by_num_idx = _header_cache.get<by_num>();
+   auto itr = by_num_idx.find( block_num );
+   if( itr == by_num_idx.end() )
+      return nullptr;
+   _header_cache.relocate( _header_cache.begin(), _header_cache.project<0>( itr ) );
+   return &(*itr);
+}
+
+const block_database::block_cache_entry* block_database::find_cached_block( uint32_t block_num )const
+{
+   auto& by_num_idx = _block_cache.get<by_num>();
+   auto itr = by_num_idx.find( block_num );
+   if( itr == by_num_idx.end() )
+      return nullptr;
+   _block_cache.relocate( _block_cache.begin(), _block_cache.project<0>( itr ) );
+   return &(*itr);
+}
+
+void block_database::cache_header( const block_id_type& id, const signed_block_header& header )const
+{
+   if( !_max_cached_headers )
+      return;
+
+   const uint32_t block_num = block_header::num_from_id(id);
+   auto& by_num_idx = _header_cache.get<by_num>();
+   auto itr = by_num_idx.find( block_num );
+   if( itr != by_num_idx.end() )
+   {
+      by_num_idx.erase( itr );
+   }
+
+   _header_cache.push_front( header_cache_entry{ block_num, id, header } );
+   while( _header_cache.size() > _max_cached_headers )
+      _header_cache.pop_back();
+}
+
+void block_database::cache_block( const block_id_type& id, const signed_block& b, uint64_t packed_size )const
+{
+   if( packed_size > _max_cached_block_bytes )
+      return;
+
+   const uint32_t block_num = block_header::num_from_id(id);
+   auto& by_num_idx = _block_cache.get<by_num>();
+   auto itr = by_num_idx.find( block_num );
+   if( itr != by_num_idx.end() )
+   {
+      _cache_stats.cached_block_bytes -= itr->packed_size;
+      by_num_idx.erase( itr );
+   }
+
+   _block_cache.push_front( block_cache_entry{ block_num, id, b, packed_size } );
+   _cache_stats.cached_block_bytes += packed_size;
+   while( _cache_stats.cached_block_bytes > _max_cached_block_bytes )
+   {
+      _cache_stats.cached_block_bytes -= _block_cache.back().packed_size;
+      _block_cache.pop_back();
+   }
+}
+
+void block_database::uncache( uint32_t block_num )const
+{
+   auto& headers_by_num = _header_cache.get<by_num>();
+   headers_by_num.erase( block_num );
+
+   auto& blocks_by_num = _block_cache.get<by_num>();
+   auto itr = blocks_by_num.find( block_num );
+   if( itr != blocks_by_num.end() )
+   {
+      _cache_stats.cached_block_bytes -= itr->packed_size;
+      blocks_by_num.erase( itr );
+   }
+}
+
 } }
@@ -42,6 +42,8 @@
 #include <playchain/chain/block_tasks.hpp>
 #include <playchain/chain/playchain_config.hpp>
 
+#include <future>
+
 namespace graphene { namespace chain {
 
 bool database::is_known_block( const block_id_type& id )const
@@ -81,6 +83,25 @@ optional<signed_block> database::fetch_block_by_number( uint32_t num )const
       return _block_id_to_block.fetch_by_number(num);
 }
 
+optional<signed_block_header> database::fetch_block_header_by_number( uint32_t num )const
+{
+   auto results = _fork_db.fetch_block_by_number(num);
+   if( results.size() == 1 )
+      return signed_block_header( results[0]->data );
+   else
+      return _block_id_to_block.fetch_header_by_number(num);
+}
+
+void database::set_block_cache_limits( uint32_t max_headers, uint64_t max_block_bytes )
+{
+   _block_id_to_block.set_cache_limits( max_headers, max_block_bytes );
+}
+
+block_cache_stats database::get_block_cache_stats()const
+{
+   return _block_id_to_block.get_cache_stats();
+}
+
 const signed_transaction& database::get_recent_transaction(const transaction_id_type& trx_id) const
 {
    auto& index = get_index_type<transaction_index>().indices().get<by_trx_id>();
@@ -125,6 +146,12 @@ bool database::push_block(const signed_block& new_block, uint32_t skip)
          result = _push_block(new_block);
       });
    });
+
+   // the pending transactions have just been re-applied to the new head block state,
+   // so the next preparation of a block only appends them instead of re-applying them again
+   if( _pending_tx_session.valid() )
+      _start_prepared_block( _prepared_block.witness );
+
    return result;
 }
 
@@ -241,7 +268,10 @@ processed_transaction database::_push_transaction( const precomputable_transacti
    // If this is the first transaction pushed after applying a block, start a new undo session.
    // This allows us to quickly rewind to the clean state of the head block, in case a new block arrives.
    if( !_pending_tx_session.valid() )
+   {
       _pending_tx_session = _undo_db.start_undo_session();
+      ++_pending_tx_session_revision;
+   }
 
    // Create a temporary undo session as a child of _pending_tx_session.
    // The temporary session will be discarded by the destructor if
@@ -309,13 +339,13 @@ processed_transaction database::push_proposal(const proposal_object& proposal)
       {
          for( size_t i=old_applied_ops_size,n=_applied_ops.size(); i<n; i++ )
          {
-            ilog( "removing failed operation from applied_ops: ${op}", ("op", *(_applied_ops[i])) );
-            _applied_ops[i].reset();
+            ilog( "removing failed operation from applied_ops: ${op}", ("op", _applied_ops[i].op) );
+            _applied_ops[i].removed = true;
          }
       }
       else
       {
-         _applied_ops.resize( old_applied_ops_size );
+         _applied_ops.truncate( old_applied_ops_size );
       }
       wlog( "${e}", ("e",e.to_detail_string() ) );
       throw;
@@ -340,6 +370,27 @@ signed_block database::generate_block(
    return result;
 } FC_CAPTURE_AND_RETHROW() }
 
+static size_t max_block_header_size( witness_id_type witness_id )
+{
+   static const size_t max_partial_block_header_size = fc::raw::pack_size( signed_block_header() )
+                                                       - fc::raw::pack_size( witness_id_type() ) // witness_id
+                                                       + 3; // max space to store size of transactions (out of block header),
+                                                            // +3 means 3*7=21 bits so it's practically safe
+   return max_partial_block_header_size + fc::raw::pack_size( witness_id );
+}
+
+/// once an applied transaction may have changed account authorities the snapshot of parallel verification is stale
+static bool may_change_authorities( const transaction& tx )
+{
+   for( const auto& op : tx.operations )
+   {
+      if( op.which() == operation::tag<account_update_operation>::value
+          || op.which() == operation::tag<proposal_update_operation>::value )
+         return true;
+   }
+   return false;
+}
+
 signed_block database::_generate_block(
    fc::time_point_sec when,
    witness_id_type witness_id,
@@ -352,66 +403,75 @@ signed_block database::_generate_block(
    FC_ASSERT( slot_num > 0 );
    witness_id_type scheduled_witness = get_scheduled_witness( slot_num );
    FC_ASSERT( scheduled_witness == witness_id );
+   signed_block pending_block;
 
-   //
-   // The following code throws away existing pending_tx_session and
-   // rebuilds it by re-applying pending transactions.
-   //
-   // This rebuild is necessary because pending transactions' validity
-   // and semantics may have changed since they were received, because
-   // time-based semantics are evaluated based on the current block
-   // time.  These changes can only be reflected in the database when
-   // the value of the "when" variable is known, which means we need to
-   // re-apply pending transactions in this method.
-   //
-
-   // pop pending state (reset to head block state)
-   _pending_tx_session.reset();
-
-   // Check witness signing key
-   if( !(skip & skip_witness_signature) )
+   if( _is_prepared_block_valid() )
    {
-      // Note: if this check failed (which won't happen in normal situations),
-      // we would have temporarily broken the invariant that
-      // _pending_tx_session is the result of applying _pending_tx.
-      // In this case, when the node received a new block,
-      // the push_block() call will re-create the _pending_tx_session.
-      FC_ASSERT( witness_id(*this).signing_key == block_signing_private_key.get_public_key() );
+      if( _prepared_block.witness != witness_id )
+         _start_prepared_block( witness_id );
+
+      // Check witness signing key
+      if( !(skip & skip_witness_signature) )
+         FC_ASSERT( witness_id(*this).signing_key == block_signing_private_key.get_public_key() );
+
+      //
+      // The pending transactions were re-applied to the head block state
+      // by prepare_block() or push_block(), the ones pushed since were applied on top of it.
+      //
+      _extend_prepared_block();
+      pending_block = std::move( _prepared_block );
+      _prepared_block = signed_block();
+      _prepared_block_revision = 0;
+
+      _pending_tx_session.reset();
    }
-
-   static const size_t max_partial_block_header_size = fc::raw::pack_size( signed_block_header() )
-                                                       - fc::raw::pack_size( witness_id_type() ) // witness_id
-                                                       + 3; // max space to store size of transactions (out of block header),
-                                                            // +3 means 3*7=21 bits so it's practically safe
-   const size_t max_block_header_size = max_partial_block_header_size + fc::raw::pack_size( witness_id );
-   auto maximum_block_size = get_global_properties().parameters.maximum_block_size;
-   size_t total_block_size = max_block_header_size;
-
-   signed_block pending_block;
-
-   _pending_tx_session = _undo_db.start_undo_session();
-
-   uint64_t postponed_tx_count = 0;
-   for( const processed_transaction& tx : _pending_tx )
+   else
    {
-      size_t new_total_size = total_block_size + fc::raw::pack_size( tx );
+      //
+      // The following code throws away existing pending_tx_session and
+      // rebuilds it by re-applying pending transactions.
+      //
+      // This rebuild is necessary because pending transactions' validity
+      // and semantics may have changed since they were received, because
+      // time-based semantics are evaluated based on the current block
+      // time.  These changes can only be reflected in the database when
+      // the value of the "when" variable is known, which means we need to
+      // re-apply pending transactions in this method.
+      //
+
+      // pop pending state (reset to head block state)
+      _pending_tx_session.reset();
+
+      // Check witness signing key
+      if( !(skip & skip_witness_signature) )
+      {
+         // Note: if this check failed (which won't happen in normal situations),
+         // we would have temporarily broken the invariant that
+         // _pending_tx_session is the result of applying _pending_tx.
+         // In this case, when the node received a new block,
+         // the push_block() call will re-create the _pending_tx_session.
+         FC_ASSERT( witness_id(*this).signing_key == block_signing_private_key.get_public_key() );
+      }
 
-      // postpone transaction if it would make block too big
-      if( new_total_size > maximum_block_size )
+      flat_set<transaction_id_type> verified_trx_ids;
+      if( _parallel_block_building && !(skip & skip_transaction_signatures) )
       {
-         postponed_tx_count++;
-         continue;
+         verified_trx_ids = _verify_pending_transactions_parallel();
       }
+      // once an applied transaction may have changed account authorities the snapshot is stale
+      bool authorities_changed = false;
 
-      try
+      auto maximum_block_size = get_global_properties().parameters.maximum_block_size;
+      size_t total_block_size = max_block_header_size( witness_id );
+
+      _pending_tx_session = _undo_db.start_undo_session();
+      ++_pending_tx_session_revision;
+
+      uint64_t postponed_tx_count = 0;
+      for( const processed_transaction& tx : _pending_tx )
       {
-         auto temp_session = _undo_db.start_undo_session();
-         processed_transaction ptx = _apply_transaction( tx );
+         size_t new_total_size = total_block_size + fc::raw::pack_size( tx );
 
-         // We have to recompute pack_size(ptx) because it may be different
-         // than pack_size(tx) (i.e. if one or more results increased
-         // their size)
-         new_total_size = total_block_size + fc::raw::pack_size( ptx );
          // postpone transaction if it would make block too big
          if( new_total_size > maximum_block_size )
          {
@@ -419,24 +479,48 @@ signed_block database::_generate_block(
             continue;
          }
 
-         temp_session.merge();
-
-         total_block_size = new_total_size;
-         pending_block.transactions.push_back( ptx );
+         try
+         {
+            auto temp_session = _undo_db.start_undo_session();
+            processed_transaction ptx;
+            if( !authorities_changed && verified_trx_ids.count( tx.id() ) )
+               detail::with_skip_flags( *this, skip | skip_transaction_signatures, [&](){ ptx = _apply_transaction( tx ); } );
+            else
+               ptx = _apply_transaction( tx );
+
+            // We have to recompute pack_size(ptx) because it may be different
+            // than pack_size(tx) (i.e. if one or more results increased
+            // their size)
+            new_total_size = total_block_size + fc::raw::pack_size( ptx );
+            // postpone transaction if it would make block too big
+            if( new_total_size > maximum_block_size )
+            {
+               postponed_tx_count++;
+               continue;
+            }
+
+            temp_session.merge();
+
+            if( !verified_trx_ids.empty() && !authorities_changed )
+               authorities_changed = may_change_authorities( tx );
+
+            total_block_size = new_total_size;
+            pending_block.transactions.push_back( ptx );
+         }
+         catch ( const fc::exception& e )
+         {
+            // Do nothing, transaction will not be re-applied
+            wlog( "Transaction was not processed while generating block due to ${e}", ("e", e) );
+            wlog( "The transaction was ${t}", ("t", tx) );
+         }
       }
-      catch ( const fc::exception& e )
+      if( postponed_tx_count > 0 )
       {
-         // Do nothing, transaction will not be re-applied
-         wlog( "Transaction was not processed while generating block due to ${e}", ("e", e) );
-         wlog( "The transaction was ${t}", ("t", tx) );
+         wlog( "Postponed ${n} transactions due to block size limit", ("n", postponed_tx_count) );
       }
-   }
-   if( postponed_tx_count > 0 )
-   {
-      wlog( "Postponed ${n} transactions due to block size limit", ("n", postponed_tx_count) );
-   }
 
-   _pending_tx_session.reset();
+      _pending_tx_session.reset();
+   }
 
    // We have temporarily broken the invariant that
    // _pending_tx_session is the result of applying _pending_tx, as
@@ -457,6 +541,112 @@ signed_block database::_generate_block(
    return pending_block;
 } FC_CAPTURE_AND_RETHROW( (witness_id) ) }
 
+void database::prepare_block( witness_id_type witness_id, uint32_t skip /* = 0 */ )
+{ try {
+   detail::with_skip_flags( *this, skip, [&]()
+   {
+      _prepare_block( witness_id );
+   } );
+} FC_CAPTURE_AND_RETHROW( (witness_id) ) }
+
+void database::_prepare_block( witness_id_type witness_id )
+{
+   if( _is_prepared_block_valid() )
+   {
+      // the pending state does not depend on the witness, only the block is started again
+      if( _prepared_block.witness != witness_id )
+         _start_prepared_block( witness_id );
+      _extend_prepared_block();
+      return;
+   }
+
+   uint32_t skip = get_node_properties().skip_flags;
+
+   // pop pending state (reset to head block state)
+   _pending_tx_session.reset();
+
+   flat_set<transaction_id_type> verified_trx_ids;
+   if( _parallel_block_building && !(skip & skip_transaction_signatures) )
+   {
+      verified_trx_ids = _verify_pending_transactions_parallel();
+   }
+   bool authorities_changed = false;
+
+   // the pending state is rebuilt with the transactions that are still valid,
+   // all of them stay pending but only the first ones fitting the block are prepared
+   vector<processed_transaction> pending_tx = std::move( _pending_tx );
+   _pending_tx.clear();
+
+   _pending_tx_session = _undo_db.start_undo_session();
+   ++_pending_tx_session_revision;
+
+   for( const processed_transaction& tx : pending_tx )
+   {
+      try
+      {
+         auto temp_session = _undo_db.start_undo_session();
+         processed_transaction ptx;
+         if( !authorities_changed && verified_trx_ids.count( tx.id() ) )
+            detail::with_skip_flags( *this, skip | skip_transaction_signatures, [&](){ ptx = _apply_transaction( tx ); } );
+         else
+            ptx = _apply_transaction( tx );
+         temp_session.merge();
+
+         if( !verified_trx_ids.empty() && !authorities_changed )
+            authorities_changed = may_change_authorities( tx );
+
+         _pending_tx.push_back( std::move( ptx ) );
+      }
+      catch ( const fc::exception& e )
+      {
+         // Do nothing, transaction will not be re-applied
+         wlog( "Transaction was not processed while preparing block due to ${e}", ("e", e) );
+         wlog( "The transaction was ${t}", ("t", tx) );
+      }
+   }
+
+   _start_prepared_block( witness_id );
+   _extend_prepared_block();
+}
+
+void database::_start_prepared_block( witness_id_type witness_id )
+{
+   _prepared_block = signed_block();
+   _prepared_block.previous = head_block_id();
+   _prepared_block.witness = witness_id;
+   _prepared_block_size = max_block_header_size( witness_id );
+   _prepared_block_full = false;
+   _prepared_block_revision = _pending_tx_session_revision;
+}
+
+bool database::_is_prepared_block_valid()const
+{
+   return _prepared_block_revision != 0
+          && _prepared_block_revision == _pending_tx_session_revision
+          && _pending_tx_session.valid()
+          && _prepared_block.previous == head_block_id();
+}
+
+void database::_extend_prepared_block()
+{
+   const size_t maximum_block_size = get_global_properties().parameters.maximum_block_size;
+
+   // the block takes a prefix of the pending transactions so that its state is the one they were applied to
+   while( !_prepared_block_full && _prepared_block.transactions.size() < _pending_tx.size() )
+   {
+      const processed_transaction& ptx = _pending_tx[_prepared_block.transactions.size()];
+      size_t new_total_size = _prepared_block_size + fc::raw::pack_size( ptx );
+      if( new_total_size > maximum_block_size )
+      {
+         _prepared_block_full = true;
+         break;
+      }
+
+      _prepared_block_size = new_total_size;
+      _prepared_block.transactions.push_back( ptx );
+   }
+}
+
 /**
  * Removes the most recent block from the database and
  * undoes any changes it made.
@@ -486,8 +676,23 @@ void database::clear_pending()
 
 uint32_t database::push_applied_operation( const operation& op )
 {
-   _applied_ops.emplace_back(op);
-   operation_history_object& oh = *(_applied_ops.back());
+   if( !_record_applied_operations )
+   {
+      ++_current_virtual_op;
+      return no_applied_operation;
+   }
+   return push_applied_operation( operation( op ) );
+}
+uint32_t database::push_applied_operation( operation&& op )
+{
+   if( !_record_applied_operations )
+   {
+      ++_current_virtual_op;
+      return no_applied_operation;
+   }
+
+   // the operation is moved into the log, the strings of the virtual operations are not copied again
+   applied_operations_type::entry& oh = _applied_ops.append( std::move( op ) );
    oh.block_num    = _current_block_num;
    oh.trx_in_block = _current_trx_in_block;
    oh.op_in_trx    = _current_op_in_trx;
@@ -496,17 +701,20 @@ uint32_t database::push_applied_operation( const operation& op )
 }
 void database::set_applied_operation_result( uint32_t op_id, const operation_result& result )
 {
+   if( op_id == no_applied_operation )
+      return;
    assert( op_id < _applied_ops.size() );
-   if( _applied_ops[op_id] )
-      _applied_ops[op_id]->result = result;
+   if( !_applied_ops[op_id].removed )
+      _applied_ops[op_id].result = result;
    else
    {
       elog( "Could not set operation result (head_block_num=${b})", ("b", head_block_num()) );
    }
 }
 
-const vector<optional< operation_history_object > >& database::get_applied_operations() const
+const database::applied_operations_type& database::get_applied_operations() const
 {
+   FC_ASSERT( _record_applied_operations, "The applied operations are not recorded, register the consumer" );
    return _applied_ops;
 }
 
@@ -532,11 +740,36 @@ void database::apply_block( const signed_block& next_block, uint32_t skip )
    return;
 }
 
+/// drops the memory of the block whether it is applied or fails,
+/// the operations release their buffer before the arena it is allocated in
+class block_memory_guard {
+public:
+   block_memory_guard( database::applied_operations_type& applied_ops, block_arena& arena )
+      : _applied_ops( applied_ops ), _arena( arena ) {}
+   ~block_memory_guard()
+   {
+      _applied_ops.release();
+      _arena.reset();
+   }
+
+   block_memory_guard( const block_memory_guard& ) = delete;
+   block_memory_guard& operator=( const block_memory_guard& ) = delete;
+
+private:
+   database::applied_operations_type& _applied_ops;
+   block_arena&                       _arena;
+};
+
 void database::_apply_block( const signed_block& next_block )
 { try {
    uint32_t next_block_num = next_block.block_num();
    uint32_t skip = get_node_properties().skip_flags;
    _applied_ops.clear();
+   // the containers of the block are destroyed before the guard
+   block_memory_guard memory_guard( _applied_ops, _block_arena );
+   block_arena::scope arena_scope( _block_arena );
+   // the consumers subscribed in the middle of the previous block are counted from this one
+   _record_applied_operations = applied_operations_consumed();
 
    if( !(skip & skip_block_size_check) )
    {
@@ -645,7 +878,7 @@ processed_transaction database::_apply_transaction(const signed_transaction& trx
 
    if( !(skip & skip_transaction_signatures) )
    {
-      bool allow_non_immediate_owner = ( head_block_time() >= HARDFORK_CORE_584_TIME );
+      bool allow_non_immediate_owner = ( hardforks().core_584 );
       auto get_active = [&]( account_id_type id ) { return &id(*this).active; };
       auto get_owner  = [&]( account_id_type id ) { return &id(*this).owner;  };
       trx.verify_authority( chain_id,
@@ -815,6 +1048,120 @@ fc::future<void> database::precompute_parallel( const signed_block& block, const
    return *first;
 } FC_LOG_AND_RETHROW() }
 
+void database::enable_parallel_block_building( bool enable, uint32_t num_threads )
+{
+   _parallel_block_building = enable;
+   if( !enable )
+      _verification_pool.reset();
+   else if( !_verification_pool || ( num_threads != 0 && num_threads != _verification_pool->size() ) )
+      _verification_pool.reset( new worker_pool( num_threads ) );
+}
+
+flat_set<transaction_id_type> database::_verify_pending_transactions_parallel()const
+{ try {
+   typedef std::map< account_id_type, std::pair<authority, authority> > authority_snapshot_type;
+
+   flat_set<transaction_id_type> result;
+   if( _pending_tx.empty() )
+      return result;
+
+   // Workers must not touch the object database (other tasks of this thread may modify it
+   // while we are waiting for them), so they get copies of the transactions and of every
+   // account authority the transactions may need.
+   vector<precomputable_transaction> trxs( _pending_tx.begin(), _pending_tx.end() );
+
+   const chain_parameters& params = get_global_properties().parameters;
+   const uint32_t max_depth = params.max_authority_depth;
+   const bool allow_non_immediate_owner = ( hardforks().core_584 );
+   const chain_id_type chain_id = get_chain_id();
+
+   authority_snapshot_type snapshot;
+   flat_set<account_id_type> level;
+   for( const auto& trx : trxs )
+   {
+      flat_set<account_id_type> required_owner;
+      vector<authority> other;
+      for( const auto& op : trx.operations )
+         operation_get_required_authorities( op, level, required_owner, other );
+      level.insert( required_owner.begin(), required_owner.end() );
+      for( const auto& auth : other )
+         for( const auto& a : auth.account_auths )
+            level.insert( a.first );
+   }
+   for( uint32_t depth = 0; depth <= max_depth && !level.empty(); ++depth )
+   {
+      flat_set<account_id_type> next_level;
+      for( const account_id_type& id : level )
+      {
+         if( snapshot.count( id ) )
+            continue;
+         const account_object* account = find( id );
+         if( account == nullptr )
+            continue;
+         snapshot.emplace( id, std::make_pair( account->active, account->owner ) );
+         for( const auto& a : account->active.account_auths )
+            next_level.insert( a.first );
+         for( const auto& a : account->owner.account_auths )
+            next_level.insert( a.first );
+      }
+      level = std::move( next_level );
+   }
+
+   vector<uint8_t> verified( trxs.size(), 0 );
+   auto verify_chunk = [&]( size_t base, size_t count ) {
+      auto get_active = [&snapshot]( account_id_type id ) {
+         auto itr = snapshot.find( id );
+         FC_ASSERT( itr != snapshot.end() );
+         return &itr->second.first;
+      };
+      auto get_owner = [&snapshot]( account_id_type id ) {
+         auto itr = snapshot.find( id );
+         FC_ASSERT( itr != snapshot.end() );
+         return &itr->second.second;
+      };
+      for( size_t i = base; i < base + count; ++i )
+      {
+         try
+         {
+            const auto& trx = trxs[i];
+            trx.validate();
+            trx.get_packed_size();
+            trx.id();
+            trx.verify_authority( chain_id, get_active, get_owner, allow_non_immediate_owner, max_depth );
+            verified[i] = 1;
+         }
+         catch( const fc::exception& )
+         {
+            // will be verified again while applying
+         }
+      }
+   };
+
+   // The callers have popped the pending state at this point. Waiting on fc futures would let
+   // push_transaction() or push_block() run on this thread in between and leave the undo stack
+   // inconsistent, so the workers are waited for without yielding to the other tasks.
+   std::vector<std::future<void>> workers;
+   uint32_t chunks = _verification_pool->size();
+   size_t chunk_size = ( trxs.size() + chunks - 1 ) / chunks;
+   workers.reserve( chunks );
+   for( size_t base = 0; base < trxs.size(); base += chunk_size )
+   {
+      size_t count = base + chunk_size < trxs.size() ? chunk_size : trxs.size() - base;
+      workers.push_back( _verification_pool->post( [&verify_chunk,base,count] () { verify_chunk( base, count ); } ) );
+   }
+   // every worker refers to the locals, so all of them are finished before a failure is rethrown
+   for( auto& worker : workers )
+      worker.wait();
+   for( auto& worker : workers )
+      worker.get();
+
+   result.reserve( trxs.size() );
+   for( size_t i = 0; i < trxs.size(); ++i )
+      if( verified[i] )
+         result.insert( trxs[i].id() );
+   return result;
+} FC_LOG_AND_RETHROW() }
+
 fc::future<void> database::precompute_parallel( const precomputable_transaction& trx )const
 {
    return fc::do_parallel([this,&trx] () {
@@ -65,6 +65,19 @@ time_point_sec database::head_block_time()const
    return get_dynamic_global_properties().time;
 }
 
+const hardfork_state& database::hardforks()const
+{
+   const time_point_sec now = head_block_time();
+   if( _hardfork_state.head_block_time != now )
+      _hardfork_state.update( now );
+   return _hardfork_state;
+}
+
+uint64_t database::account_authority_revision()const
+{
+   return _p_account_authority_revision_idx->revision();
+}
+
 uint32_t database::head_block_num()const
 {
    return get_dynamic_global_properties().head_block_number;
@@ -117,6 +117,7 @@ void database::initialize_evaluators()
    register_evaluator<game_start_playing_check_evaluator>();
    register_evaluator<game_result_check_evaluator>();
    register_evaluator<game_reset_evaluator>();
+   register_evaluator<game_votes_check_evaluator>();
    register_evaluator<buy_in_table_evaluator>();
    register_evaluator<buy_out_table_evaluator>();
    register_evaluator<player_invitation_create_evaluator>();
@@ -127,6 +128,7 @@ void database::initialize_evaluators()
    register_evaluator<table_create_evaluator>();
    register_evaluator<table_update_evaluator>();
    register_evaluator<table_alive_evaluator>();
+   register_evaluator<room_alive_evaluator>();
    register_evaluator<player_create_by_room_owner_evaluator>();
    register_evaluator<buy_in_reserve_evaluator>();
    register_evaluator<buy_in_cancel_evaluator>();
@@ -151,6 +153,7 @@ void database::initialize_indexes()
    auto acnt_index = add_index< primary_index<account_index, 20> >(); // ~1 million accounts per chunk
    acnt_index->add_secondary_index<account_member_index>();
    acnt_index->add_secondary_index<account_referrer_index>();
+   _p_account_authority_revision_idx = acnt_index->add_secondary_index<account_authority_revision_index>();
 
    add_index< primary_index<committee_member_index, 8> >(); // 256 members per chunk
    add_index< primary_index<witness_index, 10> >(); // 1024 witnesses per chunk
@@ -205,11 +208,14 @@ void database::initialize_indexes()
    add_index< primary_index<pending_table_vote_index> >();
    add_index< primary_index<playchain_committee_member_index, 8> >();
    add_index< primary_index<table_alive_index> >();
+   add_index< primary_index<room_alive_index> >();
 }
 
 void database::init_genesis(const genesis_state_type& genesis_state)
 { try {
-   idump((genesis_state));
+   ilog( "Initializing genesis state with ${a} accounts, ${b} balances, ${v} vesting balances and ${w} witnesses",
+         ("a", genesis_state.initial_accounts.size())("b", genesis_state.initial_balances.size())
+         ("v", genesis_state.initial_vesting_balances.size())("w", genesis_state.initial_witness_candidates.size()) );
 
    FC_ASSERT( genesis_state.initial_timestamp != time_point_sec(), "Must initialize genesis timestamp." );
    FC_ASSERT( genesis_state.initial_timestamp.sec_since_epoch() % GRAPHENE_DEFAULT_BLOCK_INTERVAL == 0,
@@ -424,36 +430,115 @@ void database::init_genesis(const genesis_state_type& genesis_state)
 
    std::map<address, account_id_type> user_accounts_by_address;
 
-   // Create initial accounts
-   for( const auto& account : genesis_state.initial_accounts )
+   // Create initial accounts.
+   // The objects are inserted directly, with the same result as account_create_evaluator and
+   // account_upgrade_evaluator have, and the secondary indexes of the accounts are built at once.
+   if( _genesis_bulk_load )
    {
-      account_create_operation cop;
-      cop.name = account.name;
-      cop.registrar = GRAPHENE_TEMP_ACCOUNT;
-      cop.owner = authority(1, account.owner_key, 1);
-      if( account.active_key == public_key_type() )
-      {
-         cop.active = cop.owner;
-         cop.options.memo_key = account.owner_key;
-      }
-      else
+      const auto& params = get_global_properties().parameters;
+      const auto& accounts_by_name = get_index_type<account_index>().indices().get<by_name>();
+      const account_id_type referrer;
+      const account_id_type lifetime_referrer = referrer(*this).lifetime_referrer;
+      auto& accounts_idx = dynamic_cast<base_primary_index&>( get_mutable_index<account_object>() );
+
       {
-         cop.active = authority(1, account.active_key, 1);
-         cop.options.memo_key = account.active_key;
-      }
-      account_id_type account_id(apply_operation(genesis_eval_state, cop).get<object_id_type>());
+         deferred_secondary_indexes_scope deferred_indexes( accounts_idx );
+         for( const auto& account : genesis_state.initial_accounts )
+         {
+            FC_ASSERT( accounts_by_name.find( account.name ) == accounts_by_name.end(),
+                       "Account '${a}' already exists", ("a", account.name) );
+
+            const account_object& new_account = create<account_object>( [&]( account_object& a ) {
+               a.registrar = GRAPHENE_TEMP_ACCOUNT;
+               a.referrer = referrer;
+               a.lifetime_referrer = lifetime_referrer;
+               a.network_fee_percentage = params.network_percent_of_fee;
+               a.lifetime_referrer_fee_percentage = params.lifetime_referrer_percent_of_fee;
+               a.referrer_rewards_percentage = 0;
+
+               a.name = account.name;
+               a.owner = authority(1, account.owner_key, 1);
+               if( account.active_key == public_key_type() )
+               {
+                  a.active = a.owner;
+                  a.options.memo_key = account.owner_key;
+               }
+               else
+               {
+                  a.active = authority(1, account.active_key, 1);
+                  a.options.memo_key = account.active_key;
+               }
+               a.statistics = create<account_statistics_object>( [&a]( account_statistics_object& s ) {
+                  s.owner = a.id;
+                  s.name = a.name;
+                  s.is_voting = a.options.is_voting();
+               }).id;
+
+               if( account.is_lifetime_member )
+               {
+                  a.membership_expiration_date = time_point_sec::maximum();
+                  a.referrer = a.registrar = a.lifetime_referrer = a.get_id();
+                  a.lifetime_referrer_fee_percentage = GRAPHENE_100_PERCENT - a.network_fee_percentage;
+               }
+            });
 
-      if( account.is_lifetime_member )
+            if (account.active_key != public_key_type())
+            {
+                user_accounts_by_address.emplace(std::make_pair(address{account.active_key}, new_account.get_id()));
+            }
+         }
+      } // the secondary indexes of the accounts are built here, even if an account fails
+
+      // Account registration statistics and fee scaling, as if the accounts were created one by one
+      const uint32_t accounts_count = static_cast<uint32_t>( genesis_state.initial_accounts.size() );
+      const auto& dynamic_properties = get_dynamic_global_properties();
+      const uint32_t registered_before = dynamic_properties.accounts_registered_this_interval;
+      modify( dynamic_properties, [accounts_count]( dynamic_global_property_object& p ) {
+         p.accounts_registered_this_interval += accounts_count;
+      });
+      if( params.accounts_per_fee_scale != 0 && params.account_fee_scale_bitshifts != 0 )
       {
-          account_upgrade_operation op;
-          op.account_to_upgrade = account_id;
-          op.upgrade_to_lifetime_member = true;
-          apply_operation(genesis_eval_state, op);
+         const uint32_t fee_scales = ( registered_before + accounts_count ) / params.accounts_per_fee_scale
+                                     - registered_before / params.accounts_per_fee_scale;
+         if( fee_scales > 0 )
+            modify( get_global_properties(), [fee_scales]( global_property_object& p ) {
+               for( uint32_t i = 0; i < fee_scales; ++i )
+                  p.parameters.get_mutable_fees().get<account_create_operation>().basic_fee <<= p.parameters.account_fee_scale_bitshifts;
+            });
       }
-
-      if (account.active_key != public_key_type())
+   }
+   else
+   {
+      for( const auto& account : genesis_state.initial_accounts )
       {
-          user_accounts_by_address.emplace(std::make_pair(address{account.active_key}, account_id));
+         account_create_operation cop;
+         cop.name = account.name;
+         cop.registrar = GRAPHENE_TEMP_ACCOUNT;
+         cop.owner = authority(1, account.owner_key, 1);
+         if( account.active_key == public_key_type() )
+         {
+            cop.active = cop.owner;
+            cop.options.memo_key = account.owner_key;
+         }
+         else
+         {
+            cop.active = authority(1, account.active_key, 1);
+            cop.options.memo_key = account.active_key;
+         }
+         account_id_type account_id(apply_operation(genesis_eval_state, cop).get<object_id_type>());
+
+         if( account.is_lifetime_member )
+         {
+             account_upgrade_operation op;
+             op.account_to_upgrade = account_id;
+             op.upgrade_to_lifetime_member = true;
+             apply_operation(genesis_eval_state, op);
+         }
+
+         if (account.active_key != public_key_type())
+         {
+             user_accounts_by_address.emplace(std::make_pair(address{account.active_key}, account_id));
+         }
       }
    }
 
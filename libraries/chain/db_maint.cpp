@@ -138,7 +138,7 @@ void database::update_worker_votes()
    const auto& idx = get_index_type<worker_index>().indices().get<by_account>();
    auto itr = idx.begin();
    auto itr_end = idx.end();
-   bool allow_negative_votes = (head_block_time() < HARDFORK_607_TIME);
+   bool allow_negative_votes = (!hardforks().hf_607);
    while( itr != itr_end )
    {
       modify( *itr, [this,allow_negative_votes]( worker_object& obj )
@@ -252,7 +252,7 @@ void database::update_active_witnesses()
    // Update witness authority
    modify( get(GRAPHENE_WITNESS_ACCOUNT), [this,&wits]( account_object& a )
    {
-      if( head_block_time() < HARDFORK_533_TIME )
+      if( !hardforks().hf_533 )
       {
          uint64_t total_votes = 0;
          map<account_id_type, uint64_t> weights;
@@ -353,7 +353,7 @@ void database::update_active_committee_members()
       const account_object& committee_account = get(GRAPHENE_COMMITTEE_ACCOUNT);
       modify( committee_account, [this,&committee_members](account_object& a)
       {
-         if( head_block_time() < HARDFORK_533_TIME )
+         if( !hardforks().hf_533 )
          {
             uint64_t total_votes = 0;
             map<account_id_type, uint64_t> weights;
@@ -195,7 +195,11 @@ void database::open(
           version_file.close();
       }
 
-      object_database::open(data_dir);
+      {
+         // the strings of the loaded objects are interned in the table of this database
+         playchain::chain::interned_string_table::scope strings_scope( *_interned_strings );
+         object_database::open(data_dir);
+      }
 
       _block_id_to_block.open(data_dir / "database" / "block_num_to_block");
 
@@ -810,7 +810,7 @@ asset database::match( const call_order_object& call,
 bool database::fill_limit_order( const limit_order_object& order, const asset& pays, const asset& receives, bool cull_if_small,
                            const price& fill_price, const bool is_maker )
 { try {
-   cull_if_small |= (head_block_time() < HARDFORK_555_TIME);
+   cull_if_small |= (!hardforks().hf_555);
 
    FC_ASSERT( order.amount_for_sale().asset_id == pays.asset_id );
    FC_ASSERT( pays.asset_id != receives.asset_id );
@@ -818,7 +818,7 @@ bool database::fill_limit_order( const limit_order_object& order, const asset& p
    const account_object& seller = order.seller(*this);
    const asset_object& recv_asset = receives.asset_id(*this);
 
-   auto issuer_fees = ( head_block_time() < HARDFORK_1268_TIME ) ? 
+   auto issuer_fees = ( !hardforks().hf_1268 ) ? 
       pay_market_fees(recv_asset, receives) : 
       pay_market_fees(seller, recv_asset, receives);
 
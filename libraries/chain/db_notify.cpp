@@ -211,6 +211,8 @@ static void get_relevant_accounts(const object* obj, flat_set<account_id_type>&
             break;
         case impl_room_rating_measurement_object_type:
             break;
+        case impl_room_alive_object_type:
+            break;
         }
     }
 } // end get_relevant_accounts( const object* obj, flat_set<account_id_type>& accounts )
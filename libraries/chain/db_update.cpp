@@ -154,9 +154,21 @@ void database::clear_expired_transactions()
 void database::clear_expired_proposals()
 {
    const auto& proposal_expiration_index = get_index_type<proposal_index>().indices().get<by_expiration>();
-   while( !proposal_expiration_index.empty() && proposal_expiration_index.begin()->expiration_time <= head_block_time() )
+   const time_point_sec now = head_block_time();
+
+   // the expired proposals are collected at once, new proposals can't expire in the current block
+   vector<proposal_id_type> expired_proposals;
+   for( auto itr = proposal_expiration_index.begin();
+        itr != proposal_expiration_index.end() && itr->expiration_time <= now; ++itr )
+      expired_proposals.push_back( itr->id );
+
+   for( const proposal_id_type& id : expired_proposals )
    {
-      const proposal_object& proposal = *proposal_expiration_index.begin();
+      // the proposal could be executed or deleted by the proposals executed before it
+      const proposal_object* proposal_ptr = find( id );
+      if( proposal_ptr == nullptr )
+         continue;
+      const proposal_object& proposal = *proposal_ptr;
       processed_transaction result;
       try {
          if( proposal.is_authorized_to_execute(*this) )
@@ -24,6 +24,11 @@
 
 #include <graphene/chain/genesis_state.hpp>
 
+#include <fc/io/json.hpp>
+#include <fc/variant_object.hpp>
+
+#include <cctype>
+
 namespace graphene { namespace chain {
 
 chain_id_type genesis_state_type::compute_chain_id() const
@@ -31,4 +36,132 @@ chain_id_type genesis_state_type::compute_chain_id() const
    return initial_chain_id;
 }
 
+namespace {
+
+size_t skip_json_whitespace( const std::string& json, size_t pos )
+{
+   while( pos < json.size() && std::isspace( static_cast<unsigned char>( json[pos] ) ) )
+      ++pos;
+   return pos;
+}
+
+/// @return position right after the JSON value starting at pos
+size_t skip_json_value( const std::string& json, size_t pos )
+{
+   FC_ASSERT( pos < json.size(), "Unexpected end of genesis JSON" );
+   uint32_t depth = 0;
+   bool in_string = false;
+   for( ; pos < json.size(); ++pos )
+   {
+      const char c = json[pos];
+      if( in_string )
+      {
+         if( c == '\\' )
+            ++pos;
+         else if( c == '"' )
+         {
+            in_string = false;
+            if( depth == 0 )
+               return pos + 1;
+         }
+         continue;
+      }
+      switch( c )
+      {
+         case '"':
+            in_string = true;
+            break;
+         case '{':
+         case '[':
+            ++depth;
+            break;
+         case '}':
+         case ']':
+            if( depth == 0 )
+               return pos;
+            if( --depth == 0 )
+               return pos + 1;
+            break;
+         case ',':
+            if( depth == 0 )
+               return pos;
+            break;
+         default:
+            if( depth == 0 && std::isspace( static_cast<unsigned char>( c ) ) )
+               return pos;
+      }
+   }
+   FC_ASSERT( depth == 0 && !in_string, "Unexpected end of genesis JSON" );
+   return pos;
+}
+
+template<typename T>
+void parse_json_array( const std::string& json, size_t pos, std::vector<T>& result, uint32_t max_depth )
+{
+   FC_ASSERT( json[pos] == '[', "Array expected at ${pos} of genesis JSON", ("pos", pos) );
+   for( pos = skip_json_whitespace( json, pos + 1 ); pos < json.size() && json[pos] != ']';
+        pos = skip_json_whitespace( json, pos ) )
+   {
+      if( json[pos] == ',' )
+      {
+         ++pos;
+         continue;
+      }
+      const size_t end = skip_json_value( json, pos );
+      result.emplace_back( fc::json::from_string( json.substr( pos, end - pos ),
+                                                  fc::json::legacy_parser, max_depth ).as<T>( max_depth ) );
+      pos = end;
+   }
+}
+
+} // anonymous namespace
+
+genesis_state_type parse_genesis_state( const std::string& json, uint32_t max_depth )
+{ try {
+   FC_ASSERT( max_depth > 2 );
+
+   fc::mutable_variant_object members;
+   vector<genesis_state_type::initial_account_type> initial_accounts;
+   vector<genesis_state_type::initial_balance_type> initial_balances;
+   vector<genesis_state_type::initial_vesting_balance_type> initial_vesting_balances;
+
+   size_t pos = skip_json_whitespace( json, 0 );
+   FC_ASSERT( pos < json.size() && json[pos] == '{', "Genesis JSON must be an object" );
+   for( pos = skip_json_whitespace( json, pos + 1 ); pos < json.size() && json[pos] != '}';
+        pos = skip_json_whitespace( json, pos ) )
+   {
+      if( json[pos] == ',' )
+      {
+         ++pos;
+         continue;
+      }
+      size_t end = skip_json_value( json, pos );
+      const string key = fc::json::from_string( json.substr( pos, end - pos ) ).as_string();
+
+      pos = skip_json_whitespace( json, end );
+      FC_ASSERT( pos < json.size() && json[pos] == ':', "Colon expected after '${key}' in genesis JSON", ("key", key) );
+      pos = skip_json_whitespace( json, pos + 1 );
+      end = skip_json_value( json, pos );
+
+      if( key == "initial_accounts" )
+         parse_json_array( json, pos, initial_accounts, max_depth - 2 );
+      else if( key == "initial_balances" )
+         parse_json_array( json, pos, initial_balances, max_depth - 2 );
+      else if( key == "initial_vesting_balances" )
+         parse_json_array( json, pos, initial_vesting_balances, max_depth - 2 );
+      else
+         members( key, fc::json::from_string( json.substr( pos, end - pos ), fc::json::legacy_parser, max_depth - 1 ) );
+
+      pos = end;
+   }
+   FC_ASSERT( pos < json.size(), "Unexpected end of genesis JSON" );
+
+   genesis_state_type result;
+   fc::from_variant( fc::variant( std::move( members ) ), result, max_depth );
+   result.initial_accounts = std::move( initial_accounts );
+   result.initial_balances = std::move( initial_balances );
+   result.initial_vesting_balances = std::move( initial_vesting_balances );
+   return result;
+} FC_CAPTURE_AND_RETHROW() }
+
 } } // graphene::chain
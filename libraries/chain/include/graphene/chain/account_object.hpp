@@ -307,6 +307,7 @@ namespace graphene { namespace chain {
          virtual void about_to_modify( const object& before ) override;
          virtual void object_modified( const object& after  ) override;
 
+         virtual uint64_t get_memory_usage()const override;
 
          /** given an account or key, map it to the set of accounts that reference it in an active or owner authority */
          map< account_id_type, set<account_id_type> >                    account_to_account_memberships;
@@ -326,6 +327,27 @@ namespace graphene { namespace chain {
    };
 
 
+   /**
+    *  @brief This secondary index counts the changes of the owner and active authorities of the accounts.
+    *
+    *  The results of the authority checks made for a revision stay valid until the revision changes.
+    */
+   class account_authority_revision_index : public secondary_index
+   {
+      public:
+         virtual void object_inserted( const object& obj ) override;
+         virtual void object_removed( const object& obj ) override;
+         virtual void about_to_modify( const object& before ) override;
+         virtual void object_modified( const object& after  ) override;
+
+         uint64_t revision()const { return _revision; }
+
+      private:
+         uint64_t  _revision = 0;
+         authority _owner_before;
+         authority _active_before;
+   };
+
    /**
     *  @brief This secondary index will allow a reverse lookup of all accounts that have been referred by
     *  a particular account.
@@ -338,6 +360,8 @@ namespace graphene { namespace chain {
          virtual void about_to_modify( const object& before ) override;
          virtual void object_modified( const object& after  ) override;
 
+         virtual uint64_t get_memory_usage()const override;
+
          /** maps the referrer to the set of accounts that they have referred */
          map< account_id_type, set<account_id_type> > referred_by;
    };
@@ -354,6 +378,8 @@ namespace graphene { namespace chain {
          virtual void about_to_modify( const object& before ) override;
          virtual void object_modified( const object& after  ) override;
 
+         virtual uint64_t get_memory_usage()const override;
+
          const map< asset_id_type, const account_balance_object* >& get_account_balances( const account_id_type& acct )const;
          const account_balance_object* get_account_balance( const account_id_type& acct, const asset_id_type& asset )const;
 
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/chain/block_arena.hpp>
+#include <graphene/chain/protocol/operations.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace graphene { namespace chain {
+
+   /**
+    *  @brief real and virtual operations applied since the start of the block, in the order they occur
+    *
+    *  The log is append-only: an operation is moved into its entry once and stays in place, the entries
+    *  are kept in the pages of the fixed capacity, so the log never relocates them when it grows.
+    *  The pages are taken from the block arena and are dropped after the applied_block observers have
+    *  read the entries through the const views.
+    *
+    *  The operations of a failed proposal are marked as removed before HARDFORK_483, the history plugins
+    *  still count them when they number the operation history objects.
+    *
+    *  @see database::get_applied_operations()
+    */
+   class applied_operation_log
+   {
+   public:
+      static const size_t page_size = 256;
+
+      /// the fields are named as in operation_history_object
+      struct entry
+      {
+         explicit entry( operation&& o ): op( std::move( o ) ) {}
+
+         operation         op;
+         operation_result  result;
+         uint32_t          block_num    = 0;
+         uint16_t          trx_in_block = 0;
+         uint16_t          op_in_trx    = 0;
+         uint32_t          virtual_op   = 0;
+         bool              removed      = false;
+      };
+
+      class const_iterator
+      {
+      public:
+         typedef std::forward_iterator_tag iterator_category;
+         typedef entry                     value_type;
+         typedef std::ptrdiff_t            difference_type;
+         typedef const entry*              pointer;
+         typedef const entry&              reference;
+
+         const_iterator( const applied_operation_log& log, size_t index ): _log( &log ), _index( index ) {}
+
+         reference operator*()const  { return (*_log)[_index]; }
+         pointer   operator->()const { return &(*_log)[_index]; }
+
+         const_iterator& operator++()   { ++_index; return *this; }
+         const_iterator  operator++(int) { const_iterator result( *this ); ++_index; return result; }
+
+         bool operator==( const const_iterator& other )const { return _index == other._index; }
+         bool operator!=( const const_iterator& other )const { return _index != other._index; }
+
+      private:
+         const applied_operation_log* _log;
+         size_t                       _index;
+      };
+
+      explicit applied_operation_log( block_arena& arena ): _arena( arena ), _pages( arena ) {}
+
+      applied_operation_log( const applied_operation_log& ) = delete;
+      applied_operation_log& operator=( const applied_operation_log& ) = delete;
+
+      entry& append( operation&& op )
+      {
+         if( _pages.empty() || _pages.back().size() == page_size )
+         {
+            _pages.emplace_back( block_allocator<entry>( _arena ) );
+            _pages.back().reserve( page_size );
+         }
+         _pages.back().emplace_back( std::move( op ) );
+         return _pages.back().back();
+      }
+
+      /// drops the entries appended after the first size ones
+      void truncate( size_t size )
+      {
+         while( this->size() > size )
+         {
+            _pages.back().pop_back();
+            if( _pages.back().empty() )
+               _pages.pop_back();
+         }
+      }
+
+      void clear() { _pages.clear(); }
+
+      /// drops the entries and the pages, nothing refers to the arena afterwards
+      void release() { pages_type( _pages.get_allocator() ).swap( _pages ); }
+
+      entry&       operator[]( size_t index )      { return _pages[index / page_size][index % page_size]; }
+      const entry& operator[]( size_t index )const { return _pages[index / page_size][index % page_size]; }
+
+      size_t size()const  { return _pages.empty() ? 0 : ( _pages.size() - 1 ) * page_size + _pages.back().size(); }
+      bool   empty()const { return _pages.empty(); }
+
+      const_iterator begin()const { return const_iterator( *this, 0 ); }
+      const_iterator end()const   { return const_iterator( *this, size() ); }
+
+   private:
+      typedef block_vector< block_vector<entry> > pages_type;
+
+      block_arena& _arena;
+      pages_type   _pages;
+   };
+
+} } // graphene::chain
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <boost/container/flat_map.hpp>
+#include <boost/container/flat_set.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace graphene { namespace chain {
+
+   /**
+    *  @brief monotonic memory of the temporary containers used while a block is applied
+    *
+    *  The memory is taken from the chunks one after another and is not returned by the containers,
+    *  all of it is dropped by reset() after the block is applied and the changed objects are notified.
+    *  The chunks are merged into one on reset, so a block needs no heap allocations for the containers
+    *  once the arena has grown to the size of the previous blocks.
+    *
+    *  The containers using block_allocator must not outlive the block. The arena is used only inside
+    *  the scope opened by database::_apply_block, the allocations made elsewhere (the pending transactions,
+    *  the undo of the popped blocks) and the allocations of the disabled arena go to the global heap,
+    *  so they do not pile up in the chunks until the next reset.
+    *
+    *  @see database::get_block_arena()
+    */
+   class block_arena
+   {
+   public:
+      static const size_t default_chunk_size = 64 * 1024;
+
+      explicit block_arena( size_t chunk_size = default_chunk_size );
+      ~block_arena();
+
+      block_arena( const block_arena& ) = delete;
+      block_arena& operator=( const block_arena& ) = delete;
+
+      void* allocate( size_t bytes, size_t alignment );
+      void  deallocate( void* p, size_t bytes );
+
+      /// drops the memory taken since the previous reset, the enable() called meanwhile takes effect here
+      void reset();
+
+      void enable( bool enabled ) { _enabled_on_reset = enabled; }
+      bool enabled()const { return _enabled; }
+
+      /// the chunks are used while the scope is open
+      class scope
+      {
+      public:
+         explicit scope( block_arena& arena ): _arena( arena ), _was_active( arena._active )
+         {
+            _arena._active = true;
+         }
+         ~scope()
+         {
+            _arena._active = _was_active;
+         }
+
+         scope( const scope& ) = delete;
+         scope& operator=( const scope& ) = delete;
+
+      private:
+         block_arena& _arena;
+         bool         _was_active;
+      };
+
+      bool active()const { return _enabled && _active; }
+
+      /// number of the allocations requested by the containers
+      uint64_t allocations()const { return _allocations; }
+      /// number of the allocations made in the global heap for the chunks or by the disabled arena
+      uint64_t heap_allocations()const { return _heap_allocations; }
+      /// bytes taken from the chunks since the previous reset
+      size_t   used()const { return _used; }
+      size_t   capacity()const;
+
+   private:
+      struct chunk
+      {
+         char*  data;
+         size_t size;
+      };
+
+      void add_chunk( size_t min_size );
+      bool in_chunks( const void* p )const;
+
+      std::vector<chunk> _chunks;
+      size_t             _chunk_size;
+      /// offset of the free memory in the last chunk
+      size_t             _offset = 0;
+      size_t             _used = 0;
+      bool               _enabled = true;
+      bool               _enabled_on_reset = true;
+      bool               _active = false;
+      uint64_t           _allocations = 0;
+      uint64_t           _heap_allocations = 0;
+   };
+
+   /**
+    *  @brief standard allocator taking the memory from the block arena
+    */
+   template<typename T>
+   class block_allocator
+   {
+   public:
+      typedef T value_type;
+
+      block_allocator( block_arena& arena ): _arena( &arena ) {}
+
+      template<typename U>
+      block_allocator( const block_allocator<U>& other ): _arena( other.arena() ) {}
+
+      template<typename U>
+      struct rebind { typedef block_allocator<U> other; };
+
+      T* allocate( size_t n )
+      {
+         return static_cast<T*>( _arena->allocate( n * sizeof(T), alignof(T) ) );
+      }
+
+      void deallocate( T* p, size_t n )
+      {
+         _arena->deallocate( p, n * sizeof(T) );
+      }
+
+      block_arena* arena()const { return _arena; }
+
+      template<typename U>
+      bool operator==( const block_allocator<U>& other )const { return _arena == other.arena(); }
+      template<typename U>
+      bool operator!=( const block_allocator<U>& other )const { return _arena != other.arena(); }
+
+   private:
+      block_arena* _arena;
+   };
+
+   template<typename T>
+   using block_vector = std::vector<T, block_allocator<T>>;
+
+   template<typename T, typename Compare = std::less<T>>
+   using block_set = std::set<T, Compare, block_allocator<T>>;
+
+   template<typename T, typename Compare = std::less<T>>
+   using block_flat_set = boost::container::flat_set<T, Compare, block_allocator<T>>;
+
+   template<typename K, typename V, typename Compare = std::less<K>>
+   using block_flat_map = boost::container::flat_map<K, V, Compare, block_allocator<std::pair<K, V>>>;
+
+} } // graphene::chain
@@ -25,12 +25,36 @@
 #include <fstream>
 #include <graphene/chain/protocol/block.hpp>
 
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+
 namespace graphene { namespace chain {
    struct index_entry;
 
+   /**
+    *  Hit/miss counters and current occupancy of the in-memory caches
+    *  kept by @ref block_database in front of the on-disk block log.
+    */
+   struct block_cache_stats
+   {
+      uint64_t header_hits   = 0;
+      uint64_t header_misses = 0;
+      uint64_t block_hits    = 0;
+      uint64_t block_misses  = 0;
+
+      uint32_t cached_headers     = 0;
+      uint32_t cached_blocks      = 0;
+      uint64_t cached_block_bytes = 0;
+   };
+
    class block_database 
    {
       public:
+         /// Default number of recently used headers (and ids) kept in memory
+         static const uint32_t default_header_cache_size = 2048;
+
          void open( const fc::path& dbdir );
          bool is_open()const;
          void flush();
@@ -47,10 +71,79 @@ namespace graphene { namespace chain {
          optional<block_id_type> last_id()const;
          size_t                 blocks_current_position()const;
          size_t                 total_block_size()const;
+
+         /**
+          *  Returns the header of a block without unpacking its transactions.
+          *  Recently used headers are served from memory.
+          */
+         optional<signed_block_header> fetch_header_by_number( uint32_t block_num )const;
+
+         /**
+          *  @param max_headers number of recent block headers and ids kept in memory (0 disables the cache)
+          *  @param max_block_bytes memory budget for full cached blocks, in packed bytes (0 disables the cache)
+          */
+         void set_cache_limits( uint32_t max_headers, uint64_t max_block_bytes );
+         block_cache_stats get_cache_stats()const;
+         void clear_cache();
+
       private:
+         struct by_num;
+
+         struct header_cache_entry
+         {
+            uint32_t            block_num;
+            block_id_type       block_id;
+            signed_block_header header;
+         };
+
+         struct block_cache_entry
+         {
+            uint32_t     block_num;
+            block_id_type block_id;
+            signed_block block;
+            uint64_t     packed_size;
+         };
+
+         // LRU order: the front of the sequenced index is the most recently used entry
+         typedef boost::multi_index_container<
+            header_cache_entry,
+            boost::multi_index::indexed_by<
+               boost::multi_index::sequenced<>,
+               boost::multi_index::hashed_unique< boost::multi_index::tag<by_num>,
+                  boost::multi_index::member< header_cache_entry, uint32_t, &header_cache_entry::block_num > >
+            >
+         > header_cache_type;
+
+         typedef boost::multi_index_container<
+            block_cache_entry,
+            boost::multi_index::indexed_by<
+               boost::multi_index::sequenced<>,
+               boost::multi_index::hashed_unique< boost::multi_index::tag<by_num>,
+                  boost::multi_index::member< block_cache_entry, uint32_t, &block_cache_entry::block_num > >
+            >
+         > block_cache_type;
+
          optional<index_entry> last_index_entry()const;
+         optional<index_entry> read_index_entry( uint32_t block_num )const;
+
+         const header_cache_entry* find_cached_header( uint32_t block_num )const;
+         const block_cache_entry*  find_cached_block( uint32_t block_num )const;
+         void cache_header( const block_id_type& id, const signed_block_header& header )const;
+         void cache_block( const block_id_type& id, const signed_block& b, uint64_t packed_size )const;
+         void uncache( uint32_t block_num )const;
+
          fc::path _index_filename;
          mutable std::fstream _blocks;
          mutable std::fstream _block_num_to_pos;
+
+         uint32_t                  _max_cached_headers     = default_header_cache_size;
+         uint64_t                  _max_cached_block_bytes = 0;
+         mutable header_cache_type _header_cache;
+         mutable block_cache_type  _block_cache;
+         mutable block_cache_stats _cache_stats;
    };
 } }
+
+FC_REFLECT( graphene::chain::block_cache_stats,
+            (header_hits)(header_misses)(block_hits)(block_misses)
+            (cached_headers)(cached_blocks)(cached_block_bytes) )
@@ -30,6 +30,12 @@
 #include <graphene/chain/block_database.hpp>
 #include <graphene/chain/genesis_state.hpp>
 #include <graphene/chain/evaluator.hpp>
+#include <graphene/chain/hardfork_state.hpp>
+#include <graphene/chain/block_arena.hpp>
+#include <graphene/chain/applied_operation_log.hpp>
+#include <graphene/chain/worker_pool.hpp>
+
+#include <playchain/chain/schema/interned_string.hpp>
 
 #include <graphene/db/object_database.hpp>
 #include <graphene/db/object.hpp>
@@ -38,6 +44,8 @@
 
 #include <fc/log/logger.hpp>
 
+#include <atomic>
+#include <limits>
 #include <map>
 
 namespace playchain { namespace chain {
@@ -53,6 +61,10 @@ namespace graphene { namespace chain {
    struct budget_record;
    enum class vesting_balance_type;
 
+   namespace test {
+      struct pending_fees_hooks;
+   }
+
    /**
     *   @class database
     *   @brief tracks the blockchain state in an extensible manner
@@ -61,6 +73,9 @@ namespace graphene { namespace chain {
    {
       public:
          friend class playchain::chain::playchain_committee_applying_database_impl;
+         friend struct test::pending_fees_hooks;
+
+         typedef applied_operation_log applied_operations_type;
 
          //////////////////// db_management.cpp ////////////////////
 
@@ -127,9 +142,20 @@ namespace graphene { namespace chain {
          block_id_type              get_block_id_for_num( uint32_t block_num )const;
          optional<signed_block>     fetch_block_by_id( const block_id_type& id )const;
          optional<signed_block>     fetch_block_by_number( uint32_t num )const;
+         optional<signed_block_header> fetch_block_header_by_number( uint32_t num )const;
          const signed_transaction&  get_recent_transaction( const transaction_id_type& trx_id )const;
          std::vector<block_id_type> get_block_ids_on_fork(block_id_type head_of_fork) const;
 
+         /**
+          *  Configure the in-memory caches of recently used block headers and full blocks
+          *  kept in front of the block log on disk.
+          *
+          *  @param max_headers number of cached block headers (and ids)
+          *  @param max_block_bytes memory budget for cached full blocks, 0 to disable
+          */
+         void                       set_block_cache_limits( uint32_t max_headers, uint64_t max_block_bytes );
+         block_cache_stats          get_block_cache_stats()const;
+
          /**
           *  Calculate the percent of block production slots that were missed in the
           *  past 128 blocks, not including the current block.
@@ -160,6 +186,16 @@ namespace graphene { namespace chain {
             const fc::ecc::private_key& block_signing_private_key
             );
 
+         /**
+          *  Assembles the transactions of the next block of the witness in advance, so that generate_block()
+          *  only has to append the transactions received since, set the timestamp and sign the block.
+          *
+          *  The pending transactions are re-applied to the head block state as generate_block() would do.
+          *  The prepared block is dropped as soon as the pending state is rebuilt (e.g. by a new block).
+          */
+         void prepare_block( witness_id_type witness_id, uint32_t skip = skip_nothing );
+         void _prepare_block( witness_id_type witness_id );
+
          void pop_block();
          void clear_pending();
 
@@ -170,11 +206,43 @@ namespace graphene { namespace chain {
           *  applied operations is cleared after applying each block and calling the block
           *  observers which may want to index these operations.
           *
+          *  The operations are recorded only while there are consumers of get_applied_operations(),
+          *  otherwise they are just counted and no_applied_operation is returned. The consumers are
+          *  counted at the start of each block, so a block is recorded either entirely or not at all.
+          *
           *  @return the op_id which can be used to set the result after it has finished being applied.
           */
          uint32_t  push_applied_operation( const operation& op );
+         uint32_t  push_applied_operation( operation&& op );
          void      set_applied_operation_result( uint32_t op_id, const operation_result& r );
-         const vector<optional< operation_history_object > >& get_applied_operations()const;
+         /// asserts that the operations are recorded, the unregistered consumers would read an empty log
+         const applied_operations_type& get_applied_operations()const;
+
+         static const uint32_t no_applied_operation = std::numeric_limits<uint32_t>::max();
+
+         /**
+          *  Pushes the operation returned by make_op() as push_applied_operation() does, make_op() is not
+          *  called while nobody consumes the applied operations. Use it for the virtual operations that
+          *  copy strings or containers of the objects.
+          */
+         template<typename MakeOperation>
+         uint32_t  push_virtual_operation( MakeOperation&& make_op )
+         {
+            if( !_record_applied_operations )
+            {
+               ++_current_virtual_op;
+               return no_applied_operation;
+            }
+            return push_applied_operation( operation( make_op() ) );
+         }
+
+         /// The plugins reading get_applied_operations() on applied_block must be registered,
+         /// the change takes effect from the next block
+         void add_applied_operations_consumer()     { ++_applied_operations_consumers; }
+         void remove_applied_operations_consumer()  { --_applied_operations_consumers; }
+         bool applied_operations_consumed()const    { return _applied_operations_consumers > 0; }
+         /// whether the operations of the current block are recorded
+         bool applied_operations_recorded()const    { return _record_applied_operations; }
 
          string to_pretty_string( const asset& a )const;
 
@@ -269,6 +337,18 @@ namespace graphene { namespace chain {
          block_id_type    head_block_id()const;
          witness_id_type  head_block_witness()const;
 
+         /// hardforks in effect at head_block_time(), computed once per head block
+         const hardfork_state& hardforks()const;
+
+         /// changes every time the owner or active authority of an account changes
+         uint64_t account_authority_revision()const;
+
+         /// memory of the temporary containers of the block path, it is reset after every applied block
+         block_arena& get_block_arena()const { return _block_arena; }
+
+         /// symbol table of the strings interned by the objects of this database
+         playchain::chain::interned_string_table& interned_strings()const { return *_interned_strings; }
+
          decltype( chain_parameters::block_interval ) block_interval( )const;
 
          node_property_object& node_properties();
@@ -438,6 +518,22 @@ namespace graphene { namespace chain {
          /// Enable or disable tracking of votes of standby witnesses and committee members
          inline void enable_standby_votes_tracking(bool enable)  { _track_standby_votes = enable; }
 
+         /// Enable or disable verification of pending transactions in worker threads while generating blocks,
+         /// the threads are not shared with the networking, zero threads is the number of the hardware threads
+         void enable_parallel_block_building( bool enable, uint32_t num_threads = 0 );
+
+         /// Insert the initial accounts of the genesis directly (default) or by account_create operations
+         inline void enable_genesis_bulk_load(bool enable)  { _genesis_bulk_load = enable; }
+
+         /// Store pending fees of players once per destination from HARDFORK_PLAYCHAIN_14_TIME, the payouts are the same
+         inline bool pending_fees_aggregation() const  { return _aggregate_pending_fees; }
+
+         /// Deposit pending fees once per recipient from HARDFORK_PLAYCHAIN_15_TIME, the payouts are the same
+         inline bool pending_fees_accumulation() const  { return _accumulate_pending_fees; }
+
+         /// Enable or disable the block arena, takes effect after the next applied block
+         inline void enable_block_arena(bool enable)  { _block_arena.enable(enable); }
+
          /** Precomputes digests, signatures and operation validations depending
           *  on skip flags. "Expensive" computations may be done in a parallel
           *  thread.
@@ -461,6 +557,22 @@ namespace graphene { namespace chain {
          template<typename Trx>
          void _precompute_parallel( const Trx* trx, const size_t count, const uint32_t skip )const;
 
+         /** Verifies stateless properties, signatures and authorities of the pending transactions
+          *  in worker threads, against a snapshot of the account authorities of the head block state.
+          *  The calling thread is blocked until the workers finish, none of its other tasks can modify
+          *  the database while the pending state is popped.
+          *
+          * @return ids of the transactions whose authorities were verified
+          */
+         flat_set<transaction_id_type> _verify_pending_transactions_parallel()const;
+
+         /// Whether the transactions of _prepared_block are still the first ones of the pending state
+         bool _is_prepared_block_valid()const;
+         /// Starts an empty block of the witness on the current pending state
+         void _start_prepared_block( witness_id_type witness_id );
+         /// Appends the pending transactions pushed after the preparation while the block size allows
+         void _extend_prepared_block();
+
    protected:
          //Mark pop_undo() as protected -- we do not want outside calling pop_undo(); it should call pop_block() instead
          void pop_undo() { object_database::pop_undo(); }
@@ -548,13 +660,22 @@ namespace graphene { namespace chain {
           */
          block_database   _block_id_to_block;
 
+         /// Must be declared before the containers allocated in it
+         mutable block_arena               _block_arena;
+
+         std::shared_ptr<playchain::chain::interned_string_table> _interned_strings = playchain::chain::interned_string_table::create();
+
          /**
           * Contains the set of ops that are in the process of being applied from
           * the current block.  It contains real and virtual operations in the
           * order they occur and is cleared after the applied_block signal is
           * emited.
           */
-         vector<optional<operation_history_object> >  _applied_ops;
+         applied_operations_type           _applied_ops{ _block_arena };
+         /// may be changed by the API threads subscribing for the notifications
+         std::atomic<uint32_t>             _applied_operations_consumers{ 0 };
+         /// the consumers counted at the start of the current block
+         bool                              _record_applied_operations = false;
 
          uint32_t                          _current_block_num    = 0;
          uint16_t                          _current_trx_in_block = 0;
@@ -570,10 +691,30 @@ namespace graphene { namespace chain {
 
          node_property_object              _node_property_object;
 
+         /// cache of hardforks(), recomputed when the head block time changes
+         mutable hardfork_state            _hardfork_state;
+
          /// Whether to update votes of standby witnesses and committee members when performing chain maintenance.
          /// Set it to true to provide accurate data to API clients, set to false to have better performance.
          bool                              _track_standby_votes = true;
 
+         /// Whether to verify pending transactions in parallel before applying them in generated blocks.
+         bool                              _parallel_block_building = false;
+         std::unique_ptr<worker_pool>      _verification_pool;
+         bool                              _genesis_bulk_load = true;
+         /// Always on outside of the tests, which compare the payouts with the per-fee paths (test::pending_fees_hooks).
+         bool                              _aggregate_pending_fees = true;
+         bool                              _accumulate_pending_fees = true;
+
+         /// Incremented every time a new _pending_tx_session is started.
+         uint64_t                          _pending_tx_session_revision = 0;
+         /// Revision of the pending session the block was prepared on, 0 if there is no prepared block.
+         uint64_t                          _prepared_block_revision = 0;
+         /// The first pending transactions fitting the next block, see prepare_block().
+         signed_block                      _prepared_block;
+         size_t                            _prepared_block_size = 0;
+         bool                              _prepared_block_full = false;
+
          /**
           * Whether database is successfully opened or not.
           *
@@ -598,6 +739,8 @@ namespace graphene { namespace chain {
          const chain_property_object*           _p_chain_property_obj      = nullptr;
          const witness_schedule_object*         _p_witness_schedule_obj    = nullptr;
          ///@}
+
+         const account_authority_revision_index* _p_account_authority_revision_idx = nullptr;
    };
 
    namespace detail
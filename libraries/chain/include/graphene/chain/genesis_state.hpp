@@ -125,6 +125,14 @@ struct genesis_state_type {
    chain_id_type compute_chain_id() const;
 };
 
+/**
+ * Parse a genesis JSON document.
+ *
+ * The initial accounts and balances are parsed element by element straight into the genesis state,
+ * so a variant tree of the whole (possibly multi-million accounts) document is never built.
+ */
+genesis_state_type parse_genesis_state( const std::string& json, uint32_t max_depth );
+
 } } // namespace graphene::chain
 
 FC_REFLECT(graphene::chain::genesis_state_type::initial_account_type, (name)(owner_key)(active_key)(is_lifetime_member))
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/chain/hardfork.hpp>
+
+#include <fc/time.hpp>
+
+namespace graphene { namespace chain {
+
+   /**
+    *  @brief the hardforks in effect at a head block time
+    *
+    *  Every hardfork of hardfork.d has a flag named after its time, e.g. playchain_13 for
+    *  HARDFORK_PLAYCHAIN_13_TIME. A flag is set when head_block_time() >= HARDFORK_<NAME>_TIME,
+    *  so the flags replace the time comparisons of that form.
+    *
+    *  @see database::hardforks()
+    */
+   struct hardfork_state
+   {
+#define GRAPHENE_HARDFORK_STATE_FLAG( NAME, name ) bool name = false;
+      GRAPHENE_HARDFORKS( GRAPHENE_HARDFORK_STATE_FLAG )
+#undef GRAPHENE_HARDFORK_STATE_FLAG
+
+      /// the head block time the flags are computed for
+      fc::time_point_sec head_block_time = fc::time_point_sec::maximum();
+
+      void update( const fc::time_point_sec& now )
+      {
+#define GRAPHENE_HARDFORK_STATE_UPDATE( NAME, name ) name = ( now >= HARDFORK_ ## NAME ## _TIME );
+         GRAPHENE_HARDFORKS( GRAPHENE_HARDFORK_STATE_UPDATE )
+#undef GRAPHENE_HARDFORK_STATE_UPDATE
+         head_block_time = now;
+      }
+   };
+
+} } // graphene::chain
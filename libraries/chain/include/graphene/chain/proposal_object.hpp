@@ -55,6 +55,24 @@ class proposal_object : public abstract_object<proposal_object>
       std::string                   fail_reason;
 
       bool is_authorized_to_execute(database& db) const;
+
+      /// forgets the result of the last authority check, called when the approvals change
+      void reset_authorization_cache() const { _authorization_cache.reset(); }
+
+   private:
+      bool check_authorization(database& db, uint8_t max_authority_depth, bool allow_non_immediate_owner) const;
+
+      struct authorization_cache
+      {
+         /// revision of the account authorities the check was made for
+         uint64_t authority_revision = 0;
+         uint8_t  max_authority_depth = 0;
+         bool     allow_non_immediate_owner = false;
+         bool     authorized = false;
+      };
+
+      /// the result of the last authority check, it is not a part of the state so it is not reflected
+      mutable optional<authorization_cache> _authorization_cache;
 };
 
 /**
@@ -76,6 +94,8 @@ class required_approval_index : public secondary_index
       virtual void about_to_modify( const object& before ) override;
       virtual void object_modified( const object& after  ) override;
 
+      virtual uint64_t get_memory_usage()const override;
+
       map<account_id_type, set<proposal_id_type> > _account_to_proposals;
 
    private:
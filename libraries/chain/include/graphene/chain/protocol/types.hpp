@@ -67,6 +67,7 @@ namespace playchain { namespace chain {
     class pending_table_vote_object;
     class playchain_committee_member_object;
     class table_alive_object;
+    class room_alive_object;
 }}
 
 namespace graphene { namespace chain {
@@ -202,6 +203,7 @@ namespace graphene { namespace chain {
       impl_playchain_committee_member_object_type,
       impl_table_alive_object_type,
       impl_room_rating_measurement_object_type,
+      impl_room_alive_object_type,
    };
 
    //typedef fc::unsigned_int            object_id_type;
@@ -292,6 +294,7 @@ namespace graphene { namespace chain {
    typedef object_id< implementation_for_playchain_ids, impl_playchain_committee_member_object_type, playchain_committee_member_object> playchain_committee_member_id_type;
    typedef object_id< implementation_for_playchain_ids, impl_table_alive_object_type, table_alive_object>               table_alive_id_type;
    typedef object_id< implementation_for_playchain_ids, impl_room_rating_measurement_object_type, room_rating_measurement_object> room_rating_measurement_object_id_type;
+   typedef object_id< implementation_for_playchain_ids, impl_room_alive_object_type, room_alive_object>                 room_alive_id_type;
 
    typedef fc::array<char, GRAPHENE_MAX_ASSET_SYMBOL_LENGTH>    symbol_type;
    typedef fc::ripemd160                                        block_id_type;
@@ -477,6 +480,7 @@ FC_REFLECT_ENUM( graphene::chain::playchain_impl_object_type,
                  (impl_playchain_committee_member_object_type)
                  (impl_table_alive_object_type)
                  (impl_room_rating_measurement_object_type)
+                 (impl_room_alive_object_type)
                )
 
 FC_REFLECT_TYPENAME( graphene::chain::share_type )
@@ -524,6 +528,7 @@ FC_REFLECT_TYPENAME( graphene::chain::buy_in_id_type )
 FC_REFLECT_TYPENAME( graphene::chain::pending_table_vote_id_type )
 FC_REFLECT_TYPENAME( graphene::chain::playchain_committee_member_id_type )
 FC_REFLECT_TYPENAME( graphene::chain::table_alive_id_type )
+FC_REFLECT_TYPENAME( graphene::chain::room_alive_id_type )
 
 FC_REFLECT( graphene::chain::void_t, )
 
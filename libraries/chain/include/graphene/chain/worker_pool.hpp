@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace graphene { namespace chain {
+
+   /**
+    *  @brief threads running the CPU-heavy work of the chain thread
+    *
+    *  The pool is separate from the fc io_service threads, which run the p2p and RPC socket I/O, so a burst
+    *  of verification work does not stall the networking. The exception thrown by a task is passed to the
+    *  future returned by post().
+    */
+   class worker_pool
+   {
+   public:
+      /// zero threads is the number of the hardware threads
+      explicit worker_pool( uint32_t num_threads );
+      ~worker_pool();
+
+      worker_pool( const worker_pool& ) = delete;
+      worker_pool& operator=( const worker_pool& ) = delete;
+
+      uint32_t size()const { return static_cast<uint32_t>( _threads.size() ); }
+
+      std::future<void> post( std::function<void()> task );
+
+   private:
+      void run();
+
+      std::mutex                              _mutex;
+      std::condition_variable                 _ready;
+      std::deque< std::packaged_task<void()> > _tasks;
+      bool                                    _stopped = false;
+      std::vector<std::thread>                _threads;
+   };
+
+} } // graphene::chain
@@ -27,6 +27,8 @@
 #include <playchain/chain/protocol/playchain_types.hpp>
 #include <playchain/chain/schema/playchain_property_object.hpp>
 
+#include <graphene/chain/block_arena.hpp>
+
 #include <functional>
 #include <vector>
 
@@ -48,15 +50,11 @@ namespace playchain { namespace chain {
 
     const playchain_parameters  &get_playchain_parameters(const database& d);
 
-    //Use this helper to iterate probably removing objects (will call d.remove(o) or break index in some branch of complex logic)
-    //Note: This helper protect index but not protect object (double remove)
-    template<typename ObjectType, typename IteratorType>
-    auto get_objects_from_index(IteratorType &&from, IteratorType &&to, const size_t max_items,
-                                std::function<bool (const ObjectType &)> until_f = nullptr)
+    template<typename ResultType, typename ObjectType, typename IteratorType>
+    void collect_objects_from_index(ResultType &result, IteratorType &&from, IteratorType &&to, const size_t max_items,
+                                    const std::function<bool (const ObjectType &)> &until_f)
     {
         using object_type = ObjectType;
-        using object_reff_type = std::reference_wrapper<const object_type>;
-        std::vector<object_reff_type> result;
 
         if (max_items > 0)
         {
@@ -71,7 +69,26 @@ namespace playchain { namespace chain {
 
             result.emplace_back(std::cref(obj));
         }
+    }
 
+    //Use this helper to iterate probably removing objects (will call d.remove(o) or break index in some branch of complex logic)
+    //Note: This helper protect index but not protect object (double remove)
+    template<typename ObjectType, typename IteratorType>
+    auto get_objects_from_index(IteratorType &&from, IteratorType &&to, const size_t max_items,
+                                std::function<bool (const ObjectType &)> until_f = nullptr)
+    {
+        std::vector<std::reference_wrapper<const ObjectType>> result;
+        collect_objects_from_index(result, from, to, max_items, until_f);
+        return result;
+    }
+
+    //The same for the block tasks, the result is allocated in the block arena and must not outlive the block
+    template<typename ObjectType, typename IteratorType>
+    auto get_objects_from_index(block_arena &arena, IteratorType &&from, IteratorType &&to, const size_t max_items,
+                                std::function<bool (const ObjectType &)> until_f = nullptr)
+    {
+        block_vector<std::reference_wrapper<const ObjectType>> result(arena);
+        collect_objects_from_index(result, from, to, max_items, until_f);
         return result;
     }
 
@@ -71,6 +71,15 @@ namespace playchain { namespace chain {
         map<fc::time_point_sec, std::unique_ptr<impl_interface>> _impls;
     };
 
+    class game_votes_check_evaluator : public evaluator<game_votes_check_evaluator>
+    {
+    public:
+        using operation_type = game_votes_check_operation;
+
+        void_result do_evaluate( const operation_type& o );
+        operation_result do_apply( const operation_type& o );
+    };
+
     class game_reset_evaluator : public evaluator<game_reset_evaluator>
     {
     public:
@@ -59,5 +59,19 @@ namespace playchain { namespace chain {
           operation_result do_apply( const operation_type& o );
     };
 
+    class room_alive_evaluator : public evaluator<room_alive_evaluator>
+    {
+       public:
+          using operation_type = room_alive_operation;
+
+          void_result do_evaluate( const operation_type& o );
+          operation_result do_apply( const operation_type& o );
+    };
+
     operation_result alive_for_table(database& d, const table_id_type &);
+
+    operation_result alive_for_room(database& d, const room_id_type &);
+
+    /// Updates weights of the room tables those liveness is defined by the room heartbeat only
+    void update_weights_for_room_tables(database& d, const room_id_type &);
 }}
@@ -50,6 +50,8 @@ namespace playchain { namespace chain {
 
     bool is_table_alive(const database& d, const table_id_type &table);
 
+    bool is_room_alive(const database& d, const room_id_type &room);
+
     bool is_table_voting_for_playing(const database& d, const table_id_type &table);
 
     bool is_table_voting_for_results(const database& d, const table_id_type &table);
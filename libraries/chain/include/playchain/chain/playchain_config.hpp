@@ -44,6 +44,8 @@
 #define PLAYCHAIN_MAXIMUM_INVITATION_EXPIRATION_PERIOD fc::days(30)
 
 #define PLAYCHAIN_MAX_SIZE_FOR_RESULT_API_LIST    100
+///for pages of compact summaries
+#define PLAYCHAIN_MAX_SIZE_FOR_RESULT_API_PAGE    1000
 
 #define PLAYCHAIN_MAXIMUM_BUYOUT_REASON_SIZE      255
 
@@ -81,6 +83,7 @@
 #define PLAYCHAIN_DEFAULT_PERCENTAGE_OF_VOTER_WITNESS_SUBSTITUTION_WHILE_VOTING_FOR_RESULTS (50*GRAPHENE_1_PERCENT)
 
 #define PLAYCHAIN_MAX_SIZE_FOR_TABLES_ALIVE_PER_OP (100)
+#define PLAYCHAIN_MAX_SIZE_FOR_GAME_VOTES_PER_OP (100)
 
 namespace playchain { namespace protocol { namespace detail {
 
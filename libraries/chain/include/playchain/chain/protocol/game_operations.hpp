@@ -85,6 +85,41 @@ namespace playchain { namespace chain {
         }
     };
 
+    struct game_table_vote
+    {
+        account_id_type                             table_owner;
+
+        ///game_initial_data to start playing or game_result of the game
+        voting_data_type                            data;
+    };
+
+    /**
+     *  @brief Votes of a table owner or a game witness for many tables at once (from HARDFORK_PLAYCHAIN_13_TIME)
+     *
+     *  Each vote is checked and applied as game_start_playing_check_operation or
+     *  game_result_check_operation for its table. Invalid votes are rejected with
+     *  fail_vote event and do not affect votes for other tables.
+     */
+    struct game_votes_check_operation : public base_operation
+    {
+        struct fee_parameters_type {
+            uint64_t fee = 0;
+            uint32_t price_per_kbyte = 0;
+        };
+
+        asset                                       fee;
+        account_id_type                             voter;
+
+        flat_map<table_id_type, game_table_vote>    votes;
+
+        account_id_type   fee_payer()const { return voter; }
+        void              validate()const;
+        share_type        calculate_fee(const fee_parameters_type& k) const
+        {
+            return calculate_fee_with_kbyte(this, k);
+        }
+    };
+
     struct game_reset_operation : public base_operation
     {
         struct fee_parameters_type {
@@ -105,8 +140,11 @@ namespace playchain { namespace chain {
 
 FC_REFLECT( playchain::chain::game_start_playing_check_operation::fee_parameters_type, (fee)(price_per_kbyte))
 FC_REFLECT( playchain::chain::game_result_check_operation::fee_parameters_type, (fee)(price_per_kbyte))
+FC_REFLECT( playchain::chain::game_votes_check_operation::fee_parameters_type, (fee)(price_per_kbyte))
 FC_REFLECT( playchain::chain::game_reset_operation::fee_parameters_type, (fee))
 
 FC_REFLECT( playchain::chain::game_start_playing_check_operation, (fee)(table)(table_owner)(voter)(initial_data))
 FC_REFLECT( playchain::chain::game_result_check_operation, (fee)(table)(table_owner)(voter)(result))
+FC_REFLECT( playchain::chain::game_table_vote, (table_owner)(data))
+FC_REFLECT( playchain::chain::game_votes_check_operation, (fee)(voter)(votes))
 FC_REFLECT( playchain::chain::game_reset_operation, (fee)(table)(table_owner)(rollback_table))
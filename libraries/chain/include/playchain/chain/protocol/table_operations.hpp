@@ -88,12 +88,31 @@ namespace playchain { namespace chain {
         account_id_type   fee_payer()const { return owner; }
         void              validate()const;
     };
+
+    /**
+     *  @brief Heartbeat for all tables of the room at once (from HARDFORK_PLAYCHAIN_12_TIME)
+     */
+    struct room_alive_operation : public base_operation
+    {
+        struct fee_parameters_type {
+            uint64_t fee = 0;
+        };
+
+        asset                                       fee;
+        account_id_type                             owner;
+        room_id_type                                room;
+
+        account_id_type   fee_payer()const { return owner; }
+        void              validate()const;
+    };
 }}
 
 FC_REFLECT( playchain::chain::table_create_operation::fee_parameters_type, (fee)(price_per_kbyte))
 FC_REFLECT( playchain::chain::table_update_operation::fee_parameters_type, (fee)(price_per_kbyte))
 FC_REFLECT( playchain::chain::tables_alive_operation::fee_parameters_type, (fee))
+FC_REFLECT( playchain::chain::room_alive_operation::fee_parameters_type, (fee))
 
 FC_REFLECT( playchain::chain::table_create_operation, (fee)(owner)(room)(metadata)(required_witnesses)(min_accepted_proposal_asset))
 FC_REFLECT( playchain::chain::table_update_operation, (fee)(owner)(table)(metadata)(required_witnesses)(min_accepted_proposal_asset))
 FC_REFLECT( playchain::chain::tables_alive_operation, (fee)(owner)(tables))
+FC_REFLECT( playchain::chain::room_alive_operation, (fee)(owner)(room))
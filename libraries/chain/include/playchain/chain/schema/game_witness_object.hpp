@@ -30,6 +30,8 @@
 
 #include <playchain/chain/protocol/playchain_types.hpp>
 
+#include <boost/multi_index/hashed_index.hpp>
+
 namespace graphene { namespace chain {
     class database;
 }}
@@ -64,8 +66,9 @@ namespace playchain { namespace chain {
        game_witness_object,
        indexed_by<
           ordered_unique< tag<by_id>, member< object, object_id_type, &object::id > >,
-          ordered_unique< tag<by_playchain_account>,
-                        member<game_witness_object, account_id_type, &game_witness_object::account>
+          hashed_unique< tag<by_playchain_account>,
+                        member<game_witness_object, account_id_type, &game_witness_object::account>,
+                        std::hash<object_id_type>
        >
     >>;
 
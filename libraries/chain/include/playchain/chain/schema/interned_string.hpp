@@ -0,0 +1,265 @@
+/*
+* Copyright (c) 2018 Total Games LLC and contributors.
+*
+* The MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <fc/io/raw_fwd.hpp>
+#include <fc/optional.hpp>
+#include <fc/variant.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace playchain { namespace chain {
+
+    class interned_string_table;
+
+    /**
+     *  @brief Handle of a string kept once in the symbol table of the database.
+     *
+     *  Equal strings of a table share the handle, so they are compared as pointers. The handles are ordered
+     *  by the hash of the string and then by the string, so the order is the same on every node,
+     *  though it is not the order of the strings.
+     *
+     *  The symbols are reference counted: a string leaves the symbol table with the last handle, so
+     *  the strings of the deleted objects and of the rejected input do not stay in memory.
+     *  The handle is serialized as the string itself.
+     */
+    class interned_string
+    {
+    public:
+        struct symbol_data
+        {
+            symbol_data(uint64_t hash, std::shared_ptr<interned_string_table> table):
+                hash(hash),
+                table(std::move(table))
+            {
+            }
+
+            ///number of the handles
+            std::atomic<size_t>                     refs{0};
+            uint64_t                                hash = 0;
+            ///the symbols keep the table alive, so the handles may outlive the database, null for the empty string
+            std::shared_ptr<interned_string_table>  table;
+        };
+        using symbol = std::pair<const std::string, symbol_data>;
+
+        /// the empty string
+        interned_string();
+        /// the string interned in the current table, see interned_string_table::current()
+        explicit interned_string(const std::string &);
+
+        interned_string(const interned_string &other): _symbol(other._symbol)
+        {
+            acquire();
+        }
+        interned_string(interned_string &&other): _symbol(other._symbol)
+        {
+            other._symbol = empty_symbol();
+        }
+
+        ~interned_string()
+        {
+            release();
+        }
+
+        interned_string &operator=(const interned_string &other)
+        {
+            if (_symbol != other._symbol)
+            {
+                release();
+                _symbol = other._symbol;
+                acquire();
+            }
+            return *this;
+        }
+        interned_string &operator=(interned_string &&other)
+        {
+            std::swap(_symbol, other._symbol);
+            return *this;
+        }
+
+        /// interns the string in the current table, see interned_string_table::current()
+        interned_string &operator=(const std::string &);
+
+        const std::string &str() const
+        {
+            return _symbol->first;
+        }
+
+        operator const std::string &() const
+        {
+            return _symbol->first;
+        }
+
+        bool empty() const
+        {
+            return _symbol->first.empty();
+        }
+
+        /// the handles of different tables are compared by the strings
+        friend bool operator==(const interned_string &a, const interned_string &b)
+        {
+            return a._symbol == b._symbol ||
+                   (a._symbol->second.table != b._symbol->second.table && a.str() == b.str());
+        }
+        friend bool operator!=(const interned_string &a, const interned_string &b)
+        {
+            return !(a == b);
+        }
+        /// compares the hashes first, the strings only if the hashes are equal
+        friend bool operator<(const interned_string &a, const interned_string &b)
+        {
+            if (a._symbol == b._symbol)
+                return false;
+            if (a._symbol->second.hash != b._symbol->second.hash)
+                return a._symbol->second.hash < b._symbol->second.hash;
+            return a.str() < b.str();
+        }
+
+        friend bool operator==(const interned_string &a, const std::string &b)
+        {
+            return a.str() == b;
+        }
+        friend bool operator!=(const interned_string &a, const std::string &b)
+        {
+            return a.str() != b;
+        }
+        friend bool operator==(const std::string &a, const interned_string &b)
+        {
+            return a == b.str();
+        }
+        friend bool operator!=(const std::string &a, const interned_string &b)
+        {
+            return a != b.str();
+        }
+
+        friend std::ostream &operator<<(std::ostream &out, const interned_string &s)
+        {
+            return out << s.str();
+        }
+
+    private:
+        friend class interned_string_table;
+
+        /// takes the reference of the symbol which is already counted
+        explicit interned_string(symbol *s): _symbol(s) {}
+
+        static symbol *empty_symbol();
+
+        /// the empty string is never released, so it is not counted
+        void acquire()
+        {
+            if (_symbol != empty_symbol())
+                _symbol->second.refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        void release();
+
+        symbol *_symbol;
+    };
+
+    /**
+     *  @brief Symbol table of the interned strings of a database.
+     *
+     *  The objects of the database are interned in its table, the strings unpacked out of a database
+     *  (by the wallet, the tools) go to the table of the process.
+     */
+    class interned_string_table: public std::enable_shared_from_this<interned_string_table>
+    {
+    public:
+        static std::shared_ptr<interned_string_table> create();
+
+        interned_string intern(const std::string &);
+
+        /// @return the handle of the string if it is already interned, the lookup does not intern the string
+        fc::optional<interned_string> find(const std::string &);
+
+        /// number of the strings
+        size_t size() const;
+
+        /// the table of the scope opened on this thread, the table of the process if there is no scope
+        static interned_string_table &current();
+
+        /// makes the table current on this thread while the objects are unpacked
+        class scope
+        {
+        public:
+            explicit scope(interned_string_table &);
+            ~scope();
+
+            scope(const scope &) = delete;
+            scope &operator=(const scope &) = delete;
+
+        private:
+            interned_string_table *_previous;
+        };
+
+    private:
+        friend class interned_string;
+
+        interned_string_table() = default;
+
+        /// @return the symbol with the reference taken for the caller
+        interned_string::symbol *intern_symbol(const std::string &);
+        /// drops the last but maybe one reference of the symbol
+        void release(interned_string::symbol *);
+
+        mutable std::mutex                                                  _mutex;
+        /// the addresses of the nodes are stable
+        std::unordered_map<std::string, interned_string::symbol_data>      _symbols;
+    };
+}}
+
+namespace fc {
+    void to_variant(const playchain::chain::interned_string &s, fc::variant &var, uint32_t max_depth = 1);
+    void from_variant(const fc::variant &var, playchain::chain::interned_string &s, uint32_t max_depth = 1);
+
+    template<> struct get_typename<playchain::chain::interned_string> { static const char* name() {
+        return "playchain::chain::interned_string";
+    } };
+
+    namespace raw {
+
+    template<typename Stream>
+    void pack(Stream &s, const playchain::chain::interned_string &v, uint32_t _max_depth = FC_PACK_MAX_DEPTH)
+    {
+        fc::raw::pack(s, v.str(), _max_depth);
+    }
+
+    template<typename Stream>
+    void unpack(Stream &s, playchain::chain::interned_string &v, uint32_t _max_depth = FC_PACK_MAX_DEPTH)
+    {
+        std::string str;
+        fc::raw::unpack(s, str, _max_depth);
+        v = str;
+    }
+
+    } // fc::raw
+}
@@ -51,6 +51,7 @@ namespace playchain { namespace chain {
         account_id_type                     player;
         string                              uid;
         asset                               amount;
+        ///not interned: the buy-ins must not grow the symbol table with the metadata no table has
         string                              metadata;
         version_ext                         protocol_version;
         fc::time_point_sec                  created; //< for monitoring only
@@ -32,6 +32,7 @@
 #include <playchain/chain/protocol/playchain_types.hpp>
 
 #include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 
 #include <vector>
 
@@ -78,10 +79,20 @@ namespace playchain { namespace chain {
                                 const room_id_type &room,
                                 const game_witnesses_type &witnesses);
 
+        ///the fees with the same destination are disseminated the same way and can be summed up
+        bool is_same_destination(const player_pending_fee_data &other) const;
+
         room_id_type                        room;
         game_witnesses_type                 witnesses;
     };
 
+    ///rake of a single game with the index of its destination in player_object::pending_fees
+    struct player_pending_rake
+    {
+        uint32_t                            destination = 0;
+        share_type                          amount;
+    };
+
     class player_object : public graphene::db::abstract_object<player_object>
     {
     public:
@@ -108,6 +119,22 @@ namespace playchain { namespace chain {
          */
         fees_data_type                      pending_fees;
 
+        /**
+         * Rakes in the order they were taken while pending_fees are aggregated. Every rake is disseminated
+         * on its own, so the payouts do not differ from the separate pending fees.
+         *
+         * It still grows with the number of games until the maintenance and is copied by the undo
+         * of every modification, so the aggregation only shrinks the entry of a game, not their number.
+         */
+        std::vector<player_pending_rake>    pending_rakes;
+
+        /**
+         * Adds the amount to the pending fee with the same destination or appends the new one
+         * and records the rake. So pending_fees of an active player grow with the number of distinct
+         * tables played at, while pending_rakes grow with the number of games (from HARDFORK_PLAYCHAIN_14_TIME).
+         */
+        void aggregate_pending_fee(const player_pending_fee_data &);
+
         ///inviters inheritance remainder
         fees_by_rooms_type                  pending_parent_invitation_fees;
 
@@ -135,8 +162,9 @@ namespace playchain { namespace chain {
        player_object,
        indexed_by<
           ordered_unique< tag<by_id>, member< object, object_id_type, &object::id > >,
-          ordered_unique< tag<by_playchain_account>,
-                                member<player_object, account_id_type, &player_object::account>>,
+          hashed_unique< tag<by_playchain_account>,
+                                member<player_object, account_id_type, &player_object::account>,
+                                std::hash<object_id_type>>,
           ordered_unique< tag<by_inviter>,
                             composite_key<player_object,
                                     member<player_object, player_id_type, &player_object::inviter>,
@@ -164,11 +192,15 @@ FC_REFLECT( playchain::chain::deposit_statistic,
 FC_REFLECT_DERIVED( playchain::chain::player_pending_fee_data, (playchain::chain::deposit_statistic),
                     (room)
                     (witnesses))
+FC_REFLECT( playchain::chain::player_pending_rake,
+            (destination)
+            (amount))
 
 FC_REFLECT_DERIVED( playchain::chain::player_object,
                     (graphene::db::object),
                     (account)
                     (inviter)
                     (pending_fees)
+                    (pending_rakes)
                     (pending_parent_invitation_fees)
                     (balance))
@@ -29,6 +29,7 @@
 #include <graphene/db/generic_index.hpp>
 
 #include <playchain/chain/protocol/playchain_types.hpp>
+#include <playchain/chain/schema/interned_string.hpp>
 
 namespace graphene { namespace chain {
     class database;
@@ -48,7 +49,7 @@ namespace playchain { namespace chain {
         account_id_type                     owner;
 
         string                              server_url;
-        string                              metadata;
+        interned_string                     metadata;
         version_ext                         protocol_version;
         int32_t                             rating = 0;
         ///used for rating calculation
@@ -96,10 +97,11 @@ namespace playchain { namespace chain {
                     composite_key<room_object,
                         member<room_object, account_id_type, &room_object::owner>,
                         member<object, object_id_type, &object::id > >>,
+          //the metadata handles are ordered by the hashes of the strings (see interned_string)
           ordered_unique<tag<by_room_owner_and_metadata>,
                     composite_key<room_object,
                         member<room_object, account_id_type, &room_object::owner>,
-                        member<room_object, string, &room_object::metadata > >>,
+                        member<room_object, interned_string, &room_object::metadata > >>,
           ordered_unique<tag<by_last_rating_update>,
                      composite_key<room_object,
                           member<room_object, fc::time_point_sec, &room_object::last_rating_update>,
@@ -115,6 +117,41 @@ namespace playchain { namespace chain {
     >>;
 
     using room_index = generic_index<room_object, room_multi_index_type>;
+
+    /**
+     *  @brief Heartbeat of the room. While it exists all tables of the room are alive.
+     */
+    class room_alive_object : public graphene::db::abstract_object<room_alive_object>
+    {
+    public:
+        static constexpr uint8_t space_id = implementation_for_playchain_ids;
+        static constexpr uint8_t type_id  = impl_room_alive_object_type;
+
+        room_id_type                        room;
+        fc::time_point_sec                  created; //< for monitoring only
+        fc::time_point_sec                  expiration;
+    };
+
+    struct by_room;
+    struct by_room_alive_expiration;
+
+    /**
+     * @ingroup object_index
+     */
+    using room_alive_multi_index_type =
+    multi_index_container<
+       room_alive_object,
+       indexed_by<
+          ordered_unique< tag<by_id>, member< object, object_id_type, &object::id > >,
+          ordered_unique< tag<by_room>,
+                    member<room_alive_object, room_id_type, &room_alive_object::room> >,
+          ordered_unique<tag<by_room_alive_expiration>,
+                    composite_key<room_alive_object,
+                    member<room_alive_object, time_point_sec, &room_alive_object::expiration>,
+                    member<object, object_id_type, &object::id > >>
+    >>;
+
+    using room_alive_index = generic_index<room_alive_object, room_alive_multi_index_type>;
 }}
 
 FC_REFLECT_DERIVED( playchain::chain::room_object,
@@ -132,3 +169,9 @@ FC_REFLECT_DERIVED( playchain::chain::room_object,
                     (measurement_quantity)
                     (pending_rake)
                     (balance))
+
+FC_REFLECT_DERIVED( playchain::chain::room_alive_object,
+                    (graphene::db::object),
+                    (room)
+                    (created)
+                    (expiration))
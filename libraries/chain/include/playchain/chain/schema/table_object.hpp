@@ -32,6 +32,14 @@
 
 #include <playchain/chain/protocol/playchain_types.hpp>
 #include <playchain/chain/protocol/game_operations.hpp>
+#include <playchain/chain/schema/interned_string.hpp>
+
+#include <graphene/chain/block_arena.hpp>
+
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 106600 // boost ver. >= 1.66.0
+#include <boost/container/small_vector.hpp>
+#endif
 
 #include <set>
 
@@ -44,6 +52,18 @@ namespace playchain { namespace chain {
     using namespace graphene::chain;
     using namespace graphene::db;
 
+    /// number of players kept inside of the table object, the players above it are kept on the heap
+    static constexpr size_t table_inline_seats = 6;
+
+#if BOOST_VERSION >= 106600
+    template<typename V>
+    using table_seats_type = boost::container::flat_map<player_id_type, V, std::less<player_id_type>,
+                                                        boost::container::small_vector<std::pair<player_id_type, V>, table_inline_seats>>;
+#else
+    template<typename V>
+    using table_seats_type = flat_map<player_id_type, V>;
+#endif
+
     class table_object : public graphene::db::abstract_object<table_object>
     {
     public:
@@ -52,18 +72,18 @@ namespace playchain { namespace chain {
 
         room_id_type                                room;
 
-        string                                      metadata;
+        interned_string                             metadata;
 
         amount_type                                 required_witnesses = 0u;
 
         asset                                       min_accepted_proposal_asset;
 
-        using pending_buy_in_type = flat_map<player_id_type, pending_buy_in_id_type>;
+        using pending_buy_in_type = table_seats_type<pending_buy_in_id_type>;
 
         ///buy-in cash that has just allocated
         pending_buy_in_type                         pending_proposals;
 
-        using cash_data_type = flat_map<player_id_type, asset>;
+        using cash_data_type = table_seats_type<asset>;
 
         ///the cash indexed by players that used for buy-in/buy-out
         cash_data_type                              cash;
@@ -195,6 +215,8 @@ namespace playchain { namespace chain {
           virtual void object_inserted( const object& obj ) override;
           virtual void object_removed( const object& obj ) override;
 
+          virtual uint64_t get_memory_usage()const override;
+
           using tables_type = flat_set<table_id_type>;
 
           flat_map< account_id_type, tables_type > tables_by_owner;
@@ -217,6 +239,8 @@ namespace playchain { namespace chain {
           virtual void about_to_modify( const object& before );
           virtual void object_modified( const object& after  );
 
+          virtual uint64_t get_memory_usage()const override;
+
           using tables_type = std::set<table_id_type>;
 
           flat_map< player_id_type, tables_type > tables_with_pending_proposals_by_player;
@@ -225,15 +249,18 @@ namespace playchain { namespace chain {
 
         private:
 
-          using player_set_type = std::set<player_id_type>;
+          using players_type = std::vector<player_id_type>;
 
-          player_set_type  get_pending_proposals( const table_object& )const;
-          player_set_type  get_cash( const table_object& )const;
-          player_set_type  get_playing_cash( const table_object& )const;
+          static void update_tables_by_player( block_arena &arena,
+                                               flat_map< player_id_type, tables_type > &tables_by_player,
+                                               const players_type &before,
+                                               const block_vector<player_id_type> &after,
+                                               const table_id_type &table );
 
-          player_set_type                         before_pending_proposals;
-          player_set_type                         before_cash;
-          player_set_type                         before_playing_cash;
+          ///sorted players of the table being modified
+          players_type                            before_pending_proposals;
+          players_type                            before_cash;
+          players_type                            before_playing_cash;
 
           const database& _db;
     };
@@ -250,6 +277,8 @@ namespace playchain { namespace chain {
             virtual void object_inserted( const object& obj );
             virtual void object_removed( const object& obj );
 
+            virtual uint64_t get_memory_usage()const override;
+
             using accounts_type = std::vector<account_id_type>;
 
             flat_map< table_id_type, accounts_type > voted_last_time_players_by_table;
@@ -275,10 +304,11 @@ namespace playchain { namespace chain {
                     composite_key<table_object,
                     member<table_object, room_id_type, &table_object::room>,
                     member<object, object_id_type, &object::id > >>,
+          //the metadata handles are ordered by the hashes of the strings (see interned_string)
           ordered_non_unique<tag<by_room_and_metadata>,
                     composite_key<table_object,
                     member<table_object, room_id_type, &table_object::room>,
-                    member<table_object, string, &table_object::metadata > >>,
+                    member<table_object, interned_string, &table_object::metadata > >>,
           ordered_unique<tag<by_playchain_obj_expiration>,
                     composite_key<table_object,
                     member<table_object, time_point_sec, &table_object::game_expiration>,
@@ -286,8 +316,8 @@ namespace playchain { namespace chain {
           ordered_unique<tag<by_table_choose_algorithm>,
                          composite_key<table_object,
                                 member<table_object,
-                                       string,
-                                       &table_object::metadata>, //first by metadata
+                                       interned_string,
+                                       &table_object::metadata>, //first by metadata, the ranges keep it fixed
                                 member<table_object,
                                        uint32_t,
                                        &table_object::occupied_places>, //first with greater free places
@@ -297,7 +327,7 @@ namespace playchain { namespace chain {
                                 member<object,
                                        object_id_type,
                                        &object::id>>, //unique
-                         composite_key_compare<std::less<string>,
+                         composite_key_compare<std::less<interned_string>,
                                                std::less<uint32_t>,
                                                std::greater<int32_t>,
                                                std::less<object_id_type>>>
@@ -79,7 +79,7 @@ void process_block_tasks(database &d, const bool maintenance)
 #endif
 
     update_expired_invitations(d);
-    if (d.head_block_time() < HARDFORK_PLAYCHAIN_9_TIME)
+    if (!d.hardforks().playchain_9)
     {
         update_expired_table_voting(d);
         update_expired_table_game(d, maintenance);
@@ -95,6 +95,7 @@ void process_block_tasks(database &d, const bool maintenance)
         update_expired_pending_buy_in(d);
         update_expired_buy_in(d);
         update_expired_table_alive(d);
+        update_expired_room_alive(d);
     }
 
     allocation_of_vacancies(d);
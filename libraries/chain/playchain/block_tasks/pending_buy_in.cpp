@@ -60,8 +60,12 @@ namespace
 
         const auto &room = table.room(d);
 
-        d.push_applied_operation( buy_in_reserving_allocated_table_operation{ buy_in.player, buy_in.uid, buy_in.amount,
-                                                           buy_in.metadata, table.id, room.owner, table.weight, room.rating} );
+        //the virtual operations copy the strings of the buy-in, they are made only if somebody reads them
+        d.push_virtual_operation([&]()
+        {
+            return buy_in_reserving_allocated_table_operation{ buy_in.player, buy_in.uid, buy_in.amount,
+                                                               buy_in.metadata, table.id, room.owner, table.weight, room.rating};
+        });
         d.modify(buy_in, [&](pending_buy_in_object &obj)
         {
             obj.table = table.id;
@@ -71,8 +75,8 @@ namespace
             obj.created = d.head_block_time();
             obj.expiration = obj.created + get_playchain_parameters(d).room_rating_measurements_alive_periods * d.get_global_properties().parameters.maintenance_interval;
             obj.associated_buyin = buy_in.id;
-            obj.table = buy_in.table;
-            obj.room = buy_in.table(d).room;
+            obj.table = table.id;
+            obj.room = table.room;
             obj.weight = 0;
             obj.waiting_resolve = true;
         });
@@ -85,12 +89,16 @@ namespace
     {
         if (PLAYCHAIN_NULL_TABLE != buy_in.table)
         {
-            d.push_applied_operation( buy_in_reserving_expire_operation{ buy_in.player,
-                                                      buy_in.uid, buy_in.amount,
-                                                      buy_in.metadata,
-                                                      expire_by_replacement,
-                                                      buy_in.table,
-                                                      buy_in.table(d).room(d).owner} );
+            const account_id_type table_owner = buy_in.table(d).room(d).owner;
+            d.push_virtual_operation([&]()
+            {
+                return buy_in_reserving_expire_operation{ buy_in.player,
+                                                          buy_in.uid, buy_in.amount,
+                                                          buy_in.metadata,
+                                                          expire_by_replacement,
+                                                          buy_in.table,
+                                                          table_owner};
+            });
 
             auto& measurements_by_buyin = d.get_index_type<room_rating_measurement_index>().indices().get<by_pending_buy_in>();
             auto it = measurements_by_buyin.find(buy_in.id);
@@ -109,10 +117,13 @@ namespace
         }
         else
         {
-            d.push_applied_operation( buy_in_reserving_expire_operation{ buy_in.player,
-                                                      buy_in.uid, buy_in.amount,
-                                                      buy_in.metadata,
-                                                      expire_by_replacement} );
+            d.push_virtual_operation([&]()
+            {
+                return buy_in_reserving_expire_operation{ buy_in.player,
+                                                          buy_in.uid, buy_in.amount,
+                                                          buy_in.metadata,
+                                                          expire_by_replacement};
+            });
         }
     }
 
@@ -157,7 +168,7 @@ void update_expired_pending_buy_in(database &d)
 
 template <typename Index>
 auto create_range_v1(const Index& index,
-              const string& search_meta,
+              const interned_string& search_meta,
               const uint32_t min_occupied_places,
               const uint32_t max_occupied_places,
               const int32_t min_allowed_table_weight_to_be_allocated)
@@ -173,7 +184,7 @@ auto create_range_v1(const Index& index,
 
 template <typename Index>
 auto create_range_v2(const Index& index,
-              const string& search_meta,
+              const interned_string& search_meta,
               const uint32_t min_occupied_places,
               const uint32_t max_occupied_places,
               const int32_t /*min_allowed_table_weight_to_be_allocated*/)
@@ -185,12 +196,12 @@ auto create_range_v2(const Index& index,
 template <typename Index>
 auto create_range(const database &d,
                   const Index& index,
-                  const string& search_meta,
+                  const interned_string& search_meta,
                   const uint32_t min_occupied_places,
                   const uint32_t max_occupied_places,
                   const int32_t min_allowed_table_weight_to_be_allocated)
 {
-    if (d.head_block_time() >= HARDFORK_PLAYCHAIN_4_TIME)
+    if (d.hardforks().playchain_4)
     {
         return create_range_v2(index, search_meta, min_occupied_places, max_occupied_places, min_allowed_table_weight_to_be_allocated);
     }else
@@ -202,7 +213,7 @@ auto create_range(const database &d,
 template<typename Range>
 bool find_in_range(const Range &range, database &d, const pending_buy_in_object &buy_in,
                    const int32_t min_allowed_table_weight_to_be_allocated,
-                   flat_set<pending_buy_in_id_type> &prev_proposals)
+                   block_flat_set<pending_buy_in_id_type> &prev_proposals)
 {
     auto itr = range.first;
 
@@ -216,14 +227,16 @@ bool find_in_range(const Range &range, database &d, const pending_buy_in_object
             continue;
         }
 
+        const auto &room = table.room(d);
+
         // if versions do not match by algorithm (maj.min.XXXX)
-        if (table.room(d).protocol_version != buy_in.protocol_version)
+        if (room.protocol_version != buy_in.protocol_version)
         {
             continue;
         }
 
         // if player is table owner
-        if (table.room(d).owner == buy_in.player)
+        if (room.owner == buy_in.player)
         {
             continue;
         }
@@ -258,7 +271,7 @@ void allocation_of_vacancies(database &d)
     auto& by_expiration= d.get_index_type<pending_buy_in_index>().indices().get<by_pending_buy_in_allocation_status_and_expiration>();
     auto itr_buy_in = by_expiration.begin();
     size_t ci = 0;
-    flat_set<pending_buy_in_id_type> prev_proposals;
+    block_flat_set<pending_buy_in_id_type> prev_proposals(d.get_block_arena());
     while( itr_buy_in != by_expiration.end() &&
            !itr_buy_in->is_allocated() &&
            itr_buy_in->expiration > d.head_block_time() &&
@@ -269,8 +282,12 @@ void allocation_of_vacancies(database &d)
         if (buy_in.id == PLAYCHAIN_NULL_PENDING_BUYIN)
             continue;
 
-        const auto& tables_by_free_places = d.get_index_type<table_index>().indices().get<by_table_choose_algorithm>();
+        // no table has the metadata that has never been interned
+        auto search_meta = d.interned_strings().find(buy_in.metadata);
+        if (!search_meta.valid())
+            continue;
 
+        const auto& tables_by_free_places = d.get_index_type<table_index>().indices().get<by_table_choose_algorithm>();
 
         bool lookup_out_range = false;
         bool last_loop = false;
@@ -282,7 +299,7 @@ void allocation_of_vacancies(database &d)
 
             if (!lookup_out_range)
             {
-                auto range = create_range(d, tables_by_free_places, buy_in.metadata,
+                auto range = create_range(d, tables_by_free_places, *search_meta,
                                           reachable_minimum,
                                           reachable_maximum, parameters.min_allowed_table_weight_to_be_allocated);
                 print_tables_range(range.first, range.second, "first");
@@ -301,7 +318,7 @@ void allocation_of_vacancies(database &d)
                 last_loop = true;
             }
 
-            auto range = create_range(d, tables_by_free_places, buy_in.metadata,
+            auto range = create_range(d, tables_by_free_places, *search_meta,
                                  reachable_minimum,
                                  reachable_maximum, parameters.min_allowed_table_weight_to_be_allocated);
             print_tables_range(range.first, range.second);
@@ -325,7 +342,7 @@ void allocation_of_vacancies(database &d)
 void update_expired_buy_in(database &d)
 {
     auto& by_expiration= d.get_index_type<buy_in_index>().indices().get<by_playchain_obj_expiration>();
-    auto buy_ins = get_objects_from_index<buy_in_object>(by_expiration.begin(), by_expiration.end(),
+    auto buy_ins = get_objects_from_index<buy_in_object>(d.get_block_arena(), by_expiration.begin(), by_expiration.end(),
                                                         0, [&](const auto &buy_in)
     {
         return buy_in.expiration <= d.head_block_time();
@@ -25,11 +25,13 @@
 #include "table_check.hpp"
 
 #include <graphene/chain/database.hpp>
+#include <graphene/chain/hardfork.hpp>
 
 #include <playchain/chain/schema/table_object.hpp>
 #include <playchain/chain/schema/room_object.hpp>
 
 #include <playchain/chain/evaluators/game_evaluators.hpp>
+#include <playchain/chain/evaluators/table_evaluators.hpp>
 #include <playchain/chain/evaluators/db_helpers.hpp>
 #include <playchain/chain/evaluators/validators.hpp>
 
@@ -38,7 +40,7 @@ namespace playchain { namespace chain {
 void update_expired_table_voting(database &d)
 {
     auto& voting_by_expiration= d.get_index_type<table_voting_index>().indices().get<by_voting_expiration>();
-    auto votings = get_objects_from_index<table_voting_object>(voting_by_expiration.begin(), voting_by_expiration.end(),
+    auto votings = get_objects_from_index<table_voting_object>(d.get_block_arena(), voting_by_expiration.begin(), voting_by_expiration.end(),
                                                         0, [&](const auto &voting)
     {
         return voting.expiration <= d.head_block_time();
@@ -67,14 +69,17 @@ void update_expired_table_game(database &d, const bool maintenance)
         return;
 
     auto& game_by_expiration= d.get_index_type<table_index>().indices().get<by_playchain_obj_expiration>();
-    auto tables = get_objects_from_index<table_object>(game_by_expiration.begin(), game_by_expiration.end(),
+    auto tables = get_objects_from_index<table_object>(d.get_block_arena(), game_by_expiration.begin(), game_by_expiration.end(),
                                                         0, [&](const auto &table)
     {
         return table.game_expiration <= d.head_block_time();
     });
     for (const table_object& table: tables) {
-        d.push_applied_operation(
-                    game_event_operation{ table.id, table.room(d).owner, fail_expire_game_lifetime{} } );
+        const account_id_type table_owner = table.room(d).owner;
+        d.push_virtual_operation([&]()
+        {
+            return game_event_operation{ table.id, table_owner, fail_expire_game_lifetime{} };
+        });
 
         rollback_table(d, table);
     }
@@ -93,14 +98,30 @@ void update_expired_table_alive(database &d)
 
         d.remove(alive);
 
-        table.set_weight(d);
+        if (!d.hardforks().playchain_12 || !is_table_alive(d, table.id))
+            table.set_weight(d);
+    }
+}
+
+void update_expired_room_alive(database &d)
+{
+    auto& alive_by_expiration= d.get_index_type<room_alive_index>().indices().get<by_room_alive_expiration>();
+    while( !alive_by_expiration.empty() && alive_by_expiration.begin()->expiration <= d.head_block_time() )
+    {
+        const room_alive_object &alive = *alive_by_expiration.begin();
+
+        room_id_type room = alive.room;
+
+        d.remove(alive);
+
+        update_weights_for_room_tables(d, room);
     }
 }
 
 void update_scheduled_voting(database &d)
 {
     auto& voting_by_scheduled= d.get_index_type<table_voting_index>().indices().get<by_voting_scheduled>();
-    auto votings = get_objects_from_index<table_voting_object>(voting_by_scheduled.begin(), voting_by_scheduled.end(),
+    auto votings = get_objects_from_index<table_voting_object>(d.get_block_arena(), voting_by_scheduled.begin(), voting_by_scheduled.end(),
                                                         0, [&](const auto &voting)
     {
         return voting.scheduled_voting <= d.head_block_time();
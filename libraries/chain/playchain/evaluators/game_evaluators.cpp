@@ -129,7 +129,7 @@ namespace playchain{ namespace chain{
             idump((table));
         }
 #endif
-        if (d.head_block_time() >= HARDFORK_PLAYCHAIN_9_TIME)
+        if (d.hardforks().playchain_9)
         {
             bool any_invalid = false;
             decltype(table_voting.votes) valid_votes;
@@ -249,6 +249,32 @@ namespace playchain{ namespace chain{
         return find_implementation<impl_interface>(db(), _impls).do_apply(op);
     }
 
+    void_result game_votes_check_evaluator::do_evaluate( const operation_type& op )
+    {
+        try {
+            const database& d = db();
+            FC_ASSERT(d.hardforks().playchain_13, "Batched votes are not allowed before HARDFORK_PLAYCHAIN_13_TIME");
+
+            return void_result();
+        }FC_CAPTURE_AND_RETHROW((op))
+    }
+
+    operation_result game_votes_check_evaluator::do_apply( const operation_type& op )
+    {
+        try {
+            database& d = db();
+
+            //votes are ordered by table, so every table is visited once,
+            //the rejected tables are reported by fail_vote events
+            for (const auto &vote: op.votes)
+            {
+                apply_table_vote(d, op.voter, vote.first, vote.second);
+            }
+
+            return void_result();
+        }FC_CAPTURE_AND_RETHROW((op))
+    }
+
     void_result game_reset_evaluator::do_evaluate( const operation_type& op )
     {
         try {
@@ -272,7 +298,7 @@ namespace playchain{ namespace chain{
             else
                 rollback_table(d, table);
 
-            if (d.head_block_time() < HARDFORK_PLAYCHAIN_10_TIME)
+            if (!d.hardforks().playchain_10)
             {
                 cleanup_voting(d, table.id);
             }
@@ -102,19 +102,24 @@ struct get_game_digest_visitor
     }
 };
 
-bool voting_impl(const table_voting_object &table_voting,
+bool voting_impl(block_arena &arena,
+            const table_voting_object &table_voting,
             const percent_type requied,
             voting_data_type &valid_vote,
             account_votes_type &accounts_with_invalid_vote)
 {
-    flat_map<game_digest_type, account_votes_type> votes_by_content;
+    using content_votes_type = block_flat_map<account_id_type, voting_data_type>;
+    block_flat_map<game_digest_type, content_votes_type> votes_by_content(arena);
 
     std::for_each(begin(table_voting.votes), end(table_voting.votes),
                    [&](const decltype(table_voting.votes)::value_type &data)
     {
         get_game_digest_visitor get_digest;
         auto digest = data.second.visit(get_digest);
-        votes_by_content[digest].insert(std::make_pair(data.first, data.second));
+        auto itr = votes_by_content.find(digest);
+        if (itr == votes_by_content.end())
+            itr = votes_by_content.emplace(digest, content_votes_type(arena)).first;
+        itr->second.insert(std::make_pair(data.first, data.second));
     });
 
     if (votes_by_content.empty())
@@ -143,7 +148,7 @@ bool voting_impl(const table_voting_object &table_voting,
 
             for(const auto &data: votes_by_content)
             {
-                const account_votes_type &voters = data.second;
+                const content_votes_type &voters = data.second;
 
                 boost::merge(voters, accounts_with_invalid_vote,
                              std::inserter(accounts_with_invalid_vote, accounts_with_invalid_vote.end()));
@@ -174,9 +179,9 @@ struct set_required_voters
     //start playing voting
     void operator()(const game_initial_data &vote_data)
     {
-        auto &&now = d.head_block_time();
+        const auto &hardforks = d.hardforks();
 
-        if (now < HARDFORK_PLAYCHAIN_11_TIME)
+        if (!hardforks.playchain_11)
         {
             if (voter != table.room(d).owner)
                 return;
@@ -188,7 +193,7 @@ struct set_required_voters
             table_voting.required_player_voters.emplace(pr.first);
         }
 
-        if (now >= HARDFORK_PLAYCHAIN_11_TIME)
+        if (hardforks.playchain_11)
         {
             //Table owner's vote is required to start game.
             //  To revert to old behavior use
@@ -196,7 +201,7 @@ struct set_required_voters
             table_voting.required_player_voters.emplace(table.room(d).owner);
         }
 
-        if (now < HARDFORK_PLAYCHAIN_11_TIME)
+        if (!hardforks.playchain_11)
         {
             //do not use extra etalon check from HARDFORK_PLAYCHAIN_11_TIME
             table_voting.etalon_vote = vote_data;
@@ -527,7 +532,7 @@ operation_result try_voting(database &d,
                                                             voters_collected);
     const auto &index_pending = d.get_index_type<pending_table_vote_index>().indices().get<by_table>();
     auto range = index_pending.equal_range(table.id);
-    if (d.head_block_time() < HARDFORK_PLAYCHAIN_11_TIME)
+    if (!d.hardforks().playchain_11)
     {
         //invalid range
         range = std::make_pair(index_pending.begin(), index_pending.end());
@@ -582,6 +587,109 @@ operation_result try_voting(database &d,
 
     return table_voting.id;
 }
+
+void check_table_vote(const database &d, const table_object &table, const game_start_playing_check_operation &op)
+{
+    FC_ASSERT(is_table_owner(d, table, op.table_owner), "Wrong table owner");
+
+    FC_ASSERT(op.initial_data.cash.size() >= 2, "Invalid data to vote. At least two players required");
+
+    FC_ASSERT(table.is_free(), "Wrong type of voting. There is game on table");
+
+    check_incoming_vote(d, table, op);
+}
+
+void check_table_vote(const database &d, const table_object &table, const game_result_check_operation &op)
+{
+    FC_ASSERT(is_table_owner(d, table, op.table_owner), "Wrong table owner");
+
+    FC_ASSERT(table.is_playing(), "Wrong type of voting. There is no game on table");
+
+    check_incoming_vote(d, table, op);
+}
+
+operation_result apply_table_voting(database &d, const table_object &table, const game_start_playing_check_operation &op)
+{
+    const auto& parameters = get_playchain_parameters(d);
+    game_witnesses_type null;
+
+    return try_voting(d,
+                      table,
+                      null,
+                      parameters.voting_for_playing_expiration_seconds,
+                      parameters.percentage_of_voter_witness_substitution_while_voting_for_playing,
+                      op);
+}
+
+operation_result apply_table_voting(database &d, const table_object &table, const game_result_check_operation &op)
+{
+    const auto& parameters = get_playchain_parameters(d);
+
+    return try_voting(d,
+                      table,
+                      table.voted_witnesses,
+                      parameters.voting_for_results_expiration_seconds,
+                      parameters.percentage_of_voter_witness_substitution_while_voting_for_results,
+                      op);
+}
+
+template<typename Operation>
+void apply_table_vote_from_batch(database &d, const Operation &op)
+{
+    //the checks do not change the state, so any of their failures rejects just this table
+    try
+    {
+        FC_ASSERT(is_table_exists(d, op.table), "Table does not exist");
+
+        const table_object &table = op.table(d);
+
+        FC_ASSERT(is_game_witness(d, table, op.voter) || is_table_owner(d, table, op.voter),
+                  "Only table owner or game witness can vote for many tables at once");
+
+        check_table_vote(d, table, op);
+    }catch (const fc::exception &)
+    {
+        push_fail_vote_operation(d, op);
+        return;
+    }
+
+    //the checked vote may have changed the state when it fails, so the whole operation fails
+    apply_table_voting(d, op.table(d), op);
+}
+
+struct apply_table_vote_visitor
+{
+    using result_type = void;
+
+    database &d;
+    const account_id_type &voter;
+    const table_id_type &table;
+    const account_id_type &table_owner;
+
+    void operator()(const game_initial_data &data) const
+    {
+        game_start_playing_check_operation op;
+
+        op.table = table;
+        op.table_owner = table_owner;
+        op.voter = voter;
+        op.initial_data = data;
+
+        apply_table_vote_from_batch(d, op);
+    }
+
+    void operator()(const game_result &data) const
+    {
+        game_result_check_operation op;
+
+        op.table = table;
+        op.table_owner = table_owner;
+        op.voter = voter;
+        op.result = data;
+
+        apply_table_vote_from_batch(d, op);
+    }
+};
 }
 
 bool validate_ivariants(const database& d,
@@ -589,7 +697,7 @@ bool validate_ivariants(const database& d,
                         const game_initial_data &initial_data)
 {
     if (initial_data.cash.empty())
-        return d.head_block_time() < HARDFORK_PLAYCHAIN_6_TIME;
+        return !d.hardforks().playchain_6;
 
     decltype(table.cash) cash_initial;
     for (const decltype(initial_data.cash)::value_type &data: initial_data.cash)
@@ -625,7 +733,7 @@ bool validate_ivariants(const database& d,
             return false; //not enough cash on the table
     }
 
-    if (d.head_block_time() >= HARDFORK_PLAYCHAIN_1_TIME)
+    if (d.hardforks().playchain_1)
     {
         /*
          * Check that the players list corresponds to the proposed by table owner
@@ -732,7 +840,7 @@ bool voting(database& d,
                            game_witnesses_type &required_witnesses,
                            account_votes_type &accounts_with_invalid_vote)
 {
-    bool voting_consensus = voting_impl(table_voting, voting_requied_percent, valid_vote, accounts_with_invalid_vote);
+    bool voting_consensus = voting_impl(d.get_block_arena(), table_voting, voting_requied_percent, valid_vote, accounts_with_invalid_vote);
     if (voting_consensus)
     {
         required_witnesses = table_voting.voted_witnesses;
@@ -827,7 +935,7 @@ void apply_start_playing_with_consensus(database& d, const table_object &table,
 
             obj.adjust_playing_cash(player_id, player_cash);
 
-            if (d.head_block_time() >= HARDFORK_PLAYCHAIN_1_TIME && d.head_block_time() < HARDFORK_PLAYCHAIN_8_TIME)
+            if (d.hardforks().playchain_1 && !d.hardforks().playchain_8)
             {
                 assert(obj.cash.find(player_id) != obj.cash.end());
             }
@@ -892,6 +1000,7 @@ void apply_game_result_with_consensus(database& d, const table_object &table,
             {
                 auto room = table_obj.room;
                 asset room_rake;
+                const bool aggregate_fees = d.hardforks().playchain_14 && d.pending_fees_aggregation();
 
                 decltype(table_obj.playing_cash) cash_result;
                 std::for_each(begin(result.cash), end(result.cash),
@@ -903,9 +1012,13 @@ void apply_game_result_with_consensus(database& d, const table_object &table,
 
                     if (gamer_result.rake.amount > 0)
                     {
-                        d.modify(player, [&table_obj, &player_account_id, &room, &gamer_result, &required_witnesses](player_object &obj)
+                        d.modify(player, [&](player_object &obj)
                         {
-                            obj.pending_fees.emplace_back( player_account_id, table_obj.metadata, gamer_result.rake, room, required_witnesses);
+                            player_pending_fee_data fee{player_account_id, table_obj.metadata, gamer_result.rake, room, required_witnesses};
+                            if (aggregate_fees)
+                                obj.aggregate_pending_fee(fee);
+                            else
+                                obj.pending_fees.emplace_back(std::move(fee));
                         });
 
                         room_rake += gamer_result.rake;
@@ -952,7 +1065,7 @@ void apply_game_result_with_consensus(database& d, const table_object &table,
                         game_event_operation{ table.id, table_owner, game_result_validated{ result } } );
         };
 
-        if (d.head_block_time() >= HARDFORK_PLAYCHAIN_10_TIME)
+        if (d.hardforks().playchain_10)
         {
             with_registration_buy_in(d, table, apply_impl);
         }else
@@ -980,8 +1093,7 @@ void apply_game_result_with_consensus(database& d, const table_object &table,
 
 void cleanup_pending_votes(database& d, const table_object &table, const char *from)
 {
-    auto &&current_time_point = d.head_block_time();
-    if (current_time_point >= HARDFORK_PLAYCHAIN_1_TIME)
+    if (d.hardforks().playchain_1)
     {
         const auto& parameters = get_playchain_parameters(d);
         const auto &index_pending = d.get_index_type<pending_table_vote_index>().indices().get<by_table>();
@@ -1078,7 +1190,7 @@ void rollback(database& d, const table_object &table, bool full_clear)
         cleanup_pending_votes(d, table, "rollback");
     };
 
-    if (d.head_block_time() >= HARDFORK_PLAYCHAIN_10_TIME)
+    if (d.hardforks().playchain_10)
     {
         if (!full_clear)
         {
@@ -1134,6 +1246,11 @@ void push_fail_vote_operation(database &d, const table_object &table,
     push_fail_vote_operation(d, op_reverted);
 }
 
+void apply_table_vote(database &d, const account_id_type &voter, const table_id_type &table, const game_table_vote &vote)
+{
+    vote.data.visit(apply_table_vote_visitor{d, voter, table, vote.table_owner});
+}
+
 game_start_playing_check_evaluator_impl::game_start_playing_check_evaluator_impl(generic_evaluator &ev): _ev(ev)
 {}
 database& game_start_playing_check_evaluator_impl::db() const
@@ -1159,15 +1276,7 @@ void_result game_start_playing_check_evaluator_impl_v2::do_evaluate(const operat
 
         FC_ASSERT(is_table_exists(d, op.table), "Table does not exist");
 
-        const table_object &table = op.table(d);
-
-        FC_ASSERT(is_table_owner(d, table, op.table_owner), "Wrong table owner");
-
-        FC_ASSERT(op.initial_data.cash.size() >= 2, "Invalid data to vote. At least two players required");
-
-        FC_ASSERT(table.is_free(), "Wrong type of voting. There is game on table");
-
-        check_incoming_vote(d, table, op);
+        check_table_vote(d, op.table(d), op);
 
         return void_result{};
     }FC_CAPTURE_AND_RETHROW((op))
@@ -1180,9 +1289,6 @@ operation_result game_start_playing_check_evaluator_impl_v2::do_apply( const ope
 
         const table_object &table = op.table(d);
 
-        const auto& parameters = get_playchain_parameters(d);
-        game_witnesses_type null;
-
 #if defined(LOG_VOTING)
         if (d.head_block_time() >= fc::time_point_sec( LOG_VOTING_BLOCK_TIMESTUMP_FROM ))
         {
@@ -1192,12 +1298,7 @@ operation_result game_start_playing_check_evaluator_impl_v2::do_apply( const ope
         }
 #endif
 
-        return try_voting(d,
-                          table,
-                          null,
-                          parameters.voting_for_playing_expiration_seconds,
-                          parameters.percentage_of_voter_witness_substitution_while_voting_for_playing,
-                          op);
+        return apply_table_voting(d, table, op);
     }FC_CAPTURE_AND_RETHROW((op))
 }
 
@@ -1208,13 +1309,7 @@ void_result game_result_check_evaluator_impl_v2::do_evaluate( const operation_ty
 
         FC_ASSERT(is_table_exists(d, op.table), "Table does not exist");
 
-        const table_object &table = op.table(d);
-
-        FC_ASSERT(is_table_owner(d, table, op.table_owner), "Wrong table owner");
-
-        FC_ASSERT(table.is_playing(), "Wrong type of voting. There is no game on table");
-
-        check_incoming_vote(d, table, op);
+        check_table_vote(d, op.table(d), op);
 
         return void_result{};
     }FC_CAPTURE_AND_RETHROW((op))
@@ -1227,8 +1322,6 @@ operation_result game_result_check_evaluator_impl_v2::do_apply( const operation_
 
         const table_object &table = op.table(d);
 
-        const auto& parameters = get_playchain_parameters(d);
-
 #if defined(LOG_VOTING)
         if (d.head_block_time() >= fc::time_point_sec( LOG_VOTING_BLOCK_TIMESTUMP_FROM ))
         {
@@ -1238,12 +1331,7 @@ operation_result game_result_check_evaluator_impl_v2::do_apply( const operation_
         }
 #endif
 
-        return try_voting(d,
-                          table,
-                          table.voted_witnesses,
-                          parameters.voting_for_results_expiration_seconds,
-                          parameters.percentage_of_voter_witness_substitution_while_voting_for_results,
-                          op);
+        return apply_table_voting(d, table, op);
     }FC_CAPTURE_AND_RETHROW((op))
 }
 }}
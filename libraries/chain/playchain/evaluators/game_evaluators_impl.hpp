@@ -96,6 +96,11 @@ namespace playchain { namespace chain {
 
     void push_fail_vote_operation(database &d, const table_object &table, const account_id_type &voter, const game_initial_data &vote);
 
+    ///apply the vote of game_votes_check_operation for one table:
+    ///a vote failing any of the checks rejects only this table with fail_vote event,
+    ///an error while the checked vote is applied fails the whole operation as the single votes do
+    void apply_table_vote(database &d, const account_id_type &voter, const table_id_type &table, const game_table_vote &vote);
+
     class game_start_playing_check_evaluator_impl
     {
     public:
@@ -150,7 +150,7 @@ void obsolete_buyins_resolve(database& d, const table_object &table, bool clear)
         }
 #endif
             d.remove(buy_in);
-        }else if (d.head_block_time() < HARDFORK_PLAYCHAIN_7_TIME)
+        }else if (!d.hardforks().playchain_7)
         {
             prolong_life_for_by_in(d, buy_in);
         }
@@ -216,7 +216,7 @@ operation_result game_start_playing_check_evaluator_impl_v1::do_apply( const ope
             {
                 auto pending_op = vote_obj.vote.op.get<operation_type>();
 
-                if (d.head_block_time() < HARDFORK_PLAYCHAIN_1_TIME)
+                if (!d.hardforks().playchain_1)
                 {
                     wait_next_vote = apply_start_playing_check_voting(d, table, pending_op);
                 }else
@@ -299,7 +299,7 @@ operation_result game_result_check_evaluator_impl_v1::do_apply( const operation_
             {
                 auto pending_op = vote_obj.vote.op.get<operation_type>();
 
-                if (d.head_block_time() < HARDFORK_PLAYCHAIN_1_TIME)
+                if (!d.hardforks().playchain_1)
                 {
                     wait_next_vote = apply_game_result_check_voting(d, table, pending_op);
                 }else
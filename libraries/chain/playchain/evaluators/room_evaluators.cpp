@@ -44,9 +44,14 @@ void_result room_create_evaluator::do_evaluate(const operation_type& op)
         version_ext checked_protocol_version;
         fc::from_variant(op.protocol_version, checked_protocol_version);
 
-        const auto& rooms_by_owner_and_metadata = d.get_index_type<room_index>().indices().get<by_room_owner_and_metadata>();
-        FC_ASSERT(rooms_by_owner_and_metadata.end() == rooms_by_owner_and_metadata.find(boost::make_tuple(op.owner, op.metadata)),
-                  "There is the same room that is owned by account");
+        // no room has the metadata that has never been interned
+        auto interned_metadata = d.interned_strings().find(op.metadata);
+        if (interned_metadata.valid())
+        {
+            const auto& rooms_by_owner_and_metadata = d.get_index_type<room_index>().indices().get<by_room_owner_and_metadata>();
+            FC_ASSERT(rooms_by_owner_and_metadata.end() == rooms_by_owner_and_metadata.find(boost::make_tuple(op.owner, *interned_metadata)),
+                      "There is the same room that is owned by account");
+        }
 
         return void_result();
     } FC_CAPTURE_AND_RETHROW((op))
@@ -78,10 +83,10 @@ object_id_type room_create_evaluator::do_apply(const operation_type& op)
         const auto &new_room = d.create<room_object>([&](room_object& room) {
                        room.owner = op.owner;
                        room.server_url = op.server_url;
-                       room.metadata = op.metadata;
+                       room.metadata = d.interned_strings().intern(op.metadata);
                        fc::from_variant(op.protocol_version, room.protocol_version);
 
-                       if (d.head_block_time() >= HARDFORK_PLAYCHAIN_5_TIME)
+                       if (d.hardforks().playchain_5)
                        {
                            room.rating = d.get_dynamic_global_properties().average_room_rating;
                        }
@@ -119,7 +124,7 @@ void_result room_update_evaluator::do_apply(const operation_type& op)
 
         d.modify(op.room(d), [&](room_object& room) {
                        room.server_url = op.server_url;
-                       room.metadata = op.metadata;
+                       room.metadata = d.interned_strings().intern(op.metadata);
                        fc::from_variant(op.protocol_version, room.protocol_version);
                     });
 
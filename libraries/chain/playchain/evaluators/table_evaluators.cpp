@@ -57,7 +57,7 @@ namespace playchain{ namespace chain{
 
             const auto &new_table = d.create<table_object>([&](table_object& table) {
                            table.room = op.room;
-                           table.metadata = op.metadata;
+                           table.metadata = d.interned_strings().intern(op.metadata);
                            table.required_witnesses = op.required_witnesses;
                            table.min_accepted_proposal_asset = op.min_accepted_proposal_asset;
                            table.game_created = fc::time_point_sec::min();
@@ -83,7 +83,7 @@ namespace playchain{ namespace chain{
 
             FC_ASSERT(table_obj.is_free(), "Can't update table while playing");
             FC_ASSERT(!is_table_voting(d, op.table), "Can't update table while voting");
-            if (d.head_block_time() >= HARDFORK_PLAYCHAIN_3_TIME &&
+            if (d.hardforks().playchain_3 &&
                     table_obj.metadata != op.metadata)
             {
                 FC_ASSERT(!is_table_alive(d, table_obj.id), "Can't update table metadata while table alive");
@@ -101,7 +101,7 @@ namespace playchain{ namespace chain{
             auto &&table_obj = op.table(d);
 
             d.modify(table_obj, [&](table_object& table) {
-                            table.metadata = op.metadata;
+                            table.metadata = d.interned_strings().intern(op.metadata);
                             table.required_witnesses = op.required_witnesses;
                             table.min_accepted_proposal_asset = op.min_accepted_proposal_asset;
                         });
@@ -149,6 +149,7 @@ namespace playchain{ namespace chain{
 
         const auto& idx = d.get_index_type<table_alive_index>().indices().get<by_table>();
         auto it = idx.find(table_obj.id);
+        bool was_alive = idx.end() != it || is_room_alive(d, table_obj.room);
         if (idx.end() != it)
         {
             d.modify(*it, [&](table_alive_object& alive) {
@@ -164,9 +165,72 @@ namespace playchain{ namespace chain{
             }).id;
         }
 
-        table_obj.set_weight(d);
+        if (!d.hardforks().playchain_12 || !was_alive)
+            table_obj.set_weight(d);
 
         return alive_id;
     }
 
+    void_result room_alive_evaluator::do_evaluate( const operation_type& op )
+    {
+        try {
+            const database& d = db();
+            FC_ASSERT(d.hardforks().playchain_12, "Room heartbeat is not allowed before HARDFORK_PLAYCHAIN_12_TIME");
+            FC_ASSERT(is_room_exists(d, op.room), "Room does not exist");
+            FC_ASSERT(is_room_owner(d, op.owner, op.room), "Wrong room owner");
+
+            return void_result();
+        } FC_CAPTURE_AND_RETHROW((op))
+    }
+
+    operation_result room_alive_evaluator::do_apply( const operation_type& op )
+    {
+        try {
+            return alive_for_room(db(), op.room);
+        } FC_CAPTURE_AND_RETHROW((op))
+    }
+
+    operation_result alive_for_room(database& d, const room_id_type &room)
+    {
+        const auto& dyn_props = d.get_dynamic_global_properties();
+        const auto& parameters = get_playchain_parameters(d);
+
+        const auto& idx = d.get_index_type<room_alive_index>().indices().get<by_room>();
+        auto it = idx.find(room);
+        if (idx.end() != it)
+        {
+            //tables of the room are alive already, so their weights stay the same
+            d.modify(*it, [&](room_alive_object& alive) {
+                alive.expiration = dyn_props.time + fc::seconds(parameters.table_alive_expiration_seconds);
+                        });
+            return it->id;
+        }
+
+        object_id_type alive_id = d.create<room_alive_object>([&](room_alive_object& alive) {
+                                   alive.room = room;
+                                   alive.created = dyn_props.time;
+                                   alive.expiration = alive.created + fc::seconds(parameters.table_alive_expiration_seconds);
+        }).id;
+
+        update_weights_for_room_tables(d, room);
+
+        return alive_id;
+    }
+
+    void update_weights_for_room_tables(database& d, const room_id_type &room)
+    {
+        const auto& alive_idx = d.get_index_type<table_alive_index>().indices().get<by_table>();
+        const auto& tables_by_room = d.get_index_type<table_index>().indices().get<by_room>();
+        auto range = tables_by_room.equal_range(std::make_tuple(room));
+        for (auto itr = range.first; itr != range.second; ++itr)
+        {
+            const table_object &table = *itr;
+            //tables with own heartbeat do not change their liveness
+            if (alive_idx.end() != alive_idx.find(table.id))
+                continue;
+
+            table.set_weight(d);
+        }
+    }
+
 }}
@@ -79,7 +79,18 @@ namespace playchain { namespace chain {
     bool is_table_alive(const database& d, const table_id_type &table)
     {
         const auto& idx = d.get_index_type<table_alive_index>().indices().get<by_table>();
-        return idx.end() != idx.find(table);
+        if (idx.end() != idx.find(table))
+            return true;
+
+        //room heartbeats exist from HARDFORK_PLAYCHAIN_12_TIME only
+        const table_object *ptable = d.find(table);
+        return ptable && is_room_alive(d, ptable->room);
+    }
+
+    bool is_room_alive(const database& d, const room_id_type &room)
+    {
+        const auto& idx = d.get_index_type<room_alive_index>().indices().get<by_room>();
+        return idx.end() != idx.find(room);
     }
 
     bool is_table_voting_for_playing(const database& d, const table_id_type &table)
@@ -360,6 +360,14 @@ struct get_impacted_account_visitor
        _impacted.insert(op.voter);
        _impacted.insert(op.table_owner);
    }
+   void operator()(const game_votes_check_operation& op)
+   {
+       _impacted.insert(op.voter);
+       for (const auto &vote: op.votes)
+       {
+           _impacted.insert(vote.second.table_owner);
+       }
+   }
    void operator()(const game_reset_operation& op)
    {
        _impacted.insert(op.table_owner);
@@ -464,6 +472,11 @@ struct get_impacted_account_visitor
    {
        _impacted.insert(op.owner);
    }
+
+   void operator()( const room_alive_operation& op )
+   {
+       _impacted.insert(op.owner);
+   }
 };
 
 void operation_get_impacted_accounts( const operation& op, flat_set<account_id_type>& result )
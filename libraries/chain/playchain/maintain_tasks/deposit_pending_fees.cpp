@@ -26,6 +26,7 @@
 
 #include <graphene/chain/database.hpp>
 #include <graphene/chain/db_with.hpp>
+#include <graphene/chain/hardfork.hpp>
 
 #include <graphene/chain/account_object.hpp>
 #include <graphene/chain/vesting_balance_object.hpp>
@@ -44,6 +45,9 @@
 
 #include <boost/range/iterator_range.hpp>
 
+#include <map>
+#include <vector>
+
 namespace playchain { namespace chain {
 
 namespace
@@ -127,9 +131,60 @@ namespace
         return;
     }
 
+    ///no cashbacks are waiting for deposit
+    struct no_pending_cashbacks
+    {
+        template<typename T>
+        share_type operator()(const T&) const
+        {
+            return 0;
+        }
+    };
+
+    /**
+     * Adds the vesting balance of the cashback parent with the cashbacks not deposited yet
+     * as it would be after the deposits. Returns true if the threshold is reached.
+     */
+    template<typename T, typename Pending>
+    bool add_cashback_balance(database &d,
+                              const T& cashback_parent,
+                              const account_id_type &owner,
+                              const Pending &pending,
+                              const share_type &threshold,
+                              share_type &result,
+                              flat_set<vesting_balance_id_type> &playchain_vbs)
+    {
+        const share_type pending_amount = pending(cashback_parent);
+        optional<vesting_balance_id_type> vbid = cashback_parent.balance;
+        if (pending_amount > 0 && vbid.valid())
+        {
+            //deposit_lazy_vesting creates the new balance for the parent, the old one is just a vesting balance of the owner
+            const vesting_balance_object &vb = (*vbid)(d);
+            if (vb.owner != owner ||
+                vb.policy.which() != vesting_policy::tag< cdd_vesting_policy >::value ||
+                vb.policy.get< cdd_vesting_policy >().vesting_seconds != d.get_global_properties().parameters.cashback_vesting_period_seconds)
+                vbid.reset();
+        }
+
+        if (!vbid.valid() && pending_amount < 1)
+            return false;
+
+        result += pending_amount;
+        if (vbid.valid())
+            result += (*vbid)(d).balance.amount;
+        if (threshold >= result)
+            return true;
+
+        if (vbid.valid())
+            playchain_vbs.emplace(*vbid);
+        return false;
+    }
+
+    template<typename Pending = no_pending_cashbacks>
     share_type get_total_balance(database &d,
                                  const playchain_parameters &parameters,
-                                 const player_object &player)
+                                 const player_object &player,
+                                 const Pending &pending = Pending{})
     {
         const auto threshold = parameters.player_referrer_balance_max_threshold;
         const auto &account = player.account(d);
@@ -142,45 +197,23 @@ namespace
 
         flat_set<vesting_balance_id_type> playchain_vbs;
 
-        if (player.balance.valid())
-        {
-            const vesting_balance_object &vb = (*player.balance)(d);
-            result += vb.balance.amount;
-            if (threshold >= result)
-                return result;
-
-            playchain_vbs.emplace(vb.id);
-        }
+        if (add_cashback_balance(d, player, account.id, pending, threshold, result, playchain_vbs))
+            return result;
 
         const auto& witness_by_account = d.get_index_type<game_witness_index>().indices().get<by_playchain_account>();
         auto witness_by_account_it = witness_by_account.find(account.id);
         if (witness_by_account.end() != witness_by_account_it)
         {
-            const auto &witness = (*witness_by_account_it);
-            if (witness.balance.valid())
-            {
-                const vesting_balance_object &vb = (*witness.balance)(d);
-                result += vb.balance.amount;
-                if (threshold >= result)
-                    return result;
-
-                playchain_vbs.emplace(vb.id);
-            }
+            if (add_cashback_balance(d, *witness_by_account_it, account.id, pending, threshold, result, playchain_vbs))
+                return result;
         }
 
         const auto& rooms_by_owner = d.get_index_type<room_index>().indices().get<by_room_owner>();
         auto rooms_range = rooms_by_owner.equal_range(account.id);
         for( const room_object& room: boost::make_iterator_range( rooms_range.first, rooms_range.second ) )
         {
-            if (room.balance.valid())
-            {
-                const vesting_balance_object &vb = (*room.balance)(d);
-                result += vb.balance.amount;
-                if (threshold >= result)
-                    return result;
-
-                playchain_vbs.emplace(vb.id);
-            }
+            if (add_cashback_balance(d, room, account.id, pending, threshold, result, playchain_vbs))
+                return result;
         }
 
         if (parameters.take_into_account_graphene_balances)
@@ -201,18 +234,49 @@ namespace
         return result;
     }
 
-    void disseminate_for_inviters(database &d,
-                                  const playchain_parameters &parameters,
-                                  const marked_deposit_context &ctx,
-                                  const room_object &room,
-                                  const player_object &inviter,
-                                  share_type &amount,
-                                  int max_depth)
+    void merge_parent_invitation_fees(player_object::fees_by_rooms_type &to,
+                                      const player_object::fees_by_rooms_type &from)
     {
-        if (inviter.id == PLAYCHAIN_NULL_PLAYER || amount < 1)
-            return;
+        for (auto &&fees_by_room: from)
+        {
+            auto &&deposit_stats = to[fees_by_room.first];
+            for (const auto &ds: fees_by_room.second)
+            {
+                auto &&it = deposit_stats.find(ds);
+                if (it == deposit_stats.end())
+                {
+                    deposit_stats.emplace(ds);
+                }else
+                {
+                    (*it).amount += ds.amount;
+                }
+            }
+        }
+    }
 
-        if (max_depth < 1)
+    /**
+     * Deposits every cut at once as it is computed
+     */
+    struct immediate_depositor
+    {
+        immediate_depositor(database &d):
+            d(d)
+        {}
+
+        template<typename T>
+        void cashback(const marked_deposit_context &ctx,
+                      const room_object &room,
+                      const T& cashback_parent,
+                      const account_id_type &owner,
+                      const share_type &amount)
+        {
+            deposit_cashback(d, ctx, room, cashback_parent, owner, amount);
+        }
+
+        void parent_invitation_fee(const marked_deposit_context &ctx,
+                                   const room_object &room,
+                                   const player_object &inviter,
+                                   const share_type &amount)
         {
             d.modify( inviter, [&](player_object &obj)
             {
@@ -225,6 +289,243 @@ namespace
                 }
                 (*it).amount += amount;
             });
+        }
+
+        const player_object::fees_by_rooms_type &parent_invitation_fees(const player_object &player)
+        {
+            return player.pending_parent_invitation_fees;
+        }
+
+        share_type total_balance(const playchain_parameters &parameters,
+                                 const player_object &player)
+        {
+            return get_total_balance(d, parameters, player);
+        }
+
+        database &d;
+    };
+
+    /**
+     * Cashbacks of the same kind of recipients stored by columns in order of the first deposit
+     */
+    template<typename T>
+    struct cashback_column
+    {
+        ///returns true for the first cashback of the parent
+        bool add(const T& cashback_parent, const account_id_type &owner, const share_type &amount)
+        {
+            auto it = positions.find(cashback_parent.id);
+            if (it == positions.end())
+            {
+                positions.emplace(cashback_parent.id, parents.size());
+                parents.emplace_back(std::cref(cashback_parent));
+                owners.emplace_back(owner);
+                amounts.emplace_back(amount);
+                return true;
+            }
+
+            amounts[it->second] += amount;
+            return false;
+        }
+
+        share_type pending(const T& cashback_parent) const
+        {
+            auto it = positions.find(cashback_parent.id);
+            if (it == positions.end())
+                return 0;
+            return amounts[it->second];
+        }
+
+        void apply(database &d, const size_t ci, const uint32_t vesting_seconds) const
+        {
+            const T& cashback_parent = parents[ci];
+
+            optional< vesting_balance_id_type > new_vbid = d.deposit_lazy_vesting(
+               cashback_parent.balance,
+               amounts[ci],
+               vesting_seconds,
+               vesting_balance_type::cashback,
+               owners[ci],
+               true );
+
+            if( new_vbid.valid() )
+            {
+               d.modify( cashback_parent, [&]( T& cashback_parent_ )
+               {
+                  cashback_parent_.balance = *new_vbid;
+               } );
+            }
+        }
+
+        std::vector<std::reference_wrapper<const T>> parents;
+        std::vector<account_id_type> owners;
+        std::vector<share_type> amounts;
+        std::map<object_id_type, size_t> positions;
+    };
+
+    /**
+     * Collects all cuts first (from HARDFORK_PLAYCHAIN_15_TIME). Then every recipient gets a single
+     * vesting deposit and every room a single pending rake update.
+     *
+     * The result is the same as of immediate_depositor: the inviter balances take into account the
+     * cashbacks not deposited yet, the remainders passed to the pending inviters are disseminated
+     * in the same pass and the vesting balances are created in the order of the first deposits.
+     */
+    struct accumulating_depositor
+    {
+        accumulating_depositor(database &d):
+            d(d)
+        {}
+
+        template<typename T>
+        void cashback(const marked_deposit_context &ctx,
+                      const room_object &room,
+                      const T& cashback_parent,
+                      const account_id_type &owner,
+                      const share_type &amount)
+        {
+            if( amount < 1 )
+               return;
+
+            d.push_applied_operation(
+                        playchain_deposit_cashback_operation{ ctx.type, ctx.ctx.getter, owner, asset{amount, ctx.ctx.asset_id}, ctx.ctx.metadata } );
+
+            auto &&cashbacks = column(cashback_parent);
+            if (cashbacks.add(cashback_parent, owner, amount))
+                deposits_order.emplace_back(cashback_parent.id, cashbacks.parents.size() - 1);
+            room_rake_cuts[room.id] += amount;
+        }
+
+        void parent_invitation_fee(const marked_deposit_context &ctx,
+                                   const room_object &room,
+                                   const player_object &inviter,
+                                   const share_type &amount)
+        {
+            deposit_statistic ds{ctx.ctx.getter, ctx.ctx.metadata, asset{0,ctx.ctx.asset_id} };
+            auto &&deposit_stats = pending_parent_invitation_fees[inviter.id][room.id];
+            auto &&it = deposit_stats.find(ds);
+            if (it == deposit_stats.end())
+            {
+                it = deposit_stats.emplace(ds).first;
+            }
+            (*it).amount += amount;
+        }
+
+        ///the remainders passed to the player earlier in this pass are disseminated with the stored ones
+        const player_object::fees_by_rooms_type &parent_invitation_fees(const player_object &player)
+        {
+            auto it = pending_parent_invitation_fees.find(player.id);
+            if (it == pending_parent_invitation_fees.end())
+                return player.pending_parent_invitation_fees;
+
+            merged_parent_invitation_fees = player.pending_parent_invitation_fees;
+            merge_parent_invitation_fees(merged_parent_invitation_fees, it->second);
+            pending_parent_invitation_fees.erase(it);
+            return merged_parent_invitation_fees;
+        }
+
+        ///takes into account the cashbacks which are not deposited yet
+        share_type total_balance(const playchain_parameters &parameters,
+                                 const player_object &player)
+        {
+            return get_total_balance(d, parameters, player, [this](const auto &cashback_parent)
+            {
+                return column(cashback_parent).pending(cashback_parent);
+            });
+        }
+
+        void apply(const std::vector<std::reference_wrapper<const player_object>> &players)
+        {
+            const auto vesting_seconds = d.get_global_properties().parameters.cashback_vesting_period_seconds;
+
+            for (const auto &deposit: deposits_order)
+            {
+                switch (deposit.first.type())
+                {
+                case player_object::type_id:
+                    inviters.apply(d, deposit.second, vesting_seconds);
+                    break;
+                case game_witness_object::type_id:
+                    witnesses.apply(d, deposit.second, vesting_seconds);
+                    break;
+                default:
+                    rooms.apply(d, deposit.second, vesting_seconds);
+                }
+            }
+
+            for (const auto &cut: room_rake_cuts)
+            {
+                d.modify(cut.first(d), [&cut](room_object &obj)
+                {
+                    obj.pending_rake -= asset(cut.second, obj.pending_rake.asset_id);
+                });
+            }
+
+            //the stored remainders of the players have been disseminated, only the ones passed later stay
+            for( const player_object& player : players )
+            {
+                auto it = pending_parent_invitation_fees.find(player.id);
+                d.modify(player, [&](player_object& obj) {
+                   obj.pending_fees.clear();
+                   obj.pending_rakes.clear();
+                   obj.pending_parent_invitation_fees.clear();
+                   if (it != pending_parent_invitation_fees.end())
+                       obj.pending_parent_invitation_fees = std::move(it->second);
+                });
+                if (it != pending_parent_invitation_fees.end())
+                    pending_parent_invitation_fees.erase(it);
+            }
+
+            //remainders of the players without own pending fees
+            for (auto &&fees: pending_parent_invitation_fees)
+            {
+                d.modify(fees.first(d), [&fees](player_object& obj) {
+                    merge_parent_invitation_fees(obj.pending_parent_invitation_fees, fees.second);
+                });
+            }
+        }
+
+        cashback_column<player_object>& column(const player_object &)
+        {
+            return inviters;
+        }
+        cashback_column<game_witness_object>& column(const game_witness_object &)
+        {
+            return witnesses;
+        }
+        cashback_column<room_object>& column(const room_object &)
+        {
+            return rooms;
+        }
+
+        database &d;
+
+        cashback_column<player_object> inviters;
+        cashback_column<game_witness_object> witnesses;
+        cashback_column<room_object> rooms;
+        ///parents by the first cashback with their positions in the columns
+        std::vector<std::pair<object_id_type, size_t>> deposits_order;
+        std::map<room_id_type, share_type> room_rake_cuts;
+        std::map<player_id_type, player_object::fees_by_rooms_type> pending_parent_invitation_fees;
+        player_object::fees_by_rooms_type merged_parent_invitation_fees;
+    };
+
+    template<typename Depositor>
+    void disseminate_for_inviters(database &d,
+                                  Depositor &depositor,
+                                  const playchain_parameters &parameters,
+                                  const marked_deposit_context &ctx,
+                                  const room_object &room,
+                                  const player_object &inviter,
+                                  share_type &amount,
+                                  int max_depth)
+    {
+        if (inviter.id == PLAYCHAIN_NULL_PLAYER || amount < 1)
+            return;
+
+        if (max_depth < 1)
+        {
+            depositor.parent_invitation_fee(ctx, room, inviter, amount);
 
             amount = 0;
             return;
@@ -235,7 +536,7 @@ namespace
         if (max_my_cut > 0)
         {
             share_type my_cut{max_my_cut};
-            auto balance = get_total_balance(d, parameters, inviter);
+            auto balance = depositor.total_balance(parameters, inviter);
             if (balance < parameters.player_referrer_balance_min_threshold)
             {
                 parents_cut += my_cut;
@@ -249,32 +550,21 @@ namespace
                 parents_cut += max_my_cut - my_cut;
             }
 
-            deposit_cashback(d, ctx, room, inviter, inviter.account, my_cut);
+            depositor.cashback(ctx, room, inviter, inviter.account, my_cut);
         }
 
         amount = parents_cut;
-        disseminate_for_inviters(d, parameters, ctx, room,
+        disseminate_for_inviters(d, depositor, parameters, ctx, room,
                                  inviter.inviter(d), amount, --max_depth);
     }
-}
-
-void deposit_pending_fees(database &d)
-{
-    const auto& parameters = get_playchain_parameters(d);
-    const auto& idx = d.get_index_type<player_index>().indices().get<by_pending_fees>();
-    using cref_type = std::reference_wrapper<const player_object>;
-    std::vector<cref_type> players;
-    for( const player_object& player : idx )
-    {
-        if (player.is_not_pending())
-            break;
-
-        players.emplace_back(std::cref(player));
-    }
 
-    for( const player_object& player : players )
+    template<typename Depositor>
+    void disseminate_parent_invitation_fees(database &d,
+                                            Depositor &depositor,
+                                            const playchain_parameters &parameters,
+                                            const player_object &player)
     {
-        for(const auto &pending_fees_p: player.pending_parent_invitation_fees)
+        for(const auto &pending_fees_p: depositor.parent_invitation_fees(player))
         {
             auto room_id = pending_fees_p.first;
             const auto &room = room_id(d);
@@ -283,64 +573,130 @@ void deposit_pending_fees(database &d)
                 deposit_context player_ctx{ds.getter, ds.metadata, ds.asset_id};
                 marked_deposit_context inviter_deposit_ctx{playchain_deposit_type::inviter, player_ctx};
                 auto pending_amount = ds.amount;
-                disseminate_for_inviters(d, parameters, inviter_deposit_ctx, room,
+                disseminate_for_inviters(d, depositor, parameters, inviter_deposit_ctx, room,
                                          player, pending_amount, PLAYCHAIN_MAXIMUM_INVITERS_DEPTH);
 
-                deposit_cashback(d, inviter_deposit_ctx, room, room, room.owner, ds.amount);
+                depositor.cashback(inviter_deposit_ctx, room, room, room.owner, ds.amount);
             }
         }
+    }
 
-        d.modify(player, [](player_object& obj) {
-           obj.pending_parent_invitation_fees.clear();
-        });
-
-        for(const auto &data: player.pending_fees)
-        {
-            deposit_context player_ctx{data.getter, data.metadata, data.asset_id};
-            marked_deposit_context inviter_deposit_ctx{playchain_deposit_type::inviter, player_ctx};
-            marked_deposit_context room_owner_deposit_ctx{playchain_deposit_type::room, player_ctx};
-            marked_deposit_context witness_deposit_ctx{playchain_deposit_type::witness, player_ctx};
+    template<typename Depositor>
+    void disseminate_pending_fee(database &d,
+                                 Depositor &depositor,
+                                 const playchain_parameters &parameters,
+                                 const player_object &player,
+                                 const player_pending_fee_data &data,
+                                 const share_type &pending_fees)
+    {
+        deposit_context player_ctx{data.getter, data.metadata, data.asset_id};
+        marked_deposit_context inviter_deposit_ctx{playchain_deposit_type::inviter, player_ctx};
+        marked_deposit_context room_owner_deposit_ctx{playchain_deposit_type::room, player_ctx};
+        marked_deposit_context witness_deposit_ctx{playchain_deposit_type::witness, player_ctx};
 
-            const auto &room = data.room(d);
-            const auto &pending_fees = data.amount;
+        const auto &room = data.room(d);
 
-            auto inviters_cut = cut_fee(pending_fees, parameters.player_referrer_percent_of_fee );
-            auto witness_cut = cut_fee(pending_fees, parameters.game_witness_percent_of_fee );
-            auto game_owner_cut = pending_fees - inviters_cut - witness_cut;
+        auto inviters_cut = cut_fee(pending_fees, parameters.player_referrer_percent_of_fee );
+        auto witness_cut = cut_fee(pending_fees, parameters.game_witness_percent_of_fee );
+        auto game_owner_cut = pending_fees - inviters_cut - witness_cut;
 
-            disseminate_for_inviters(d, parameters, inviter_deposit_ctx, room,
-                                     player.inviter(d), inviters_cut, PLAYCHAIN_MAXIMUM_INVITERS_DEPTH);
-            game_owner_cut += inviters_cut;
+        disseminate_for_inviters(d, depositor, parameters, inviter_deposit_ctx, room,
+                                 player.inviter(d), inviters_cut, PLAYCHAIN_MAXIMUM_INVITERS_DEPTH);
+        game_owner_cut += inviters_cut;
 
-            auto witnesses = data.witnesses.size();
-            if (witnesses > 0u)
+        auto witnesses = data.witnesses.size();
+        if (witnesses > 0u)
+        {
+            auto witness_one_cut = witness_cut / witnesses;
+            if (witness_one_cut > 0)
             {
-                auto witness_one_cut = witness_cut / witnesses;
-                if (witness_one_cut > 0)
+                for(const game_witness_id_type &witness_id: data.witnesses)
                 {
-                    for(const game_witness_id_type &witness_id: data.witnesses)
-                    {
-                        const auto &witness = witness_id(d);
-                        deposit_cashback(d, witness_deposit_ctx, room, witness, witness.account, witness_one_cut);
-                        witness_cut -= witness_one_cut;
-                    }
+                    const auto &witness = witness_id(d);
+                    depositor.cashback(witness_deposit_ctx, room, witness, witness.account, witness_one_cut);
+                    witness_cut -= witness_one_cut;
                 }
-                if (witness_cut > 0)
-                {
-                    const game_witness_id_type &lucky_witness_id = (*data.witnesses.begin());
-                    const auto &witness = lucky_witness_id(d);
-                    deposit_cashback(d, witness_deposit_ctx, room, witness, witness.account, witness_cut);
-                }
-            }else
+            }
+            if (witness_cut > 0)
             {
-                game_owner_cut += witness_cut;
+                const game_witness_id_type &lucky_witness_id = (*data.witnesses.begin());
+                const auto &witness = lucky_witness_id(d);
+                depositor.cashback(witness_deposit_ctx, room, witness, witness.account, witness_cut);
             }
+        }else
+        {
+            game_owner_cut += witness_cut;
+        }
+
+        depositor.cashback(room_owner_deposit_ctx, room, room, room.owner, game_owner_cut);
+    }
 
-            deposit_cashback(d, room_owner_deposit_ctx, room, room, room.owner, game_owner_cut);
+    template<typename Depositor>
+    void disseminate_pending_fees(database &d,
+                                  Depositor &depositor,
+                                  const playchain_parameters &parameters,
+                                  const player_object &player)
+    {
+        if (player.pending_rakes.empty())
+        {
+            for(const auto &data: player.pending_fees)
+            {
+                disseminate_pending_fee(d, depositor, parameters, player, data, data.amount);
+            }
+            return;
+        }
+
+        //the aggregated fees are paid out rake by rake in the order of the games
+        for(const auto &rake: player.pending_rakes)
+        {
+            disseminate_pending_fee(d, depositor, parameters, player, player.pending_fees.at(rake.destination), rake.amount);
         }
+    }
+}
+
+void deposit_pending_fees(database &d)
+{
+    const auto& parameters = get_playchain_parameters(d);
+    const auto& idx = d.get_index_type<player_index>().indices().get<by_pending_fees>();
+    using cref_type = std::reference_wrapper<const player_object>;
+    std::vector<cref_type> players;
+    for( const player_object& player : idx )
+    {
+        if (player.is_not_pending())
+            break;
+
+        players.emplace_back(std::cref(player));
+    }
+
+    if (d.hardforks().playchain_15 && d.pending_fees_accumulation())
+    {
+        accumulating_depositor depositor(d);
+
+        for( const player_object& player : players )
+        {
+            disseminate_parent_invitation_fees(d, depositor, parameters, player);
+            disseminate_pending_fees(d, depositor, parameters, player);
+        }
+
+        depositor.apply(players);
+        return;
+    }
+
+    immediate_depositor depositor(d);
+
+    for( const player_object& player : players )
+    {
+        disseminate_parent_invitation_fees(d, depositor, parameters, player);
+
+        d.modify(player, [](player_object& obj) {
+           obj.pending_parent_invitation_fees.clear();
+        });
+
+        disseminate_pending_fees(d, depositor, parameters, player);
 
         d.modify(player, [](player_object& obj) {
            obj.pending_fees.clear();
+           obj.pending_rakes.clear();
         });
     }
 }
@@ -225,7 +225,7 @@ void update_room_rating(database &d)
 {
     remove_expired_room_rating_measurements(d);
 
-    if (d.head_block_time() < HARDFORK_PLAYCHAIN_5_TIME)
+    if (!d.hardforks().playchain_5)
     {
         return update_room_rating_simple_impl(d);
     }
@@ -55,9 +55,9 @@ int64_t get_database_entropy(const database &d)
     auto block_num = props.last_irreversible_block_num;
     if (block_num < 1)
         block_num = props.head_block_number;
-    auto pblock = d.fetch_block_by_number(block_num);
-    if (pblock.valid())
-        h = pblock->id();
+    auto pheader = d.fetch_block_header_by_number(block_num);
+    if (pheader.valid())
+        h = pheader->id();
     else
         h = fc::ripemd160::hash(d.get_chain_id());
 
@@ -44,6 +44,23 @@ void game_result_check_operation::validate() const
     FC_ASSERT( table != PLAYCHAIN_NULL_TABLE );
 }
 
+void game_votes_check_operation::validate() const
+{
+    FC_ASSERT( !account_object::is_special_account(voter) );
+    FC_ASSERT( !votes.empty() );
+    FC_ASSERT( votes.size() <= PLAYCHAIN_MAX_SIZE_FOR_GAME_VOTES_PER_OP );
+    for (const auto &vote: votes)
+    {
+        FC_ASSERT( vote.first != PLAYCHAIN_NULL_TABLE );
+        FC_ASSERT( !account_object::is_special_account(vote.second.table_owner) );
+        if (vote.second.data.which() == voting_data_type::tag<game_initial_data>::value)
+        {
+            const auto &initial_data = vote.second.data.get<game_initial_data>();
+            FC_ASSERT( initial_data.cash.empty() || initial_data.cash.size() >= 2u );
+        }
+    }
+}
+
 void game_reset_operation::validate() const
 {
     FC_ASSERT( !account_object::is_special_account(table_owner) );
@@ -52,4 +52,10 @@ void tables_alive_operation::validate() const
         FC_ASSERT( table != PLAYCHAIN_NULL_TABLE );
     }
 }
+
+void room_alive_operation::validate() const
+{
+    FC_ASSERT( !account_object::is_special_account(owner) );
+    FC_ASSERT( room != PLAYCHAIN_NULL_ROOM );
+}
 }}
@@ -0,0 +1,180 @@
+/*
+* Copyright (c) 2018 Total Games LLC and contributors.
+*
+* The MIT License
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <playchain/chain/schema/interned_string.hpp>
+
+#include <fc/crypto/city.hpp>
+
+#include <tuple>
+
+namespace playchain { namespace chain {
+
+namespace
+{
+    uint64_t symbol_hash(const std::string &str)
+    {
+        return fc::city_hash64(str.data(), str.size());
+    }
+
+    interned_string_table *&current_table()
+    {
+        static thread_local interned_string_table *table = nullptr;
+        return table;
+    }
+
+    interned_string_table &process_table()
+    {
+        static std::shared_ptr<interned_string_table> table = interned_string_table::create();
+        return *table;
+    }
+}
+
+interned_string::symbol *interned_string::empty_symbol()
+{
+    static symbol empty(std::piecewise_construct,
+                        std::forward_as_tuple(),
+                        std::forward_as_tuple(symbol_hash(std::string()), nullptr));
+    return &empty;
+}
+
+void interned_string::release()
+{
+    if (_symbol == empty_symbol())
+        return;
+
+    //the other handles only copy the symbol, so it is not the last reference
+    size_t refs = _symbol->second.refs.load(std::memory_order_relaxed);
+    while (refs > 1)
+    {
+        if (_symbol->second.refs.compare_exchange_weak(refs, refs - 1, std::memory_order_acq_rel))
+            return;
+    }
+
+    _symbol->second.table->release(_symbol);
+}
+
+interned_string::interned_string(): _symbol(empty_symbol())
+{
+}
+
+interned_string::interned_string(const std::string &str): _symbol(interned_string_table::current().intern_symbol(str))
+{
+}
+
+interned_string &interned_string::operator=(const std::string &str)
+{
+    symbol *s = interned_string_table::current().intern_symbol(str);
+    release();
+    _symbol = s;
+    return *this;
+}
+
+std::shared_ptr<interned_string_table> interned_string_table::create()
+{
+    return std::shared_ptr<interned_string_table>(new interned_string_table());
+}
+
+interned_string::symbol *interned_string_table::intern_symbol(const std::string &str)
+{
+    if (str.empty())
+        return interned_string::empty_symbol();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _symbols.find(str);
+    if (_symbols.end() == it)
+    {
+        it = _symbols.emplace(std::piecewise_construct,
+                              std::forward_as_tuple(str),
+                              std::forward_as_tuple(symbol_hash(str), shared_from_this())).first;
+    }
+    it->second.refs.fetch_add(1, std::memory_order_relaxed);
+    return &*it;
+}
+
+void interned_string_table::release(interned_string::symbol *s)
+{
+    //the symbol may hold the last reference to the table, it is dropped after the lock
+    std::shared_ptr<interned_string_table> self;
+
+    //the last reference can only be taken again by intern or find under the lock
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (s->second.refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        self = std::move(s->second.table);
+        _symbols.erase(_symbols.find(s->first));
+    }
+}
+
+interned_string interned_string_table::intern(const std::string &str)
+{
+    return interned_string(intern_symbol(str));
+}
+
+fc::optional<interned_string> interned_string_table::find(const std::string &str)
+{
+    if (str.empty())
+        return interned_string();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _symbols.find(str);
+    if (_symbols.end() == it)
+        return {};
+    it->second.refs.fetch_add(1, std::memory_order_relaxed);
+    return interned_string(&*it);
+}
+
+size_t interned_string_table::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _symbols.size();
+}
+
+interned_string_table &interned_string_table::current()
+{
+    interned_string_table *table = current_table();
+    return table ? *table : process_table();
+}
+
+interned_string_table::scope::scope(interned_string_table &table): _previous(current_table())
+{
+    current_table() = &table;
+}
+
+interned_string_table::scope::~scope()
+{
+    current_table() = _previous;
+}
+}}
+
+namespace fc {
+    void to_variant(const playchain::chain::interned_string &s, fc::variant &var, uint32_t max_depth)
+    {
+        var = s.str();
+    }
+
+    void from_variant(const fc::variant &var, playchain::chain::interned_string &s, uint32_t max_depth)
+    {
+        s = var.as_string();
+    }
+}
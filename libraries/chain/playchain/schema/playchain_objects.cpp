@@ -33,6 +33,8 @@
 
 #include <graphene/chain/database.hpp>
 
+#include <algorithm>
+
 namespace playchain { namespace chain {
 
     bool player_object::is_special_player(const player_id_type &id)
@@ -97,4 +99,40 @@ namespace playchain { namespace chain {
         witnesses(witnesses)
     {
     }
+
+    bool player_pending_fee_data::is_same_destination(const player_pending_fee_data &other) const
+    {
+        return room == other.room &&
+               getter == other.getter &&
+               asset_id == other.asset_id &&
+               witnesses == other.witnesses &&
+               metadata == other.metadata;
+    }
+
+    void player_object::aggregate_pending_fee(const player_pending_fee_data &fee)
+    {
+        //the fees collected before the aggregation are disseminated as rakes too
+        if (pending_rakes.empty())
+        {
+            for (size_t ci = 0; ci < pending_fees.size(); ++ci)
+            {
+                pending_rakes.emplace_back(player_pending_rake{(uint32_t)ci, pending_fees[ci].amount});
+            }
+        }
+
+        auto it = std::find_if(begin(pending_fees), end(pending_fees),
+                               [&fee](const player_pending_fee_data &data)
+        {
+            return data.is_same_destination(fee);
+        });
+        if (it != end(pending_fees))
+        {
+            it->amount += fee.amount;
+        }else
+        {
+            it = pending_fees.emplace(it, fee);
+        }
+
+        pending_rakes.emplace_back(player_pending_rake{(uint32_t)std::distance(begin(pending_fees), it), fee.amount});
+    }
 }}
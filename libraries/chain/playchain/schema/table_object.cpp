@@ -36,6 +36,7 @@
 #include <graphene/chain/hardfork.hpp>
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 
 namespace playchain { namespace chain {
@@ -60,7 +61,7 @@ bool table_object::is_valid_voter(const database &d, const game_result_check_ope
 
 void table_object::set_weight(database &d) const
 {
-    if (d.head_block_time() >= HARDFORK_PLAYCHAIN_2_TIME)
+    if (d.hardforks().playchain_2)
     {
         auto new_weight = room(d).rating;
 
@@ -281,34 +282,53 @@ void table_owner_index::object_removed( const object& obj )
     }
 }
 
+uint64_t table_owner_index::get_memory_usage()const
+{
+    return estimate_dynamic_memory_usage(tables_by_owner) + estimate_dynamic_memory_usage(rooms_owners);
+}
+
 table_players_index::table_players_index(const database& db): _db(db)
 {}
 
 table_players_index::~table_players_index()
 {}
 
-table_players_index::player_set_type  table_players_index::get_pending_proposals( const table_object& table )const
+namespace
 {
-    player_set_type result;
-    for( auto item : table.pending_proposals )
-       result.emplace(item.first);
-    return result;
+    //the seats are ordered by players, so are the results
+    template<typename SeatsType, typename PlayersType>
+    void get_players( const SeatsType &seats, PlayersType &result )
+    {
+        result.clear();
+        result.reserve(seats.size());
+        for( const auto &item : seats )
+           result.push_back(item.first);
+    }
 }
 
-table_players_index::player_set_type table_players_index::get_cash( const table_object& table )const
+void table_players_index::update_tables_by_player( block_arena &arena,
+                                                   flat_map< player_id_type, tables_type > &tables_by_player,
+                                                   const players_type &before,
+                                                   const block_vector<player_id_type> &after,
+                                                   const table_id_type &table )
 {
-    player_set_type result;
-    for( auto item : table.cash )
-       result.emplace(item.first);
-    return result;
-}
+    block_vector<player_id_type> changed(arena);
+    changed.reserve(std::max(before.size(), after.size()));
 
-table_players_index::player_set_type table_players_index::get_playing_cash( const table_object& table )const
-{
-    player_set_type result;
-    for( auto item : table.playing_cash )
-       result.emplace(item.first);
-    return result;
+    std::set_difference(before.begin(), before.end(),
+                        after.begin(), after.end(),
+                        std::back_inserter(changed));
+
+    for( const auto &player : changed )
+       tables_by_player[player].erase(table);
+
+    changed.clear();
+    std::set_difference(after.begin(), after.end(),
+                        before.begin(), before.end(),
+                        std::back_inserter(changed));
+
+    for( const auto &player : changed )
+       tables_by_player[player].emplace(table);
 }
 
 void table_players_index::about_to_modify( const object& before )
@@ -316,75 +336,37 @@ void table_players_index::about_to_modify( const object& before )
     assert( dynamic_cast<const table_object*>(&before) );
     const table_object& table = static_cast<const table_object&>(before);
 
-    before_pending_proposals = get_pending_proposals(table);
-    before_cash = get_cash(table);
-    before_playing_cash = get_playing_cash(table);
+    //the vectors keep their capacity from one modification to another
+    get_players(table.pending_proposals, before_pending_proposals);
+    get_players(table.cash, before_cash);
+    get_players(table.playing_cash, before_playing_cash);
 }
 
 void table_players_index::object_modified( const object& after )
 {
     assert( dynamic_cast<const table_object*>(&after) );
     const table_object& table = static_cast<const table_object&>(after);
+    const table_id_type table_id = table.id;
 
-    {
-       player_set_type after_players = get_pending_proposals(table);
-       vector<player_id_type> removed;
-       removed.reserve(before_pending_proposals.size());
-       std::set_difference(before_pending_proposals.begin(), before_pending_proposals.end(),
-                           after_players.begin(), after_players.end(),
-                           std::inserter(removed, removed.end()));
-
-       for( auto itr = removed.begin(); itr != removed.end(); ++itr )
-          tables_with_pending_proposals_by_player[*itr].erase(after.id);
-
-       vector<object_id_type> added; added.reserve(after_players.size());
-       std::set_difference(after_players.begin(), after_players.end(),
-                           before_pending_proposals.begin(), before_pending_proposals.end(),
-                           std::inserter(added, added.end()));
-
-       for( auto itr = added.begin(); itr != added.end(); ++itr )
-          tables_with_pending_proposals_by_player[*itr].emplace(after.id);
-    }
+    //the arena is used while a block is applied, the pending transactions and the undo take the heap
+    block_arena &arena = _db.get_block_arena();
+    block_vector<player_id_type> after_players(arena);
 
-    {
-       player_set_type after_players = get_cash(table);
-       vector<player_id_type> removed;
-       removed.reserve(before_cash.size());
-       std::set_difference(before_cash.begin(), before_cash.end(),
-                           after_players.begin(), after_players.end(),
-                           std::inserter(removed, removed.end()));
-
-       for( auto itr = removed.begin(); itr != removed.end(); ++itr )
-          tables_with_cash_by_player[*itr].erase(after.id);
-
-       vector<object_id_type> added; added.reserve(after_players.size());
-       std::set_difference(after_players.begin(), after_players.end(),
-                           before_cash.begin(), before_cash.end(),
-                           std::inserter(added, added.end()));
-
-       for( auto itr = added.begin(); itr != added.end(); ++itr )
-          tables_with_cash_by_player[*itr].emplace(after.id);
-    }
+    get_players(table.pending_proposals, after_players);
+    update_tables_by_player(arena, tables_with_pending_proposals_by_player, before_pending_proposals, after_players, table_id);
 
-    {
-       player_set_type after_players = get_playing_cash(table);
-       vector<player_id_type> removed;
-       removed.reserve(before_playing_cash.size());
-       std::set_difference(before_playing_cash.begin(), before_playing_cash.end(),
-                           after_players.begin(), after_players.end(),
-                           std::inserter(removed, removed.end()));
-
-       for( auto itr = removed.begin(); itr != removed.end(); ++itr )
-          tables_with_playing_cash_by_player[*itr].erase(after.id);
-
-       vector<object_id_type> added; added.reserve(after_players.size());
-       std::set_difference(after_players.begin(), after_players.end(),
-                           before_playing_cash.begin(), before_playing_cash.end(),
-                           std::inserter(added, added.end()));
-
-       for( auto itr = added.begin(); itr != added.end(); ++itr )
-          tables_with_playing_cash_by_player[*itr].emplace(after.id);
-    }
+    get_players(table.cash, after_players);
+    update_tables_by_player(arena, tables_with_cash_by_player, before_cash, after_players, table_id);
+
+    get_players(table.playing_cash, after_players);
+    update_tables_by_player(arena, tables_with_playing_cash_by_player, before_playing_cash, after_players, table_id);
+}
+
+uint64_t table_players_index::get_memory_usage()const
+{
+    return estimate_dynamic_memory_usage(tables_with_pending_proposals_by_player)
+         + estimate_dynamic_memory_usage(tables_with_cash_by_player)
+         + estimate_dynamic_memory_usage(tables_with_playing_cash_by_player);
 }
 
 table_voting_statistics_index::table_voting_statistics_index(const database& db): _db(db)
@@ -428,4 +410,10 @@ void table_voting_statistics_index::object_removed( const object& obj )
     not_voted_last_time_players_by_table[table_voting.table] = std::move(missed);
     voted_last_time_players_by_table[table_voting.table] = std::move(votes);
 }
+
+uint64_t table_voting_statistics_index::get_memory_usage()const
+{
+    return estimate_dynamic_memory_usage(voted_last_time_players_by_table)
+         + estimate_dynamic_memory_usage(not_voted_last_time_players_by_table);
+}
 }}
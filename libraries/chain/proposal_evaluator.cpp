@@ -109,6 +109,12 @@ struct proposal_operation_hardfork_visitor
    void operator()(const graphene::chain::htlc_extend_operation &op) const {
       FC_ASSERT( block_time >= HARDFORK_CORE_1468_TIME, "Not allowed until hardfork 1468" );
    }
+   void operator()(const playchain::chain::room_alive_operation &op) const {
+      FC_ASSERT( block_time >= HARDFORK_PLAYCHAIN_12_TIME, "Not allowed until hardfork playchain-12" );
+   }
+   void operator()(const playchain::chain::game_votes_check_operation &op) const {
+      FC_ASSERT( block_time >= HARDFORK_PLAYCHAIN_13_TIME, "Not allowed until hardfork playchain-13" );
+   }
    // loop and self visit in proposals
    void operator()(const graphene::chain::proposal_create_operation &v) const {
       bool already_contains_proposal_update = false;
@@ -29,16 +29,34 @@ namespace graphene { namespace chain {
 
 bool proposal_object::is_authorized_to_execute(database& db) const
 {
-   transaction_evaluation_state dry_run_eval(&db);
+   const uint64_t authority_revision = db.account_authority_revision();
+   const uint8_t max_authority_depth = db.get_global_properties().parameters.max_authority_depth;
+   const bool allow_non_immediate_owner = ( db.hardforks().core_584 );
 
+   if( _authorization_cache.valid()
+       && _authorization_cache->authority_revision == authority_revision
+       && _authorization_cache->max_authority_depth == max_authority_depth
+       && _authorization_cache->allow_non_immediate_owner == allow_non_immediate_owner )
+      return _authorization_cache->authorized;
+
+   authorization_cache cache;
+   cache.authority_revision = authority_revision;
+   cache.max_authority_depth = max_authority_depth;
+   cache.allow_non_immediate_owner = allow_non_immediate_owner;
+   cache.authorized = check_authorization( db, max_authority_depth, allow_non_immediate_owner );
+   _authorization_cache = cache;
+   return cache.authorized;
+}
+
+bool proposal_object::check_authorization(database& db, uint8_t max_authority_depth, bool allow_non_immediate_owner) const
+{
    try {
-      bool allow_non_immediate_owner = ( db.head_block_time() >= HARDFORK_CORE_584_TIME );
       verify_authority( proposed_transaction.operations, 
                         available_key_approvals,
                         [&]( account_id_type id ){ return &id(db).active; },
                         [&]( account_id_type id ){ return &id(db).owner;  },
                         allow_non_immediate_owner,
-                        db.get_global_properties().parameters.max_authority_depth,
+                        max_authority_depth,
                         true, /* allow committeee */
                         available_active_approvals,
                         available_owner_approvals );
@@ -127,8 +145,14 @@ void required_approval_index::about_to_modify( const object& before )
 void required_approval_index::object_modified( const object& after )
 {
     const proposal_object& p = static_cast<const proposal_object&>(after);
+    p.reset_authorization_cache();
     insert_or_remove_delta( p.id, available_active_before_modify, p.available_active_approvals );
     insert_or_remove_delta( p.id, available_owner_before_modify,  p.available_owner_approvals );
 }
 
+uint64_t required_approval_index::get_memory_usage()const
+{
+    return estimate_dynamic_memory_usage( _account_to_proposals );
+}
+
 } } // graphene::chain
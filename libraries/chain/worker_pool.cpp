@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/chain/worker_pool.hpp>
+
+#include <algorithm>
+
+namespace graphene { namespace chain {
+
+worker_pool::worker_pool( uint32_t num_threads )
+{
+   if( num_threads == 0 )
+      num_threads = std::max( std::thread::hardware_concurrency(), 1u );
+   _threads.reserve( num_threads );
+   for( uint32_t i = 0; i < num_threads; ++i )
+      _threads.emplace_back( [this] () { run(); } );
+}
+
+worker_pool::~worker_pool()
+{
+   {
+      std::lock_guard<std::mutex> guard( _mutex );
+      _stopped = true;
+   }
+   _ready.notify_all();
+   for( auto& t : _threads )
+      t.join();
+}
+
+std::future<void> worker_pool::post( std::function<void()> task )
+{
+   std::packaged_task<void()> packaged( std::move( task ) );
+   std::future<void> result = packaged.get_future();
+   {
+      std::lock_guard<std::mutex> guard( _mutex );
+      _tasks.push_back( std::move( packaged ) );
+   }
+   _ready.notify_one();
+   return result;
+}
+
+void worker_pool::run()
+{
+   while( true )
+   {
+      std::packaged_task<void()> task;
+      {
+         std::unique_lock<std::mutex> lock( _mutex );
+         _ready.wait( lock, [this] () { return _stopped || !_tasks.empty(); } );
+         // the posted tasks are finished before the threads stop, their futures are always satisfied
+         if( _tasks.empty() )
+            return;
+         task = std::move( _tasks.front() );
+         _tasks.pop_front();
+      }
+      task();
+   }
+}
+
+} } // graphene::chain
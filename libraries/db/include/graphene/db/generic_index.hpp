@@ -27,6 +27,7 @@
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
+#include <boost/mpl/size.hpp>
 
 namespace graphene { namespace chain {
 
@@ -125,6 +126,13 @@ namespace graphene { namespace chain {
 
          const index_type& indices()const { return _indices; }
 
+         /** @return estimated memory used by the nodes of all views of the container (each view adds a tree node) */
+         uint64_t get_container_memory_usage()const
+         {
+            static const uint64_t views = boost::mpl::size< typename index_type::index_type_list >::value;
+            return _indices.size() * views * 4 * sizeof( void* );
+         }
+
          virtual fc::uint128 hash()const override {
             fc::uint128 result;
             for( const auto& ptr : _indices )
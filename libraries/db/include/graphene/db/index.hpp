@@ -23,11 +23,13 @@
  */
 #pragma once
 #include <graphene/db/object.hpp>
+#include <graphene/db/memory_usage.hpp>
 
 #include <fc/interprocess/file_mapping.hpp>
 #include <fc/io/raw.hpp>
 #include <fc/io/json.hpp>
 #include <fc/crypto/sha256.hpp>
+#include <fc/log/logger.hpp>
 
 #include <fstream>
 #include <stack>
@@ -138,6 +140,11 @@ namespace graphene { namespace db {
 
          virtual void               object_from_variant( const fc::variant& var, object& obj, uint32_t max_depth )const = 0;
          virtual void               object_default( object& obj )const = 0;
+
+         /** @return estimated memory used by the objects, the container and the secondary indexes */
+         virtual index_memory_usage get_memory_usage()const = 0;
+         /** @return estimated memory used by obj including its dynamic members */
+         virtual uint64_t           get_object_memory_usage( const object& obj )const = 0;
    };
 
    class secondary_index
@@ -148,6 +155,9 @@ namespace graphene { namespace db {
          virtual void object_removed( const object& obj ){};
          virtual void about_to_modify( const object& before ){};
          virtual void object_modified( const object& after  ){};
+
+         /** @return estimated heap memory used by the index structures */
+         virtual uint64_t get_memory_usage()const { return 0; }
    };
 
    /**
@@ -177,6 +187,23 @@ namespace graphene { namespace db {
             return static_cast<T*>(_sindex.back().get());
          }
 
+         /**
+          *  Stops passing the created objects to the secondary indexes (besides the direct index used
+          *  by find()) to speed up bulk loading. The objects created in between must not be modified
+          *  or removed until end_deferred_secondary_indexes() passes all of them at once.
+          */
+         virtual void begin_deferred_secondary_indexes() = 0;
+         virtual void end_deferred_secondary_indexes() = 0;
+
+         /** @return estimated memory used by all secondary indexes */
+         uint64_t get_secondary_indexes_memory_usage()const
+         {
+            uint64_t result = 0;
+            for( const auto& item : _sindex )
+               result += item->get_memory_usage();
+            return result;
+         }
+
          template<typename T>
          const T& get_secondary_index()const
          {
@@ -196,6 +223,36 @@ namespace graphene { namespace db {
          object_database& _db;
    };
 
+   /**
+    *  Defers the secondary indexes of the index while it lives, the objects created in between are passed
+    *  to them when it is destroyed, also when the bulk load throws.
+    */
+   class deferred_secondary_indexes_scope
+   {
+      public:
+         explicit deferred_secondary_indexes_scope( base_primary_index& index ): _index( index )
+         {
+            _index.begin_deferred_secondary_indexes();
+         }
+         ~deferred_secondary_indexes_scope()
+         {
+            try {
+               _index.end_deferred_secondary_indexes();
+            }
+            catch ( const fc::exception& e )
+            {
+               elog( "${e}", ("e",e.to_detail_string() ) );
+               std::terminate();
+            }
+         }
+
+         deferred_secondary_indexes_scope( const deferred_secondary_indexes_scope& ) = delete;
+         deferred_secondary_indexes_scope& operator=( const deferred_secondary_indexes_scope& ) = delete;
+
+      private:
+         base_primary_index& _index;
+   };
+
    /** @class direct_index
     *  @brief A secondary index that tracks objects in vectors indexed by object
     *  id. It is meant for fully (or almost fully) populated indexes only (will
@@ -276,6 +333,14 @@ namespace graphene { namespace db {
             ids_being_modified.pop();
          }
 
+         virtual uint64_t get_memory_usage()const override
+         {
+            uint64_t result = content.capacity() * sizeof( vector< const Object* > );
+            for( const auto& chunk : content )
+               result += chunk.capacity() * sizeof( const Object* );
+            return result;
+         }
+
          template< typename object_id >
          const Object* find( const object_id& id )const
          {
@@ -383,8 +448,7 @@ namespace graphene { namespace db {
          virtual const object&  load( const std::vector<char>& data )override
          {
             const auto& result = DerivedIndex::insert( fc::raw::unpack<object_type>( data ) );
-            for( const auto& item : _sindex )
-               item->object_inserted( result );
+            notify_object_inserted( result );
             return result;
          }
 
@@ -392,8 +456,7 @@ namespace graphene { namespace db {
          virtual const object&  create(const std::function<void(object&)>& constructor )override
          {
             const auto& result = DerivedIndex::create( constructor );
-            for( const auto& item : _sindex )
-               item->object_inserted( result );
+            notify_object_inserted( result );
             on_add( result );
             return result;
          }
@@ -401,14 +464,14 @@ namespace graphene { namespace db {
          virtual const object& insert( object&& obj ) override
          {
             const auto& result = DerivedIndex::insert( std::move( obj ) );
-            for( const auto& item : _sindex )
-               item->object_inserted( result );
+            notify_object_inserted( result );
             on_add( result );
             return result;
          }
 
          virtual void  remove( const object& obj ) override
          {
+            FC_ASSERT( !is_deferred( obj ), "Object is not passed to the secondary indexes yet" );
             for( const auto& item : _sindex )
                item->object_removed( obj );
             on_remove(obj);
@@ -417,6 +480,7 @@ namespace graphene { namespace db {
 
          virtual void modify( const object& obj, const std::function<void(object&)>& m )override
          {
+            FC_ASSERT( !is_deferred( obj ), "Object is not passed to the secondary indexes yet" );
             save_undo( obj );
             for( const auto& item : _sindex )
                item->about_to_modify( obj );
@@ -426,6 +490,28 @@ namespace graphene { namespace db {
             on_modify( obj );
          }
 
+         virtual void begin_deferred_secondary_indexes() override
+         {
+            FC_ASSERT( !_secondary_indexes_deferred );
+            _secondary_indexes_deferred = true;
+            _deferred_from = _next_id;
+         }
+
+         virtual void end_deferred_secondary_indexes() override
+         {
+            FC_ASSERT( _secondary_indexes_deferred );
+            _secondary_indexes_deferred = false;
+            for( uint64_t instance = _deferred_from.instance(); instance < _next_id.instance(); ++instance )
+            {
+               const object* obj = find( object_id_type( object_type::space_id, object_type::type_id, instance ) );
+               if( obj == nullptr )
+                  continue;
+               for( const auto& item : _sindex )
+                  if( item.get() != _direct_by_id )
+                     item->object_inserted( *obj );
+            }
+         }
+
          virtual void add_observer( const shared_ptr<index_observer>& o ) override
          {
             _observers.emplace_back( o );
@@ -449,9 +535,45 @@ namespace graphene { namespace db {
             obj.id = id;
          }
 
+         virtual index_memory_usage get_memory_usage()const override
+         {
+            index_memory_usage result;
+            result.space_id = object_type::space_id;
+            result.type_id = object_type::type_id;
+            this->inspect_all_objects( [&]( const object& o ) {
+               ++result.object_count;
+               result.dynamic_bytes += estimate_dynamic_memory_usage( static_cast<const object_type&>(o) );
+            });
+            result.object_bytes = result.object_count * sizeof( object_type );
+            result.container_bytes = DerivedIndex::get_container_memory_usage();
+            result.secondary_index_bytes = get_secondary_indexes_memory_usage();
+            return result;
+         }
+
+         virtual uint64_t get_object_memory_usage( const object& obj )const override
+         {
+            const object_type* o = dynamic_cast<const object_type*>( &obj );
+            FC_ASSERT( o != nullptr );
+            return sizeof( object_type ) + estimate_dynamic_memory_usage( *o );
+         }
+
       private:
+         void notify_object_inserted( const object& obj )
+         {
+            for( const auto& item : _sindex )
+               if( !_secondary_indexes_deferred || item.get() == _direct_by_id )
+                  item->object_inserted( obj );
+         }
+
+         bool is_deferred( const object& obj )const
+         {
+            return _secondary_indexes_deferred && !( obj.id < _deferred_from );
+         }
+
          object_id_type                                 _next_id;
          const direct_index< object_type, DirectBits >* _direct_by_id = nullptr;
+         bool                                           _secondary_indexes_deferred = false;
+         object_id_type                                 _deferred_from;
    };
 
 } } // graphene::db
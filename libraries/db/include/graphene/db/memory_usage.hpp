@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <fc/reflect/reflect.hpp>
+#include <fc/optional.hpp>
+#include <fc/static_variant.hpp>
+#include <fc/container/flat_fwd.hpp>
+
+#include <boost/container/flat_map.hpp>
+#include <boost/container/flat_set.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 106600 // boost ver. >= 1.66.0
+#include <boost/container/small_vector.hpp>
+#endif
+
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace graphene { namespace db {
+
+   /**
+    *  @brief estimated memory consumed by a single (space, type) index of the object_database
+    *
+    *  All byte counts are estimations: the sizes of the heap blocks are derived from container
+    *  capacities and typical node layouts, allocator bookkeeping is not included.
+    */
+   struct index_memory_usage
+   {
+      uint8_t  space_id = 0;
+      uint8_t  type_id = 0;
+      /// number of objects in the index
+      uint64_t object_count = 0;
+      /// sizeof(object_type) of all objects
+      uint64_t object_bytes = 0;
+      /// heap memory owned by the members of the objects (strings, vectors, maps...)
+      uint64_t dynamic_bytes = 0;
+      /// nodes, buckets and pointers of the primary container
+      uint64_t container_bytes = 0;
+      /// memory of all secondary indexes attached to the index
+      uint64_t secondary_index_bytes = 0;
+      /// number of entries of the index saved in the undo stack
+      uint64_t undo_entries = 0;
+      /// memory of the object copies saved in the undo stack
+      uint64_t undo_bytes = 0;
+
+      uint64_t total_bytes()const
+      {
+         return object_bytes + dynamic_bytes + container_bytes + secondary_index_bytes + undo_bytes;
+      }
+   };
+
+   namespace memory_usage_detail {
+
+      /// estimated size of a node of the node based standard containers (besides the value)
+      static const uint64_t tree_node_overhead = 4 * sizeof(void*);
+      static const uint64_t hash_node_overhead = 2 * sizeof(void*);
+
+      template<typename T, typename Enable = void>
+      struct dynamic_memory_usage
+      {
+         static uint64_t get( const T& ) { return 0; }
+      };
+
+      template<typename T>
+      uint64_t get_dynamic_memory_usage( const T& v )
+      {
+         return dynamic_memory_usage<T>::get( v );
+      }
+
+      template<typename Container>
+      uint64_t get_elements_dynamic_memory_usage( const Container& c )
+      {
+         uint64_t result = 0;
+         for( const auto& item : c )
+            result += get_dynamic_memory_usage( item );
+         return result;
+      }
+
+      template<typename Class>
+      struct dynamic_memory_usage_visitor
+      {
+         dynamic_memory_usage_visitor( const Class& obj, uint64_t& result ): _obj( obj ), _result( result ) {}
+
+         template<typename Member, class C, Member (C::*member)>
+         void operator()( const char* )const
+         {
+            _result += get_dynamic_memory_usage( _obj.*member );
+         }
+
+         const Class& _obj;
+         uint64_t&    _result;
+      };
+
+      struct static_variant_memory_usage_visitor
+      {
+         typedef uint64_t result_type;
+
+         template<typename Member>
+         uint64_t operator()( const Member& m )const { return get_dynamic_memory_usage( m ); }
+      };
+
+      template<typename T>
+      struct dynamic_memory_usage<T, typename std::enable_if< fc::reflector<T>::is_defined::value
+                                                              && !std::is_enum<T>::value >::type>
+      {
+         static uint64_t get( const T& v )
+         {
+            uint64_t result = 0;
+            fc::reflector<T>::visit( dynamic_memory_usage_visitor<T>( v, result ) );
+            return result;
+         }
+      };
+
+      template<typename... Args>
+      struct dynamic_memory_usage< std::basic_string<Args...> >
+      {
+         static uint64_t get( const std::basic_string<Args...>& s )
+         {
+            // short strings are stored inside of the string object itself
+            if( s.capacity() < sizeof(std::basic_string<Args...>) )
+               return 0;
+            return s.capacity() + 1;
+         }
+      };
+
+      template<typename A, typename B>
+      struct dynamic_memory_usage< std::pair<A, B> >
+      {
+         static uint64_t get( const std::pair<A, B>& p )
+         {
+            return get_dynamic_memory_usage( p.first ) + get_dynamic_memory_usage( p.second );
+         }
+      };
+
+      template<typename T>
+      struct dynamic_memory_usage< fc::optional<T> >
+      {
+         static uint64_t get( const fc::optional<T>& o )
+         {
+            return o.valid() ? get_dynamic_memory_usage( *o ) : 0;
+         }
+      };
+
+      template<typename... Types>
+      struct dynamic_memory_usage< fc::static_variant<Types...> >
+      {
+         static uint64_t get( const fc::static_variant<Types...>& v )
+         {
+            return v.visit( static_variant_memory_usage_visitor() );
+         }
+      };
+
+      template<typename Container>
+      struct contiguous_memory_usage
+      {
+         static uint64_t get( const Container& c )
+         {
+            return c.capacity() * sizeof(typename Container::value_type) + get_elements_dynamic_memory_usage( c );
+         }
+      };
+
+      template<typename Container>
+      struct node_memory_usage
+      {
+         static uint64_t get( const Container& c )
+         {
+            return c.size() * ( sizeof(typename Container::value_type) + tree_node_overhead )
+                   + get_elements_dynamic_memory_usage( c );
+         }
+      };
+
+      template<typename Container>
+      struct hashed_memory_usage
+      {
+         static uint64_t get( const Container& c )
+         {
+            return c.size() * ( sizeof(typename Container::value_type) + hash_node_overhead )
+                   + c.bucket_count() * sizeof(void*)
+                   + get_elements_dynamic_memory_usage( c );
+         }
+      };
+
+      template<typename... Args>
+      struct dynamic_memory_usage< std::vector<Args...> >: contiguous_memory_usage< std::vector<Args...> > {};
+      template<typename... Args>
+      struct dynamic_memory_usage< boost::container::flat_map<Args...> >: contiguous_memory_usage< boost::container::flat_map<Args...> > {};
+      template<typename... Args>
+      struct dynamic_memory_usage< boost::container::flat_set<Args...> >: contiguous_memory_usage< boost::container::flat_set<Args...> > {};
+
+#if BOOST_VERSION >= 106600
+      /// flat maps on top of small vectors keep the first N elements inside of the map object
+      template<typename K, typename V, typename C, typename T, std::size_t N, typename... A>
+      struct dynamic_memory_usage< boost::container::flat_map<K, V, C, boost::container::small_vector<T, N, A...>> >
+      {
+         static uint64_t get( const boost::container::flat_map<K, V, C, boost::container::small_vector<T, N, A...>>& c )
+         {
+            return ( c.capacity() > N ? c.capacity() * sizeof(T) : 0 ) + get_elements_dynamic_memory_usage( c );
+         }
+      };
+#endif
+
+      template<typename... Args>
+      struct dynamic_memory_usage< std::deque<Args...> >: node_memory_usage< std::deque<Args...> > {};
+      template<typename... Args>
+      struct dynamic_memory_usage< std::map<Args...> >: node_memory_usage< std::map<Args...> > {};
+      template<typename... Args>
+      struct dynamic_memory_usage< std::multimap<Args...> >: node_memory_usage< std::multimap<Args...> > {};
+      template<typename... Args>
+      struct dynamic_memory_usage< std::set<Args...> >: node_memory_usage< std::set<Args...> > {};
+      template<typename... Args>
+      struct dynamic_memory_usage< std::multiset<Args...> >: node_memory_usage< std::multiset<Args...> > {};
+
+      template<typename... Args>
+      struct dynamic_memory_usage< std::unordered_map<Args...> >: hashed_memory_usage< std::unordered_map<Args...> > {};
+      template<typename... Args>
+      struct dynamic_memory_usage< std::unordered_set<Args...> >: hashed_memory_usage< std::unordered_set<Args...> > {};
+
+   } // memory_usage_detail
+
+   /**
+    *  @brief estimates the heap memory owned by v, i.e. the memory not included into sizeof(T)
+    *
+    *  Reflected types are inspected member by member, standard and flat containers account for
+    *  their storage and for the heap memory of their elements. Everything else is considered
+    *  to have no dynamic members.
+    */
+   template<typename T>
+   uint64_t estimate_dynamic_memory_usage( const T& v )
+   {
+      return memory_usage_detail::get_dynamic_memory_usage( v );
+   }
+
+} } // graphene::db
+
+FC_REFLECT( graphene::db::index_memory_usage,
+            (space_id)(type_id)(object_count)(object_bytes)(dynamic_bytes)(container_bytes)
+            (secondary_index_bytes)(undo_entries)(undo_bytes) )
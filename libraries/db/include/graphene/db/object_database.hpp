@@ -147,6 +147,12 @@ namespace graphene { namespace db {
 
          void pop_undo();
 
+         /**
+          * Estimates the memory used by every index including the objects saved in the undo stack.
+          * This walks all objects, so it could take a while on a big database.
+          */
+         vector<index_memory_usage> get_memory_usage()const;
+
          fc::path get_data_dir()const { return _data_dir; }
 
          /** public for testing purposes only... should be private in practice. */
@@ -142,6 +142,8 @@ namespace graphene { namespace db {
          const_iterator end()const   { return const_iterator(_objects, _objects.end());   }
 
          size_t size()const { return _objects.size(); }
+
+         uint64_t get_container_memory_usage()const { return _objects.capacity() * sizeof( unique_ptr<object> ); }
       private:
          vector< unique_ptr<object> > _objects;
    };
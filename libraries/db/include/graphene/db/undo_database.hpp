@@ -24,6 +24,7 @@
 #pragma once
 #include <graphene/db/object.hpp>
 #include <deque>
+#include <functional>
 #include <fc/exception/exception.hpp>
 
 namespace graphene { namespace db {
@@ -123,6 +124,12 @@ namespace graphene { namespace db {
 
          const undo_state& head()const;
 
+         /**
+          *  Calls inspector for every entry of the undo stack. The saved object is passed for
+          *  modified and removed objects, nullptr for the ids of created objects.
+          */
+         void inspect_undo_entries( const std::function<void(object_id_type, const object*)>& inspector )const;
+
       private:
          void undo();
          void merge();
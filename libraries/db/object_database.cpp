@@ -113,6 +113,33 @@ void object_database::open(const fc::path& data_dir)
 } FC_CAPTURE_AND_RETHROW( (data_dir) ) }
 
 
+vector<index_memory_usage> object_database::get_memory_usage()const
+{ try {
+   vector<index_memory_usage> result;
+   std::map< std::pair<uint8_t, uint8_t>, size_t > positions;
+   for( uint32_t space = 0; space < _index.size(); ++space )
+      for( uint32_t type = 0; type < _index[space].size(); ++type )
+         if( _index[space][type] )
+         {
+            positions[ std::make_pair( uint8_t(space), uint8_t(type) ) ] = result.size();
+            result.push_back( _index[space][type]->get_memory_usage() );
+         }
+
+   _undo_db.inspect_undo_entries( [&]( object_id_type id, const object* saved ) {
+      auto itr = positions.find( std::make_pair( id.space(), id.type() ) );
+      if( itr == positions.end() )
+         return;
+      index_memory_usage& usage = result[itr->second];
+      ++usage.undo_entries;
+      usage.undo_bytes += sizeof( object_id_type ) + memory_usage_detail::hash_node_overhead;
+      if( saved != nullptr )
+         usage.undo_bytes += sizeof( unique_ptr<object> )
+                             + _index[id.space()][id.type()]->get_object_memory_usage( *saved );
+   });
+
+   return result;
+} FC_CAPTURE_AND_RETHROW() }
+
 void object_database::pop_undo()
 { try {
    _undo_db.pop_commit();
@@ -304,4 +304,17 @@ const undo_state& undo_database::head()const
    return _stack.back();
 }
 
+void undo_database::inspect_undo_entries( const std::function<void(object_id_type, const object*)>& inspector )const
+{
+   for( const auto& state : _stack )
+   {
+      for( const auto& item : state.old_values )
+         inspector( item.first, item.second.get() );
+      for( const auto& item : state.removed )
+         inspector( item.first, item.second.get() );
+      for( const auto& id : state.new_ids )
+         inspector( id, nullptr );
+   }
+}
+
 } } // graphene::db
@@ -71,6 +71,13 @@
  */
 #define GRAPHENE_NET_MESSAGE_CACHE_DURATION_IN_BLOCKS        5
 
+/**
+ * Items that are no longer in the message cache (e.g. blocks requested during
+ * sync) are fetched from the blockchain and packed once, then shared by every
+ * peer that requests them.  This is the memory budget for those packed items.
+ */
+#define GRAPHENE_NET_PACKED_ITEM_CACHE_SIZE_IN_BYTES         (64 * 1024 * 1024)
+
 /**
  * We prevent a peer from offering us a list of blocks which, if we fetched them
  * all, would result in a blockchain that extended into the future.
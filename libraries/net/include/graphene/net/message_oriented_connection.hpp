@@ -61,6 +61,10 @@ namespace graphene { namespace net {
        fc::time_point get_last_message_received_time() const;
        fc::time_point get_connection_time() const;
        fc::sha512     get_shared_secret() const;
+
+       /// messages read by the connections of the calling thread and how many of them had to grow the receive buffer
+       static uint64_t get_receive_buffers_acquired();
+       static uint64_t get_receive_buffers_allocated();
      private:
        std::unique_ptr<detail::message_oriented_connection_impl> my;
   };
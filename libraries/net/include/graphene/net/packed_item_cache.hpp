@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2018 Total Games LLC, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/net/core_messages.hpp>
+#include <graphene/net/message.hpp>
+
+#include <fc/variant_object.hpp>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index/tag.hpp>
+
+#include <memory>
+
+namespace graphene { namespace net {
+
+  /**
+   *  Items fetched from the delegate and packed for peers that requested them.
+   *  The packed messages are shared by all peers' send queues and fetch replies, so an item
+   *  requested by many peers (typically blocks during sync) is fetched and packed only once.
+   *  Least recently used items are dropped when the total packed size exceeds the budget.
+   */
+  class packed_item_cache
+  {
+  private:
+    struct item_id_index{};
+    struct entry
+    {
+      item_id                        item;
+      std::shared_ptr<const message> packed_message;
+    };
+    typedef boost::multi_index_container
+      < entry,
+          boost::multi_index::indexed_by< boost::multi_index::sequenced<>,
+                                          boost::multi_index::hashed_unique< boost::multi_index::tag<item_id_index>,
+                                                                             boost::multi_index::member<entry, item_id, &entry::item>,
+                                                                             std::hash<item_id> > >
+      > cache_container;
+
+    cache_container _cache;
+    size_t          _max_size_in_bytes;
+    size_t          _size_in_bytes = 0;
+
+    uint64_t        _hits = 0;
+    uint64_t        _misses = 0;
+    uint64_t        _bytes_saved = 0;
+
+  public:
+    packed_item_cache( size_t max_size_in_bytes ) :
+      _max_size_in_bytes( max_size_in_bytes )
+    {}
+    std::shared_ptr<const message> find( const item_id& item );
+    void insert( const item_id& item, const std::shared_ptr<const message>& packed_message );
+    fc::variant_object get_statistics() const;
+
+    size_t   size() const { return _cache.size(); }
+    size_t   size_in_bytes() const { return _size_in_bytes; }
+    uint64_t hits() const { return _hits; }
+    uint64_t misses() const { return _misses; }
+    /// bytes of the hits, which were not fetched from the delegate and packed again
+    uint64_t bytes_saved() const { return _bytes_saved; }
+  };
+
+} } // graphene::net
@@ -50,6 +50,15 @@ class stcp_socket : public virtual fc::iostream
     virtual size_t   writesome( const char* buffer, size_t len );
     virtual size_t   writesome( const std::shared_ptr<const char>& buf, size_t len, size_t offset );
 
+    /**
+     *  Encrypts and writes header followed by body, zero-padded to a multiple of 16 bytes.
+     *  The plaintext is gathered chunk by chunk into a reusable staging buffer, so the
+     *  caller doesn't have to assemble (and allocate) the padded message first.
+     *
+     *  @return number of bytes written including the padding
+     */
+    size_t           write_gathered( const char* header, size_t header_len, const char* body, size_t body_len );
+
     virtual void     flush();
     virtual void     close();
 
@@ -68,6 +77,7 @@ class stcp_socket : public virtual fc::iostream
     fc::aes_decoder      _recv_aes;
     std::shared_ptr<char> _read_buffer;
     std::shared_ptr<char> _write_buffer;
+    std::shared_ptr<char> _write_staging_buffer;
 #ifndef NDEBUG
     bool _read_buffer_in_use;
     bool _write_buffer_in_use;
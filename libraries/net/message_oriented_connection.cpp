@@ -46,6 +46,20 @@
 namespace graphene { namespace net {
   namespace detail
   {
+    /** Receive buffers read on the calling thread and how many of them had to grow, the buffer of a connection
+     *  is reused from one message to the next and keeps the capacity of the largest message it has read */
+    struct receive_buffer_stats
+    {
+      static receive_buffer_stats& instance()
+      {
+        static thread_local receive_buffer_stats stats;
+        return stats;
+      }
+
+      uint64_t acquired = 0;
+      uint64_t allocated = 0;
+    };
+
     class message_oriented_connection_impl
     {
     private:
@@ -163,6 +177,10 @@ namespace graphene { namespace net {
           FC_ASSERT( m.size <= MAX_MESSAGE_SIZE, "", ("m.size",m.size)("MAX_MESSAGE_SIZE",MAX_MESSAGE_SIZE) );
 
           size_t remaining_bytes_with_padding = 16 * ((m.size - LEFTOVER + 15) / 16);
+          receive_buffer_stats& stats = receive_buffer_stats::instance();
+          ++stats.acquired;
+          if (m.data.capacity() < LEFTOVER + remaining_bytes_with_padding)
+            ++stats.allocated;
           m.data.resize(LEFTOVER + remaining_bytes_with_padding); //give extra 16 bytes to allow for padding added in send call
           std::copy(buffer + sizeof(message_header), buffer + sizeof(buffer), m.data.begin());
           if (remaining_bytes_with_padding)
@@ -255,15 +273,11 @@ namespace graphene { namespace net {
 
       try
       {
-        size_t size_of_message_and_header = sizeof(message_header) + message_to_send.size;
         if( message_to_send.size > MAX_MESSAGE_SIZE )
            elog("Trying to send a message larger than MAX_MESSAGE_SIZE. This probably won't work...");
-        //pad the message we send to a multiple of 16 bytes
-        size_t size_with_padding = 16 * ((size_of_message_and_header + 15) / 16);
-        std::unique_ptr<char[]> padded_message(new char[size_with_padding]);
-        memcpy(padded_message.get(), (char*)&message_to_send, sizeof(message_header));
-        memcpy(padded_message.get() + sizeof(message_header), message_to_send.data.data(), message_to_send.size );
-        _sock.write(padded_message.get(), size_with_padding);
+        //the message is padded to a multiple of 16 bytes while it is encrypted
+        size_t size_with_padding = _sock.write_gathered((const char*)&message_to_send, sizeof(message_header),
+                                                        message_to_send.data.data(), message_to_send.size);
         _sock.flush();
         _bytes_sent += size_with_padding;
         _last_message_sent_time = fc::time_point::now();
@@ -409,4 +423,13 @@ namespace graphene { namespace net {
     return my->get_shared_secret();
   }
 
+  uint64_t message_oriented_connection::get_receive_buffers_acquired()
+  {
+    return detail::receive_buffer_stats::instance().acquired;
+  }
+  uint64_t message_oriented_connection::get_receive_buffers_allocated()
+  {
+    return detail::receive_buffer_stats::instance().allocated;
+  }
+
 } } // end namespace graphene::net
@@ -8,6 +8,7 @@
 #include <graphene/net/node.hpp>
 #include <graphene/net/core_messages.hpp>
 #include <graphene/net/peer_connection.hpp>
+#include <graphene/net/packed_item_cache.hpp>
 
 namespace graphene { namespace net { namespace detail {
 
@@ -287,6 +288,7 @@ class node_impl : public peer_connection_delegate
       std::vector<uint32_t> _hard_fork_block_numbers; /// list of all block numbers where there are hard forks
 
       blockchain_tied_message_cache _message_cache; /// cache message we have received and might be required to provide to other peers via inventory requests
+      packed_item_cache _packed_item_cache; /// items we've fetched from the delegate and packed for peers, shared by all peers
 
       fc::rate_limiting_group _rate_limiter;
 
@@ -509,7 +511,8 @@ class node_impl : public peer_connection_delegate
       void                       set_total_bandwidth_limit( uint32_t upload_bytes_per_second, uint32_t download_bytes_per_second );
       void                       disable_peer_advertising();
       fc::variant_object         get_call_statistics() const;
-      message                    get_message_for_item(const item_id& item) override;
+      std::shared_ptr<const message> get_packed_item(const item_id& item);
+      std::shared_ptr<const message> get_message_for_item(const item_id& item) override;
 
       fc::variant_object         network_get_info() const;
       fc::variant_object         network_get_usage_stats() const;
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2018 Total Games LLC, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/net/packed_item_cache.hpp>
+
+namespace graphene { namespace net {
+
+  std::shared_ptr<const message> packed_item_cache::find( const item_id& item )
+  {
+    auto& by_item = _cache.get<item_id_index>();
+    auto iter = by_item.find( item );
+    if( iter == by_item.end() )
+    {
+      ++_misses;
+      return std::shared_ptr<const message>();
+    }
+    ++_hits;
+    _bytes_saved += iter->packed_message->data.size();
+    _cache.relocate( _cache.begin(), _cache.project<0>( iter ) );
+    return iter->packed_message;
+  }
+
+  void packed_item_cache::insert( const item_id& item, const std::shared_ptr<const message>& packed_message )
+  {
+    const size_t packed_size = packed_message->data.size();
+    if( packed_size > _max_size_in_bytes )
+      return;
+
+    auto& by_item = _cache.get<item_id_index>();
+    auto iter = by_item.find( item );
+    if( iter != by_item.end() )
+    {
+      _size_in_bytes -= iter->packed_message->data.size();
+      by_item.erase( iter );
+    }
+
+    _cache.push_front( entry{ item, packed_message } );
+    _size_in_bytes += packed_size;
+    while( _size_in_bytes > _max_size_in_bytes )
+    {
+      _size_in_bytes -= _cache.back().packed_message->data.size();
+      _cache.pop_back();
+    }
+  }
+
+  fc::variant_object packed_item_cache::get_statistics() const
+  {
+    fc::mutable_variant_object result;
+    result["items"] = _cache.size();
+    result["size_in_bytes"] = _size_in_bytes;
+    result["hits"] = _hits;
+    result["misses"] = _misses;
+    result["repack_bytes_saved"] = _bytes_saved;
+    return result;
+  }
+
+} } // graphene::net
@@ -163,6 +163,47 @@ size_t stcp_socket::writesome( const std::shared_ptr<const char>& buf, size_t le
   return writesome(buf.get() + offset, len);
 }
 
+size_t stcp_socket::write_gathered( const char* header, size_t header_len, const char* body, size_t body_len )
+{ try {
+    // must not exceed the chunk writesome() encrypts at once
+    const size_t staging_buffer_length = 4096;
+    if (!_write_staging_buffer)
+      _write_staging_buffer.reset(new char[staging_buffer_length], [](char* p){ delete[] p; });
+    char* staging = _write_staging_buffer.get();
+
+    const size_t total_len = header_len + body_len;
+    const size_t total_len_with_padding = 16 * ((total_len + 15) / 16);
+
+    size_t written = 0;
+    while (written < total_len_with_padding)
+    {
+      const size_t chunk_len = std::min<size_t>(staging_buffer_length, total_len_with_padding - written);
+      size_t filled = 0;
+      if (written < header_len)
+      {
+        filled = std::min<size_t>(header_len - written, chunk_len);
+        memcpy(staging, header + written, filled);
+      }
+      if (filled < chunk_len)
+      {
+        // the header is consumed at this point
+        const size_t body_pos = written + filled - header_len;
+        if (body_pos < body_len)
+        {
+          const size_t n = std::min<size_t>(body_len - body_pos, chunk_len - filled);
+          memcpy(staging + filled, body + body_pos, n);
+          filled += n;
+        }
+      }
+      memset(staging + filled, 0, chunk_len - filled);
+
+      size_t s = writesome(staging, chunk_len);
+      assert(s == chunk_len);
+      written += s;
+    }
+    return written;
+} FC_RETHROW_EXCEPTIONS( warn, "", ("header_len",header_len)("body_len",body_len) ) }
+
 void stcp_socket::flush()
 {
   _sock.flush();
@@ -80,7 +80,7 @@ account_history_plugin_impl::~account_history_plugin_impl()
 void account_history_plugin_impl::update_account_histories( const signed_block& b )
 {
    graphene::chain::database& db = database();
-   const vector<optional< operation_history_object > >& hist = db.get_applied_operations();
+   const graphene::chain::database::applied_operations_type& hist = db.get_applied_operations();
    bool is_first = true;
    auto skip_oho_id = [&is_first,&db,this]() {
       if( is_first && db._undo_db.enabled() ) // this ensures that the current id is rolled back on undo
@@ -92,7 +92,7 @@ void account_history_plugin_impl::update_account_histories( const signed_block&
          _oho_index->use_next_id();
    };
 
-   for( const optional< operation_history_object >& o_op : hist )
+   for( const auto& o_op : hist )
    {
       optional<operation_history_object> oho;
 
@@ -100,19 +100,16 @@ void account_history_plugin_impl::update_account_histories( const signed_block&
          is_first = false;
          return optional<operation_history_object>( db.create<operation_history_object>( [&]( operation_history_object& h )
          {
-            if( o_op.valid() )
-            {
-               h.op           = o_op->op;
-               h.result       = o_op->result;
-               h.block_num    = o_op->block_num;
-               h.trx_in_block = o_op->trx_in_block;
-               h.op_in_trx    = o_op->op_in_trx;
-               h.virtual_op   = o_op->virtual_op;
-            }
+            h.op           = o_op.op;
+            h.result       = o_op.result;
+            h.block_num    = o_op.block_num;
+            h.trx_in_block = o_op.trx_in_block;
+            h.op_in_trx    = o_op.op_in_trx;
+            h.virtual_op   = o_op.virtual_op;
          } ) );
       };
 
-      if( !o_op.valid() || ( _max_ops_per_account == 0 && _partial_operations ) )
+      if( o_op.removed || ( _max_ops_per_account == 0 && _partial_operations ) )
       {
          // Note: the 2nd and 3rd checks above are for better performance, when the db is not clean,
          //       they will break consistency of account_stats.total_ops and removed_ops and most_recent_op
@@ -123,7 +120,7 @@ void account_history_plugin_impl::update_account_histories( const signed_block&
          // add to the operation history index
          oho = create_oho();
 
-      const operation_history_object& op = *o_op;
+      const auto& op = o_op;
 
       // get the set of accounts this operation applies to
       flat_set<account_id_type> impacted;
@@ -289,6 +286,7 @@ void account_history_plugin::plugin_set_program_options(
 void account_history_plugin::plugin_initialize(const boost::program_options::variables_map& options)
 {
    database().applied_block.connect( [&]( const signed_block& b){ my->update_account_histories(b); } );
+   database().add_applied_operations_consumer();
    my->_oho_index = database().add_index< primary_index< operation_history_index > >();
    database().add_index< primary_index< account_transaction_history_index > >();
 
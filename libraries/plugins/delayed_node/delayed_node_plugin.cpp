@@ -31,6 +31,8 @@
 #include <fc/rpc/websocket_api.hpp>
 #include <fc/api.hpp>
 
+#include <deque>
+
 namespace graphene { namespace delayed_node {
 namespace bpo = boost::program_options;
 
@@ -43,6 +45,16 @@ struct delayed_node_plugin_impl {
    boost::signals2::scoped_connection client_connection_closed;
    graphene::chain::block_id_type last_received_remote_head;
    graphene::chain::block_id_type last_processed_remote_head;
+   /// number of get_blocks requests kept in flight during sync
+   uint32_t sync_requests_window = 4;
+   /// number of blocks requested by a single get_blocks call
+   uint32_t sync_blocks_per_request = 50;
+};
+
+struct blocks_request {
+   uint32_t block_num_from = 0;
+   uint32_t count = 0;
+   fc::future<std::vector<graphene::chain::signed_block>> blocks;
 };
 }
 
@@ -57,6 +69,10 @@ void delayed_node_plugin::plugin_set_program_options(bpo::options_description& c
 {
    cli.add_options()
          ("trusted-node", boost::program_options::value<std::string>(), "RPC endpoint of a trusted validating node (required for delayed_node)")
+         ("trusted-node-sync-requests", boost::program_options::value<uint32_t>()->default_value(4),
+          "Number of block range requests to the trusted node kept in flight during sync")
+         ("trusted-node-sync-blocks-per-request", boost::program_options::value<uint32_t>()->default_value(50),
+          "Number of blocks fetched from the trusted node by one request, must not exceed its api-limit-get-blocks")
          ;
    cfg.add(cli);
 }
@@ -75,6 +91,10 @@ void delayed_node_plugin::plugin_initialize(const boost::program_options::variab
    FC_ASSERT(options.count("trusted-node") > 0);
    my = std::unique_ptr<detail::delayed_node_plugin_impl>{ new detail::delayed_node_plugin_impl() };
    my->remote_endpoint = "ws://" + options.at("trusted-node").as<std::string>();
+   if( options.count("trusted-node-sync-requests") )
+      my->sync_requests_window = std::max<uint32_t>( options.at("trusted-node-sync-requests").as<uint32_t>(), 1 );
+   if( options.count("trusted-node-sync-blocks-per-request") )
+      my->sync_blocks_per_request = std::max<uint32_t>( options.at("trusted-node-sync-blocks-per-request").as<uint32_t>(), 1 );
 }
 
 void delayed_node_plugin::sync_with_trusted_node()
@@ -98,15 +118,66 @@ void delayed_node_plugin::sync_with_trusted_node()
          break;
       }
       pass_count++;
-      while( remote_dpo.last_irreversible_block_num > db.head_block_num() )
+
+      // Keep several block ranges requested while the received ones are preprocessed and applied
+      const uint32_t last_block_num = remote_dpo.last_irreversible_block_num;
+      uint32_t next_block_num = db.head_block_num() + 1;
+      std::deque<detail::blocks_request> requests;
+      auto request_blocks = [&]() {
+         while( requests.size() < my->sync_requests_window && next_block_num <= last_block_num )
+         {
+            detail::blocks_request request;
+            request.block_num_from = next_block_num;
+            request.count = std::min( my->sync_blocks_per_request, last_block_num - next_block_num + 1 );
+            auto database_api = my->database_api;
+            const uint32_t from = request.block_num_from;
+            const uint32_t count = request.count;
+            request.blocks = fc::async( [database_api, from, count]() {
+               return database_api->get_blocks( from, count );
+            }, "delayed_node get_blocks" );
+            next_block_num += request.count;
+            requests.emplace_back( std::move( request ) );
+         }
+      };
+
+      request_blocks();
+      while( !requests.empty() )
       {
-         fc::optional<graphene::chain::signed_block> block = my->database_api->get_block( db.head_block_num()+1 );
-         // TODO: during sync, decouple requesting blocks from preprocessing + applying them
-         FC_ASSERT(block, "Trusted node claims it has blocks it doesn't actually have.");
-         ilog("Pushing block #${n}", ("n", block->block_num()));
-         db.precompute_parallel( *block, graphene::chain::database::skip_nothing ).wait();
-         db.push_block(*block);
-         synced_blocks++;
+         detail::blocks_request request = std::move( requests.front() );
+         requests.pop_front();
+         std::vector<graphene::chain::signed_block> blocks = request.blocks.wait();
+         request_blocks();
+
+         FC_ASSERT( blocks.size() == request.count, "Trusted node claims it has blocks it doesn't actually have.",
+                    ("from", request.block_num_from)("requested", request.count)("received", blocks.size()) );
+
+         // Signatures of the following blocks are recovered while the previous ones are applied
+         std::vector<fc::future<void>> precomputed;
+         precomputed.reserve( blocks.size() );
+         for( const auto& block : blocks )
+            precomputed.emplace_back( db.precompute_parallel( block, graphene::chain::database::skip_nothing ) );
+
+         ilog( "Pushing blocks #${f} - #${l}", ("f", request.block_num_from)("l", request.block_num_from + request.count - 1) );
+         try
+         {
+            for( size_t i = 0; i < blocks.size(); ++i )
+            {
+               FC_ASSERT( blocks[i].block_num() == db.head_block_num() + 1, "Trusted node returned unexpected block",
+                          ("expected", db.head_block_num() + 1)("received", blocks[i].block_num()) );
+               precomputed[i].wait();
+               db.push_block( blocks[i] );
+               synced_blocks++;
+            }
+         }
+         catch( ... )
+         {
+            // the precomputation tasks refer to the blocks, let them finish before the blocks are released
+            for( auto& f : precomputed )
+            {
+               try { f.wait(); } catch( ... ) {}
+            }
+            throw;
+         }
       }
    }
 }
@@ -108,7 +108,7 @@ bool elasticsearch_plugin_impl::update_account_histories( const signed_block& b
    index_name = graphene::utilities::generateIndexName(b.timestamp, _elasticsearch_index_prefix);
 
    graphene::chain::database& db = database();
-   const vector<optional< operation_history_object > >& hist = db.get_applied_operations();
+   const graphene::chain::database::applied_operations_type& hist = db.get_applied_operations();
    bool is_first = true;
    auto skip_oho_id = [&is_first,&db,this]() {
       if( is_first && db._undo_db.enabled() ) // this ensures that the current id is rolled back on undo
@@ -119,26 +119,23 @@ bool elasticsearch_plugin_impl::update_account_histories( const signed_block& b
       else
          _oho_index->use_next_id();
    };
-   for( const optional< operation_history_object >& o_op : hist ) {
+   for( const auto& o_op : hist ) {
       optional <operation_history_object> oho;
 
       auto create_oho = [&]() {
          is_first = false;
          return optional<operation_history_object>(
                db.create<operation_history_object>([&](operation_history_object &h) {
-                  if (o_op.valid())
-                  {
-                     h.op           = o_op->op;
-                     h.result       = o_op->result;
-                     h.block_num    = o_op->block_num;
-                     h.trx_in_block = o_op->trx_in_block;
-                     h.op_in_trx    = o_op->op_in_trx;
-                     h.virtual_op   = o_op->virtual_op;
-                  }
+                  h.op           = o_op.op;
+                  h.result       = o_op.result;
+                  h.block_num    = o_op.block_num;
+                  h.trx_in_block = o_op.trx_in_block;
+                  h.op_in_trx    = o_op.op_in_trx;
+                  h.virtual_op   = o_op.virtual_op;
                }));
       };
 
-      if( !o_op.valid() ) {
+      if( o_op.removed ) {
          skip_oho_id();
          continue;
       }
@@ -151,7 +148,7 @@ bool elasticsearch_plugin_impl::update_account_histories( const signed_block& b
       if(_elasticsearch_visitor)
          doVisitor(oho);
 
-      const operation_history_object& op = *o_op;
+      const auto& op = o_op;
 
       // get the set of accounts this operation applies to
       flat_set<account_id_type> impacted;
@@ -468,6 +465,7 @@ void elasticsearch_plugin::plugin_initialize(const boost::program_options::varia
       if (!my->update_account_histories(b))
          FC_THROW_EXCEPTION(graphene::chain::plugin_exception, "Error populating ES database, we are going to keep trying.");
    } );
+   database().add_applied_operations_consumer();
 
    my->_oho_index = database().add_index< primary_index< operation_history_index > >();
    database().add_index< primary_index< account_transaction_history_index > >();
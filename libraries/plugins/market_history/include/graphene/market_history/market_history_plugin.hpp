@@ -25,6 +25,7 @@
 
 #include <graphene/app/plugin.hpp>
 #include <graphene/chain/database.hpp>
+#include <graphene/chain/market_object.hpp>
 
 #include <fc/thread/future.hpp>
 #include <fc/uint128.hpp>
@@ -216,6 +217,56 @@ typedef generic_index<order_history_object, order_history_multi_index_type> hist
 typedef generic_index<market_ticker_object, market_ticker_object_multi_index_type> market_ticker_index;
 
 
+/**
+ *  @brief limit orders of a market side with the same price
+ */
+struct order_book_level
+{
+   /// price of the first order of the level, the prices of the other orders have the same ratio
+   price         sell_price;
+   share_type    for_sale;
+   /// sum of what every order receives if filled completely, rounded down order by order
+   share_type    to_receive;
+   uint32_t      orders = 0;
+};
+
+/**
+ *  @brief This secondary index maintains the price levels of the limit orders of every market.
+ *
+ *  The levels follow every creation, fill, cancellation and undo of the limit orders, so they always
+ *  correspond to the current state of the database, pending transactions included.
+ */
+class order_book_index : public secondary_index
+{
+   public:
+      /// levels of the orders selling the base asset of the price, the best price first
+      typedef std::map< price, order_book_level, std::greater<price> > side_type;
+
+      order_book_index( uint32_t depth ) : _depth( depth ) {}
+
+      virtual void object_inserted( const object& obj ) override;
+      virtual void object_removed( const object& obj ) override;
+      virtual void about_to_modify( const object& before ) override;
+      virtual void object_modified( const object& after  ) override;
+
+      virtual uint64_t get_memory_usage()const override;
+
+      /// max number of levels served per market side
+      uint32_t depth()const { return _depth; }
+
+      /// @return up to limit best levels of the orders selling the asset sell for the asset receive
+      vector<order_book_level> get_levels( asset_id_type sell, asset_id_type receive, uint32_t limit )const;
+
+   private:
+      void add_order( const limit_order_object& o );
+      void remove_order( const limit_order_object& o );
+
+      uint32_t _depth;
+
+      /// market sides by the (sell, receive) asset pairs
+      std::map< std::pair<asset_id_type, asset_id_type>, side_type > _sides;
+};
+
 namespace detail
 {
     class market_history_plugin_impl;
@@ -244,6 +295,7 @@ class market_history_plugin : public graphene::app::plugin
       const flat_set<uint32_t>&   tracked_buckets()const;
       uint32_t                    max_order_his_records_per_market()const;
       uint32_t                    max_order_his_seconds_per_market()const;
+      uint32_t                    order_book_depth()const;
 
    private:
       friend class detail::market_history_plugin_impl;
@@ -254,6 +306,7 @@ class market_history_plugin : public graphene::app::plugin
 
 FC_REFLECT( graphene::market_history::history_key, (base)(quote)(sequence) )
 FC_REFLECT_DERIVED( graphene::market_history::order_history_object, (graphene::db::object), (key)(time)(op) )
+FC_REFLECT( graphene::market_history::order_book_level, (sell_price)(for_sale)(to_receive)(orders) )
 FC_REFLECT( graphene::market_history::bucket_key, (base)(quote)(seconds)(open) )
 FC_REFLECT_DERIVED( graphene::market_history::bucket_object, (graphene::db::object),
                     (key)
@@ -33,6 +33,8 @@
 #include <graphene/chain/transaction_evaluation_state.hpp>
 #include <graphene/chain/protocol/fee_schedule.hpp>
 
+#include <graphene/db/memory_usage.hpp>
+
 #include <fc/thread/thread.hpp>
 
 namespace graphene { namespace market_history {
@@ -40,6 +42,22 @@ namespace graphene { namespace market_history {
 namespace detail
 {
 
+/// fills of a market in a block, applied to the ticker and the buckets at once
+struct market_block_fills
+{
+   /// key of the last order history object created for the market
+   history_key  last_history_key;
+   uint32_t     maker_fills = 0;
+   price        open;
+   price        close;
+   price        high;
+   price        low;
+   fc::uint128  base_volume;
+   fc::uint128  quote_volume;
+};
+
+typedef flat_map< std::pair<asset_id_type, asset_id_type>, market_block_fills > block_fills_type;
+
 class market_history_plugin_impl
 {
    public:
@@ -52,6 +70,12 @@ class market_history_plugin_impl
        */
       void update_market_histories( const signed_block& b );
 
+      /// removes the filled orders beyond the history limits of the market of the last_key
+      void prune_order_history( const history_key& last_key, fc::time_point_sec now );
+      void update_ticker( asset_id_type base, asset_id_type quote, const market_block_fills& fills );
+      void update_buckets( asset_id_type base, asset_id_type quote, const market_block_fills& fills,
+                           fc::time_point_sec now );
+
       graphene::chain::database& database()
       {
          return _self.database();
@@ -62,6 +86,10 @@ class market_history_plugin_impl
       uint32_t                   _maximum_history_per_bucket_size = 1000;
       uint32_t                   _max_order_his_records_per_market = 1000;
       uint32_t                   _max_order_his_seconds_per_market = 259200;
+      uint32_t                   _order_book_depth = 50;
+
+      /// fills of the block being processed, kept to reuse the memory
+      block_fills_type           _block_fills;
 };
 
 
@@ -70,9 +98,11 @@ struct operation_process_fill_order
    market_history_plugin&            _plugin;
    fc::time_point_sec                _now;
    const market_ticker_meta_object*& _meta;
+   block_fills_type&                 _fills;
 
-   operation_process_fill_order( market_history_plugin& mhp, fc::time_point_sec n, const market_ticker_meta_object*& meta )
-   :_plugin(mhp),_now(n),_meta(meta) {}
+   operation_process_fill_order( market_history_plugin& mhp, fc::time_point_sec n, const market_ticker_meta_object*& meta,
+                                 block_fills_type& fills )
+   :_plugin(mhp),_now(n),_meta(meta),_fills(fills) {}
 
    typedef void result_type;
 
@@ -84,9 +114,7 @@ struct operation_process_fill_order
    {
       //ilog( "processing ${o}", ("o",o) );
       auto& db         = _plugin.database();
-      const auto& order_his_idx = db.get_index_type<history_index>().indices();
-      const auto& history_idx = order_his_idx.get<by_key>();
-      const auto& his_time_idx = order_his_idx.get<by_market_time>();
+      const auto& history_idx = db.get_index_type<history_index>().indices().get<by_key>();
 
       // To save new filled order data
       history_key hkey;
@@ -122,176 +150,198 @@ struct operation_process_fill_order
             _meta = &( *meta_idx.begin() );
       }
 
-      // To remove old filled order data
-      const auto max_records = _plugin.max_order_his_records_per_market();
-      hkey.sequence += max_records;
-      itr = history_idx.lower_bound( hkey );
-      if( itr != history_idx.end() && itr->key.base == hkey.base && itr->key.quote == hkey.quote )
-      {
-         const auto max_seconds = _plugin.max_order_his_seconds_per_market();
-         fc::time_point_sec min_time;
-         if( min_time + max_seconds < _now )
-            min_time = _now - max_seconds;
-         auto time_itr = his_time_idx.lower_bound( std::make_tuple( hkey.base, hkey.quote, min_time ) );
-         if( time_itr != his_time_idx.end() && time_itr->key.base == hkey.base && time_itr->key.quote == hkey.quote )
-         {
-            if( itr->key.sequence >= time_itr->key.sequence )
-            {
-               while( itr != history_idx.end() && itr->key.base == hkey.base && itr->key.quote == hkey.quote )
-               {
-                  auto old_itr = itr;
-                  ++itr;
-                  db.remove( *old_itr );
-               }
-            }
-            else
-            {
-               while( time_itr != his_time_idx.end() && time_itr->key.base == hkey.base && time_itr->key.quote == hkey.quote )
-               {
-                  auto old_itr = time_itr;
-                  ++time_itr;
-                  db.remove( *old_itr );
-               }
-            }
-         }
-      }
+      // old filled order data is removed once per block, see prune_order_history
+      auto& fills = _fills[ std::make_pair( hkey.base, hkey.quote ) ];
+      fills.last_history_key = hkey;
 
       // To update ticker data and buckets data, only update for maker orders
       if( !o.is_maker )
          return;
 
-      bucket_key key;
-      key.base    = o.pays.asset_id;
-      key.quote   = o.receives.asset_id;
-
       price trade_price = o.pays / o.receives;
-
-      if( key.base > key.quote )
-      {
-         std::swap( key.base, key.quote );
+      if( o.pays.asset_id > o.receives.asset_id )
          trade_price = ~trade_price;
-      }
 
       price fill_price = o.fill_price;
       if( fill_price.base.asset_id > fill_price.quote.asset_id )
          fill_price = ~fill_price;
 
-      // To update ticker data
-      const auto& ticker_idx = db.get_index_type<market_ticker_index>().indices().get<by_market>();
-      auto ticker_itr = ticker_idx.find( std::make_tuple( key.base, key.quote ) );
-      if( ticker_itr == ticker_idx.end() )
+      if( fills.maker_fills++ == 0 )
       {
-         db.create<market_ticker_object>( [&]( market_ticker_object& mt ) {
-            mt.base           = key.base;
-            mt.quote          = key.quote;
-            mt.last_day_base  = 0;
-            mt.last_day_quote = 0;
-            mt.latest_base    = fill_price.base.amount;
-            mt.latest_quote   = fill_price.quote.amount;
-            mt.base_volume    = trade_price.base.amount.value;
-            mt.quote_volume   = trade_price.quote.amount.value;
-         });
+         fills.open = fill_price;
+         fills.high = fill_price;
+         fills.low = fill_price;
       }
       else
       {
-         db.modify( *ticker_itr, [&]( market_ticker_object& mt ) {
-            mt.latest_base    = fill_price.base.amount;
-            mt.latest_quote   = fill_price.quote.amount;
-            mt.base_volume    += trade_price.base.amount.value;  // ignore overflow
-            mt.quote_volume   += trade_price.quote.amount.value; // ignore overflow
-         });
+         if( fills.high < fill_price )
+            fills.high = fill_price;
+         if( fills.low > fill_price )
+            fills.low = fill_price;
       }
+      fills.close = fill_price;
+      fills.base_volume += trade_price.base.amount.value;
+      fills.quote_volume += trade_price.quote.amount.value;
+   }
+};
 
-      // To update buckets data
-      const auto max_history = _plugin.max_history();
-      if( max_history == 0 ) return;
-
-      const auto& buckets = _plugin.tracked_buckets();
-      if( buckets.size() == 0 ) return;
+market_history_plugin_impl::~market_history_plugin_impl()
+{}
 
-      const auto& bucket_idx = db.get_index_type<bucket_index>();
-      for( auto bucket : buckets )
+void market_history_plugin_impl::prune_order_history( const history_key& last_key, fc::time_point_sec now )
+{
+   graphene::chain::database& db = database();
+   const auto& order_his_idx = db.get_index_type<history_index>().indices();
+   const auto& history_idx = order_his_idx.get<by_key>();
+   const auto& his_time_idx = order_his_idx.get<by_market_time>();
+
+   // To remove old filled order data
+   history_key hkey = last_key;
+   hkey.sequence += _max_order_his_records_per_market;
+   auto itr = history_idx.lower_bound( hkey );
+   if( itr != history_idx.end() && itr->key.base == hkey.base && itr->key.quote == hkey.quote )
+   {
+      fc::time_point_sec min_time;
+      if( min_time + _max_order_his_seconds_per_market < now )
+         min_time = now - _max_order_his_seconds_per_market;
+      auto time_itr = his_time_idx.lower_bound( std::make_tuple( hkey.base, hkey.quote, min_time ) );
+      if( time_itr != his_time_idx.end() && time_itr->key.base == hkey.base && time_itr->key.quote == hkey.quote )
       {
-          auto bucket_num = _now.sec_since_epoch() / bucket;
-          fc::time_point_sec cutoff;
-          if( bucket_num > max_history )
-             cutoff = cutoff + ( bucket * ( bucket_num - max_history ) );
-
-          key.seconds = bucket;
-          key.open    = fc::time_point_sec() + ( bucket_num * bucket );
-
-          const auto& by_key_idx = bucket_idx.indices().get<by_key>();
-          auto bucket_itr = by_key_idx.find( key );
-          if( bucket_itr == by_key_idx.end() )
-          { // create new bucket
-            /* const auto& obj = */
-            db.create<bucket_object>( [&]( bucket_object& b ){
-                 b.key = key;
-                 b.base_volume = trade_price.base.amount;
-                 b.quote_volume = trade_price.quote.amount;
-                 b.open_base = fill_price.base.amount;
-                 b.open_quote = fill_price.quote.amount;
-                 b.close_base = fill_price.base.amount;
-                 b.close_quote = fill_price.quote.amount;
-                 b.high_base = b.close_base;
-                 b.high_quote = b.close_quote;
-                 b.low_base = b.close_base;
-                 b.low_quote = b.close_quote;
-            });
-            //wlog( "    creating bucket ${b}", ("b",obj) );
-          }
-          else
-          { // update existing bucket
-             //wlog( "    before updating bucket ${b}", ("b",*bucket_itr) );
-             db.modify( *bucket_itr, [&]( bucket_object& b ){
-                  try {
-                     b.base_volume += trade_price.base.amount;
-                  } catch( fc::overflow_exception& ) {
-                     b.base_volume = std::numeric_limits<int64_t>::max();
-                  }
-                  try {
-                     b.quote_volume += trade_price.quote.amount;
-                  } catch( fc::overflow_exception& ) {
-                     b.quote_volume = std::numeric_limits<int64_t>::max();
-                  }
-                  b.close_base = fill_price.base.amount;
-                  b.close_quote = fill_price.quote.amount;
-                  if( b.high() < fill_price )
-                  {
-                      b.high_base = b.close_base;
-                      b.high_quote = b.close_quote;
-                  }
-                  if( b.low() > fill_price )
-                  {
-                      b.low_base = b.close_base;
-                      b.low_quote = b.close_quote;
-                  }
-             });
-             //wlog( "    after bucket bucket ${b}", ("b",*bucket_itr) );
-          }
+         if( itr->key.sequence >= time_itr->key.sequence )
+         {
+            while( itr != history_idx.end() && itr->key.base == hkey.base && itr->key.quote == hkey.quote )
+            {
+               auto old_itr = itr;
+               ++itr;
+               db.remove( *old_itr );
+            }
+         }
+         else
+         {
+            while( time_itr != his_time_idx.end() && time_itr->key.base == hkey.base && time_itr->key.quote == hkey.quote )
+            {
+               auto old_itr = time_itr;
+               ++time_itr;
+               db.remove( *old_itr );
+            }
+         }
+      }
+   }
+}
+
+static share_type saturated_volume( const fc::uint128& volume )
+{
+   if( volume > fc::uint128( std::numeric_limits<int64_t>::max() ) )
+      return std::numeric_limits<int64_t>::max();
+   return static_cast<int64_t>( volume.to_uint64() );
+}
+
+void market_history_plugin_impl::update_ticker( asset_id_type base, asset_id_type quote, const market_block_fills& fills )
+{
+   graphene::chain::database& db = database();
+   const auto& ticker_idx = db.get_index_type<market_ticker_index>().indices().get<by_market>();
+   auto ticker_itr = ticker_idx.find( std::make_tuple( base, quote ) );
+   if( ticker_itr == ticker_idx.end() )
+   {
+      db.create<market_ticker_object>( [&]( market_ticker_object& mt ) {
+         mt.base           = base;
+         mt.quote          = quote;
+         mt.last_day_base  = 0;
+         mt.last_day_quote = 0;
+         mt.latest_base    = fills.close.base.amount;
+         mt.latest_quote   = fills.close.quote.amount;
+         mt.base_volume    = fills.base_volume;
+         mt.quote_volume   = fills.quote_volume;
+      });
+   }
+   else
+   {
+      db.modify( *ticker_itr, [&]( market_ticker_object& mt ) {
+         mt.latest_base    = fills.close.base.amount;
+         mt.latest_quote   = fills.close.quote.amount;
+         mt.base_volume    += fills.base_volume;  // ignore overflow
+         mt.quote_volume   += fills.quote_volume; // ignore overflow
+      });
+   }
+}
+
+void market_history_plugin_impl::update_buckets( asset_id_type base, asset_id_type quote, const market_block_fills& fills,
+                                                 fc::time_point_sec now )
+{
+   if( _maximum_history_per_bucket_size == 0 ) return;
+   if( _tracked_buckets.size() == 0 ) return;
+
+   graphene::chain::database& db = database();
+   const auto& by_key_idx = db.get_index_type<bucket_index>().indices().get<by_key>();
+
+   bucket_key key;
+   key.base    = base;
+   key.quote   = quote;
 
+   for( auto bucket : _tracked_buckets )
+   {
+       auto bucket_num = now.sec_since_epoch() / bucket;
+       fc::time_point_sec cutoff;
+       if( bucket_num > _maximum_history_per_bucket_size )
+          cutoff = cutoff + ( bucket * ( bucket_num - _maximum_history_per_bucket_size ) );
+
+       key.seconds = bucket;
+       key.open    = fc::time_point_sec() + ( bucket_num * bucket );
+
+       auto bucket_itr = by_key_idx.find( key );
+       if( bucket_itr == by_key_idx.end() )
+       { // create new bucket
+         db.create<bucket_object>( [&]( bucket_object& b ){
+              b.key = key;
+              b.base_volume = saturated_volume( fills.base_volume );
+              b.quote_volume = saturated_volume( fills.quote_volume );
+              b.open_base = fills.open.base.amount;
+              b.open_quote = fills.open.quote.amount;
+              b.close_base = fills.close.base.amount;
+              b.close_quote = fills.close.quote.amount;
+              b.high_base = fills.high.base.amount;
+              b.high_quote = fills.high.quote.amount;
+              b.low_base = fills.low.base.amount;
+              b.low_quote = fills.low.quote.amount;
+         });
+       }
+       else
+       { // update existing bucket
+          db.modify( *bucket_itr, [&]( bucket_object& b ){
+               b.base_volume = saturated_volume( fc::uint128( b.base_volume.value ) + fills.base_volume );
+               b.quote_volume = saturated_volume( fc::uint128( b.quote_volume.value ) + fills.quote_volume );
+               b.close_base = fills.close.base.amount;
+               b.close_quote = fills.close.quote.amount;
+               if( b.high() < fills.high )
+               {
+                   b.high_base = fills.high.base.amount;
+                   b.high_quote = fills.high.quote.amount;
+               }
+               if( b.low() > fills.low )
+               {
+                   b.low_base = fills.low.base.amount;
+                   b.low_quote = fills.low.quote.amount;
+               }
+          });
+       }
+
+       {
+          key.open = fc::time_point_sec();
+          bucket_itr = by_key_idx.lower_bound( key );
+
+          while( bucket_itr != by_key_idx.end() &&
+                 bucket_itr->key.base == key.base &&
+                 bucket_itr->key.quote == key.quote &&
+                 bucket_itr->key.seconds == bucket &&
+                 bucket_itr->key.open < cutoff )
           {
-             key.open = fc::time_point_sec();
-             bucket_itr = by_key_idx.lower_bound( key );
-
-             while( bucket_itr != by_key_idx.end() &&
-                    bucket_itr->key.base == key.base &&
-                    bucket_itr->key.quote == key.quote &&
-                    bucket_itr->key.seconds == bucket &&
-                    bucket_itr->key.open < cutoff )
-             {
-              //  elog( "    removing old bucket ${b}", ("b", *bucket_itr) );
-                auto old_bucket_itr = bucket_itr;
-                ++bucket_itr;
-                db.remove( *old_bucket_itr );
-             }
+             auto old_bucket_itr = bucket_itr;
+             ++bucket_itr;
+             db.remove( *old_bucket_itr );
           }
-      }
+       }
    }
-};
-
-market_history_plugin_impl::~market_history_plugin_impl()
-{}
+}
 
 void market_history_plugin_impl::update_market_histories( const signed_block& b )
 {
@@ -300,17 +350,30 @@ void market_history_plugin_impl::update_market_histories( const signed_block& b
    const auto& meta_idx = db.get_index_type<simple_index<market_ticker_meta_object>>();
    if( meta_idx.size() > 0 )
       _meta = &( *meta_idx.begin() );
-   const vector<optional< operation_history_object > >& hist = db.get_applied_operations();
-   for( const optional< operation_history_object >& o_op : hist )
+   _block_fills.clear();
+   const graphene::chain::database::applied_operations_type& hist = db.get_applied_operations();
+   for( const auto& o_op : hist )
    {
-      if( o_op.valid() )
+      if( !o_op.removed )
       {
          try
          {
-            o_op->op.visit( operation_process_fill_order( _self, b.timestamp, _meta ) );
-         } FC_CAPTURE_AND_LOG( (o_op) )
+            o_op.op.visit( operation_process_fill_order( _self, b.timestamp, _meta, _block_fills ) );
+         } FC_CAPTURE_AND_LOG( (o_op.op) )
       }
    }
+   // flush the fills of the block, every market is updated once
+   for( const auto& item : _block_fills )
+   {
+      try
+      {
+         prune_order_history( item.second.last_history_key, b.timestamp );
+         if( item.second.maker_fills == 0 )
+            continue;
+         update_ticker( item.first.first, item.first.second, item.second );
+         update_buckets( item.first.first, item.first.second, item.second, b.timestamp );
+      } FC_CAPTURE_AND_LOG( (item.first)(item.second.last_history_key) )
+   }
    // roll out expired data from ticker
    if( _meta != nullptr )
    {
@@ -384,6 +447,96 @@ void market_history_plugin_impl::update_market_histories( const signed_block& b
 
 } // end namespace detail
 
+void order_book_index::object_inserted( const object& objct )
+{ try {
+   add_order( static_cast<const limit_order_object&>( objct ) );
+} FC_CAPTURE_AND_RETHROW( (objct) ); }
+
+void order_book_index::object_removed( const object& objct )
+{ try {
+   remove_order( static_cast<const limit_order_object&>( objct ) );
+} FC_CAPTURE_AND_RETHROW( (objct) ); }
+
+void order_book_index::about_to_modify( const object& objct )
+{ try {
+   remove_order( static_cast<const limit_order_object&>( objct ) );
+} FC_CAPTURE_AND_RETHROW( (objct) ); }
+
+void order_book_index::object_modified( const object& objct )
+{ try {
+   add_order( static_cast<const limit_order_object&>( objct ) );
+} FC_CAPTURE_AND_RETHROW( (objct) ); }
+
+static share_type order_to_receive( const limit_order_object& o )
+{
+   using boost::multiprecision::uint128_t;
+   return share_type( ( uint128_t( o.for_sale.value ) * o.sell_price.quote.amount.value ) / o.sell_price.base.amount.value );
+}
+
+void order_book_index::add_order( const limit_order_object& o )
+{
+   auto& side = _sides[ std::make_pair( o.sell_price.base.asset_id, o.sell_price.quote.asset_id ) ];
+   auto itr = side.find( o.sell_price );
+   if( itr == side.end() )
+   {
+      itr = side.emplace( o.sell_price, order_book_level() ).first;
+      itr->second.sell_price = o.sell_price;
+   }
+   itr->second.for_sale += o.for_sale;
+   itr->second.to_receive += order_to_receive( o );
+   ++itr->second.orders;
+}
+
+void order_book_index::remove_order( const limit_order_object& o )
+{
+   auto side_itr = _sides.find( std::make_pair( o.sell_price.base.asset_id, o.sell_price.quote.asset_id ) );
+   if( side_itr == _sides.end() )
+   {
+      // should not happen
+      wlog( "can not find the order book side of the order: ${o}", ("o",o) );
+      return;
+   }
+
+   auto& side = side_itr->second;
+   auto itr = side.find( o.sell_price );
+   if( itr == side.end() || itr->second.orders == 0 )
+   {
+      // should not happen
+      wlog( "can not find the order book level of the order: ${o}", ("o",o) );
+      return;
+   }
+
+   if( --itr->second.orders == 0 )
+   {
+      side.erase( itr );
+      if( side.empty() )
+         _sides.erase( side_itr );
+      return;
+   }
+   itr->second.for_sale -= o.for_sale;
+   itr->second.to_receive -= order_to_receive( o );
+}
+
+vector<order_book_level> order_book_index::get_levels( asset_id_type sell, asset_id_type receive, uint32_t limit )const
+{
+   vector<order_book_level> result;
+
+   auto side_itr = _sides.find( std::make_pair( sell, receive ) );
+   if( side_itr == _sides.end() )
+      return result;
+
+   limit = std::min( limit, _depth );
+   result.reserve( std::min<size_t>( limit, side_itr->second.size() ) );
+   for( auto itr = side_itr->second.begin(); itr != side_itr->second.end() && result.size() < limit; ++itr )
+      result.push_back( itr->second );
+   return result;
+}
+
+uint64_t order_book_index::get_memory_usage()const
+{
+   return estimate_dynamic_memory_usage( _sides );
+}
+
 
 
 
@@ -417,6 +570,8 @@ void market_history_plugin::plugin_set_program_options(
            "Will only store this amount of matched orders for each market in order history for querying, or those meet the other option, which has more data (default: 1000)")
          ("max-order-his-seconds-per-market", boost::program_options::value<uint32_t>()->default_value(259200),
            "Will only store matched orders in last X seconds for each market in order history for querying, or those meet the other option, which has more data (default: 259200 (3 days))")
+         ("order-book-depth", boost::program_options::value<uint32_t>()->default_value(50),
+           "Max number of price levels per market side served from the maintained order books (default: 50)")
          ;
    cfg.add(cli);
 }
@@ -424,6 +579,7 @@ void market_history_plugin::plugin_set_program_options(
 void market_history_plugin::plugin_initialize(const boost::program_options::variables_map& options)
 { try {
    database().applied_block.connect( [this]( const signed_block& b){ my->update_market_histories(b); } );
+   database().add_applied_operations_consumer();
    database().add_index< primary_index< bucket_index  > >();
    database().add_index< primary_index< history_index  > >();
    database().add_index< primary_index< market_ticker_index  > >();
@@ -441,6 +597,13 @@ void market_history_plugin::plugin_initialize(const boost::program_options::vari
       my->_max_order_his_records_per_market = options["max-order-his-records-per-market"].as<uint32_t>();
    if( options.count( "max-order-his-seconds-per-market" ) )
       my->_max_order_his_seconds_per_market = options["max-order-his-seconds-per-market"].as<uint32_t>();
+   if( options.count( "order-book-depth" ) )
+   {
+      my->_order_book_depth = options["order-book-depth"].as<uint32_t>();
+      FC_ASSERT( my->_order_book_depth > 0, "order-book-depth should be positive" );
+   }
+
+   database().add_secondary_index< primary_index<limit_order_index>, order_book_index >( my->_order_book_depth );
 } FC_CAPTURE_AND_RETHROW() }
 
 void market_history_plugin::plugin_startup()
@@ -467,4 +630,9 @@ uint32_t market_history_plugin::max_order_his_seconds_per_market()const
    return my->_max_order_his_seconds_per_market;
 }
 
+uint32_t market_history_plugin::order_book_depth()const
+{
+   return my->_order_book_depth;
+}
+
 } }
@@ -46,6 +46,32 @@ namespace block_production_condition
    };
 }
 
+/**
+ * @brief distribution of the durations of a block production stage
+ */
+struct latency_histogram
+{
+   /// upper bounds of the buckets in milliseconds, the last bucket counts the longer durations
+   static const std::vector<uint32_t>& bounds_ms();
+
+   std::vector<uint64_t> buckets = std::vector<uint64_t>( bounds_ms().size() + 1, 0 );
+   uint64_t              count = 0;
+   int64_t               total_us = 0;
+   int64_t               max_us = 0;
+
+   void add( const fc::microseconds& duration );
+};
+
+struct production_latency
+{
+   /// assembling the transactions of the next block in advance, see database::prepare_block()
+   latency_histogram preparation;
+   /// generating, signing and applying the block at the slot
+   latency_histogram generation;
+   /// from the slot time to the block handed over to the peers by the broadcast task
+   latency_histogram broadcast_delay;
+};
+
 class witness_plugin : public graphene::app::plugin {
 public:
    ~witness_plugin() { stop_block_production(); }
@@ -67,16 +93,25 @@ public:
    inline const fc::flat_map< chain::witness_id_type, fc::optional<chain::public_key_type> >& get_witness_key_cache()
    { return _witness_key_cache; }
 
+   const production_latency& get_production_latency()const { return _production_latency; }
+
 private:
    void schedule_production_loop();
    block_production_condition::block_production_condition_enum block_production_loop();
    block_production_condition::block_production_condition_enum maybe_produce_block( fc::limited_mutable_variant_object& capture );
+   /// assembles the next block in advance if it is to be produced by one of our witnesses
+   void maybe_prepare_block();
+   /// logs the production latency histograms every production-latency-log-interval seconds
+   void maybe_log_production_latency();
 
    /// Fetch signing keys of all witnesses in the cache from object database and update the cache accordingly
    void refresh_witness_key_cache();
 
    boost::program_options::variables_map _options;
    bool _production_enabled = false;
+   bool _parallel_block_building = false;
+   uint32_t _block_building_threads = 0;
+   bool _block_preparation = false;
    bool _shutting_down = false;
    uint32_t _required_witness_participation = 33 * GRAPHENE_1_PERCENT;
    uint32_t _production_skip_flags = graphene::chain::database::skip_nothing;
@@ -88,6 +123,10 @@ private:
    /// For tracking signing keys of specified witnesses, only update when applied a block
    fc::flat_map< chain::witness_id_type, fc::optional<chain::public_key_type> > _witness_key_cache;
 
+   production_latency _production_latency;
+   uint32_t _latency_log_interval_sec = 3600;
+   fc::time_point _last_latency_log;
+
 };
 
 } } //graphene::witness_plugin
@@ -102,3 +141,6 @@ FC_REFLECT_ENUM(graphene::witness_plugin::block_production_condition::block_prod
                 (lag)
                 (exception_producing_block)
                 (shutdown))
+
+FC_REFLECT(graphene::witness_plugin::latency_histogram, (buckets)(count)(total_us)(max_us))
+FC_REFLECT(graphene::witness_plugin::production_latency, (preparation)(generation)(broadcast_delay))
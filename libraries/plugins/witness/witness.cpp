@@ -30,6 +30,7 @@
 
 #include <fc/thread/thread.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 using namespace graphene::witness_plugin;
@@ -57,6 +58,23 @@ void welcom_chain_banner( const graphene::chain::database& db, const std::string
     std::cerr << std::setfill('*') << std::setw (table_w) << '\n' << std::setfill(' ');
 }
 
+const std::vector<uint32_t>& latency_histogram::bounds_ms()
+{
+   static const std::vector<uint32_t> bounds = { 5, 10, 25, 50, 100, 250, 500, 1000 };
+   return bounds;
+}
+
+void latency_histogram::add( const fc::microseconds& duration )
+{
+   const int64_t us = std::max<int64_t>( duration.count(), 0 );
+   const auto& bounds = bounds_ms();
+   auto itr = std::lower_bound( bounds.begin(), bounds.end(), us / 1000 );
+   ++buckets[itr - bounds.begin()];
+   ++count;
+   total_us += us;
+   max_us = std::max( max_us, us );
+}
+
 void witness_plugin::plugin_set_program_options(
    boost::program_options::options_description& command_line_options,
    boost::program_options::options_description& config_file_options)
@@ -71,6 +89,14 @@ void witness_plugin::plugin_set_program_options(
          ("private-key", bpo::value<vector<string>>()->composing()->multitoken()->
           DEFAULT_VALUE_VECTOR(std::make_pair(chain::public_key_type(default_priv_key.get_public_key()), graphene::utilities::key_to_wif(default_priv_key))),
           "Tuple of [PublicKey, WIF private key] (may specify multiple times)")
+         ("parallel-block-building", bpo::bool_switch()->notifier([this](bool e){_parallel_block_building = e;}),
+          "Verify signatures and authorities of pending transactions in worker threads before applying them in produced blocks")
+         ("block-building-threads", bpo::value<uint32_t>()->notifier([this](uint32_t n){_block_building_threads = n;})->default_value(0),
+          "Number of the worker threads of parallel-block-building, separate from io-threads, 0 for the number of hardware threads")
+         ("block-preparation", bpo::bool_switch()->notifier([this](bool e){_block_preparation = e;}),
+          "Assemble the transactions of the next own block between the slots so that only the late transactions are added at the slot")
+         ("production-latency-log-interval", bpo::value<uint32_t>()->default_value(3600),
+          "Seconds between the logged latency histograms of block preparation and generation, 0 to disable")
          ;
    config_file_options.add(command_line_options);
 }
@@ -85,6 +111,8 @@ void witness_plugin::plugin_initialize(const boost::program_options::variables_m
    ilog("witness plugin:  plugin_initialize() begin");
    _options = &options;
    LOAD_VALUE_SET(options, "witness-id", _witnesses, chain::witness_id_type)
+   if( options.count("production-latency-log-interval") )
+      _latency_log_interval_sec = options["production-latency-log-interval"].as<uint32_t>();
 
    if( options.count("private-key") )
    {
@@ -132,6 +160,7 @@ void witness_plugin::plugin_startup()
          }
          _production_skip_flags |= graphene::chain::database::skip_undo_history_check;
       }
+      d.enable_parallel_block_building( _parallel_block_building, _block_building_threads );
       refresh_witness_key_cache();
       d.applied_block.connect( [this]( const chain::signed_block& b )
       {
@@ -231,8 +260,22 @@ block_production_condition::block_production_condition_enum witness_plugin::bloc
          ilog("Not producing block because production is disabled until we receive a recent block (see: --enable-stale-production)");
          break;
       case block_production_condition::not_my_turn:
-         break;
       case block_production_condition::not_time_yet:
+         if( _block_preparation )
+         {
+            try
+            {
+               maybe_prepare_block();
+            }
+            catch( const fc::canceled_exception& )
+            {
+               throw;
+            }
+            catch( const fc::exception& e )
+            {
+               elog("Got exception while preparing block:\n${e}", ("e", e.to_detail_string()));
+            }
+         }
          break;
       case block_production_condition::no_private_key:
          ilog("Not producing block because I don't have the private key for ${scheduled_key}", (capture) );
@@ -256,6 +299,8 @@ block_production_condition::block_production_condition_enum witness_plugin::bloc
 
    dlog("result = ${r}", ("r", result));
 
+   maybe_log_production_latency();
+
    schedule_production_loop();
    return result;
 }
@@ -330,14 +375,64 @@ block_production_condition::block_production_condition_enum witness_plugin::mayb
       return block_production_condition::lag;
    }
 
+   fc::time_point generation_start = fc::time_point::now();
    auto block = db.generate_block(
       scheduled_time,
       scheduled_witness,
       private_key_itr->second,
       _production_skip_flags
       );
+   fc::time_point generation_end = fc::time_point::now();
+   _production_latency.generation.add( generation_end - generation_start );
+
    capture("n", block.block_num())("t", block.timestamp)("c", now)("x", block.transactions.size());
-   fc::async( [this,block](){ p2p_node().broadcast(net::block_message(block)); } );
+   // the task runs on this thread, so the histogram is not shared with another one
+   fc::async( [this,block,scheduled_time](){
+      p2p_node().broadcast(net::block_message(block));
+      _production_latency.broadcast_delay.add( fc::time_point::now() - fc::time_point( scheduled_time ) );
+   } );
 
    return block_production_condition::produced;
 }
+
+void witness_plugin::maybe_prepare_block()
+{
+   chain::database& db = database();
+   if( !_production_enabled )
+      return;
+
+   // the slot after the one of the current production attempt
+   fc::time_point_sec now = fc::time_point::now() + fc::microseconds( 500000 );
+   uint32_t slot = db.get_slot_at_time( now ) + 1;
+
+   graphene::chain::witness_id_type scheduled_witness = db.get_scheduled_witness( slot );
+   if( _witnesses.find( scheduled_witness ) == _witnesses.end() )
+      return;
+
+   const auto& signing_key = _witness_key_cache[scheduled_witness];
+   if( !signing_key.valid() || _private_keys.find( *signing_key ) == _private_keys.end() )
+      return;
+
+   fc::time_point start = fc::time_point::now();
+   db.prepare_block( scheduled_witness, _production_skip_flags );
+   _production_latency.preparation.add( fc::time_point::now() - start );
+}
+
+void witness_plugin::maybe_log_production_latency()
+{
+   if( _latency_log_interval_sec == 0 || _production_latency.generation.count + _production_latency.preparation.count == 0 )
+      return;
+
+   fc::time_point now = fc::time_point::now();
+   if( _last_latency_log == fc::time_point() )
+   {
+      _last_latency_log = now;
+      return;
+   }
+   if( now - _last_latency_log < fc::seconds( _latency_log_interval_sec ) )
+      return;
+
+   _last_latency_log = now;
+   ilog( "Block production latency, bucket bounds ${b} ms: ${l}",
+         ("b", latency_histogram::bounds_ms())("l", _production_latency) );
+}
@@ -3,11 +3,47 @@
 #include <boost/filesystem/fstream.hpp>
 
 #include <algorithm>
+#include <cctype>
 #include <iostream>
+#include <regex>
 #include <sstream>
 #include <string>
 #include <vector>
 
+/**
+ * Lists every hardfork time defined by the parts as an X-macro:
+ * GRAPHENE_HARDFORKS( X ) expands to X( PLAYCHAIN_1, playchain_1 ) ... for HARDFORK_PLAYCHAIN_1_TIME ...
+ */
+std::string hardfork_list( const std::string& data )
+{
+   static const std::regex define_re( "#define\\s+HARDFORK_([A-Z0-9_]+)_TIME\\b" );
+
+   std::vector< std::string > names;
+   for( std::sregex_iterator it( data.begin(), data.end(), define_re ), end; it != end; ++it )
+   {
+      std::string name = (*it)[1];
+      if( std::find( names.begin(), names.end(), name ) == names.end() )
+         names.push_back( name );
+   }
+
+   if( names.empty() )
+      return std::string();
+
+   std::stringstream ss;
+   ss << "\n// All hardforks above, generated from the names of their times\n";
+   ss << "#define GRAPHENE_HARDFORKS( X )";
+   for( const std::string& name : names )
+   {
+      std::string flag = name;
+      std::transform( flag.begin(), flag.end(), flag.begin(), []( unsigned char c ) { return (char)std::tolower( c ); } );
+      if( std::isdigit( (unsigned char)flag[0] ) )
+         flag = "hf_" + flag;
+      ss << " \\\n   X( " << name << ", " << flag << " )";
+   }
+   ss << "\n";
+   return ss.str();
+}
+
 int main( int argc, char** argv, char** envp )
 {
    if( argc != 3 )
@@ -45,6 +81,7 @@ int main( int argc, char** argv, char** envp )
          ss_data << ifs.rdbuf();
       }
       std::string new_data = ss_data.str();
+      new_data += hardfork_list( new_data );
 
       boost::filesystem::path opath(argv[2]);
 
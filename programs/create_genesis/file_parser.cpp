@@ -12,28 +12,6 @@
 #include <fc/io/json.hpp>
 
 using graphene::chain::public_key_type;
-using graphene::chain::share_type;
-
-namespace playchain {
-namespace util {
-
-struct file_format_type
-{
-    struct user
-    {
-        std::string name;
-        std::string key;
-        std::string owner_key;
-        share_type balance;
-    };
-
-    std::vector<user> users;
-};
-}
-}
-
-FC_REFLECT(playchain::util::file_format_type::user, (name)(key)(owner_key)(balance))
-FC_REFLECT(playchain::util::file_format_type, (users))
 
 namespace playchain {
 namespace util {
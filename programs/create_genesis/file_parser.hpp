@@ -5,9 +5,27 @@
 
 #include <boost/filesystem.hpp>
 
+#include <graphene/chain/protocol/types.hpp>
+
+#include <string>
+#include <vector>
+
 namespace playchain {
 namespace util {
 
+struct file_format_type
+{
+    struct user
+    {
+        std::string name;
+        std::string key;
+        std::string owner_key;
+        share_type balance;
+    };
+
+    std::vector<user> users;
+};
+
 class file_parser : public parser_i
 {
 public:
@@ -21,3 +39,6 @@ private:
 };
 }
 }
+
+FC_REFLECT(playchain::util::file_format_type::user, (name)(key)(owner_key)(balance))
+FC_REFLECT(playchain::util::file_format_type, (users))
@@ -125,6 +125,11 @@ private:
 
 //
 
+void validate_user_name(const std::string& name)
+{
+    FC_ASSERT(name == "X4fWLuj9khEvh" || graphene::chain::is_valid_name(name), "Invalid user name '${n}'", ("n", name));
+}
+
 genesis_mapper::genesis_mapper()
 {
 }
@@ -168,7 +173,7 @@ void genesis_mapper::update(const std::string& name,
                             const share_type& balance)
 {
     // sanitizing
-    FC_ASSERT(name == "X4fWLuj9khEvh" || graphene::chain::is_valid_name(name), "Invalid user name '${n}'", ("n", name));
+    validate_user_name(name);
 
     auto it = _uniq_account_items.find(name);
     if (_uniq_account_items.end() == it)
@@ -21,6 +21,9 @@ using graphene::chain::address;
 
 using genesis_account_info_item_type = fc::static_variant<void_t, account_type, balance_type>;
 
+/// Throws if the imported user name can't be used for an account
+void validate_user_name(const std::string& name);
+
 class genesis_mapper
 {
 public:
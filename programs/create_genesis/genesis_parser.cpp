@@ -11,6 +11,10 @@
 #include <graphene/chain/protocol/fee_schedule.hpp>
 #include <fc/io/json.hpp>
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
 namespace playchain {
 namespace util {
 
@@ -58,7 +62,7 @@ void load(const std::string& path, genesis_state_type& genesis)
 
     fl.close();
 
-    genesis = fc::json::from_string(ss.str()).as<genesis_state_type>(20);
+    genesis = graphene::chain::parse_genesis_state(ss.str(), 20);
 }
 
 void check_users(const genesis_state_type& genesis, const std::vector<std::string>& users)
@@ -141,5 +145,22 @@ void print(genesis_state_type& genesis, bool pretty_print)
     save_to_string(genesis, output_json, pretty_print);
     std::cout << output_json << std::endl;
 }
+
+uint64_t get_peak_rss()
+{
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+    // kilobytes on Linux
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
 }
 }
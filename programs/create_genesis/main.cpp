@@ -9,6 +9,7 @@
 #include <fc/exception/exception.hpp>
 
 #include "file_parser.hpp"
+#include "streaming_file_parser.hpp"
 
 #include "genesis_tester.hpp"
 
@@ -33,7 +34,12 @@ int main(int argc, char** argv)
                 ("suppress-output-json,s", "Do not print result Json genesis.")
                 ("pretty-print,p", "Human readable format for output Json.")
                 ("check-users,u", bpo::value< std::vector<std::string> >()-> multitoken()->composing(), "Users list that are checked in result genesis.")
-                ("output-genesis-json,o", bpo::value<std::string>(), "Path for result Json genesis file.");
+                ("output-genesis-json,o", bpo::value<std::string>(), "Path for result Json genesis file.")
+                ("streaming", "Parse import Json and write result genesis incrementally (requires output-genesis-json, "
+                              "the output is never pretty printed). The names, addresses and balances of all users "
+                              "are still kept in memory, so the peak memory grows with the number of users.")
+                ("chunk-size", bpo::value<uint32_t>()->default_value(100000), "Number of users mapped at once in streaming mode.")
+                ("threads", bpo::value<uint32_t>()->default_value(0), "Threads converting keys in streaming mode, 0 - number of cores.");
         // clang-format on
 
         bpo::variables_map options;
@@ -59,7 +65,29 @@ int main(int argc, char** argv)
             playchain::util::load(options.at("input-genesis-json").as<std::string>(), genesis);
         }
 
-        if (options.count("import-json"))
+        if (options.count("streaming"))
+        {
+            FC_ASSERT(options.count("import-json") && options.count("output-genesis-json"),
+                      "Streaming mode requires import-json and output-genesis-json");
+            FC_ASSERT(!options.count("pretty-print"),
+                      "Streaming mode writes the genesis in the compact form only, remove pretty-print");
+
+            playchain::util::streaming_options streaming;
+            streaming.chunk_size = options.at("chunk-size").as<uint32_t>();
+            streaming.threads = options.at("threads").as<uint32_t>();
+
+            const std::string output_path = options.at("output-genesis-json").as<std::string>();
+            playchain::util::streaming_file_parser fl(options.at("import-json").as<std::string>(), streaming);
+            fl.write(genesis, output_path);
+
+            if (options.count("test-resut-genesis") || options.count("check-users") > 0)
+            {
+                // the checks need the whole result
+                genesis = genesis_state_type{};
+                playchain::util::load(output_path, genesis);
+            }
+        }
+        else if (options.count("import-json"))
         {
             playchain::util::file_parser fl(options.at("import-json").as<std::string>());
 
@@ -103,7 +131,11 @@ int main(int argc, char** argv)
             playchain::util::check_users(genesis, users);
         }
 
-        if (options.count("output-genesis-json"))
+        if (options.count("streaming"))
+        {
+            // the result has been written already
+        }
+        else if (options.count("output-genesis-json"))
         {
             playchain::util::save_to_file(genesis, options.at("output-genesis-json").as<std::string>(),
                                        options.count("pretty-print"));
@@ -113,6 +145,8 @@ int main(int argc, char** argv)
             playchain::util::print(genesis, options.count("pretty-print"));
         }
 
+        ilog("Peak RSS ${m} MB.", ("m", playchain::util::get_peak_rss() / (1024 * 1024)));
+
         return 0;
     }
     FC_CAPTURE_AND_LOG((0))
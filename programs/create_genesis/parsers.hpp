@@ -2,6 +2,7 @@
 
 #include <boost/filesystem.hpp>
 
+#include <cstdint>
 #include <string>
 
 namespace graphene {
@@ -31,5 +32,8 @@ void save_to_string(genesis_state_type&, std::string&, bool pretty_print);
 void save_to_file(genesis_state_type&, const std::string& path, bool pretty_print);
 
 void print(genesis_state_type&, bool pretty_print);
+
+/// @return peak resident set size of the process in bytes
+uint64_t get_peak_rss();
 }
 }
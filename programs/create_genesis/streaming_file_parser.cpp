@@ -0,0 +1,473 @@
+#include "streaming_file_parser.hpp"
+
+#include <boost/filesystem/fstream.hpp>
+
+#include <graphene/chain/genesis_state.hpp>
+#include <graphene/chain/protocol/address.hpp>
+
+#include <fc/io/json.hpp>
+#include <fc/variant_object.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <future>
+#include <map>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace playchain {
+namespace util {
+
+namespace {
+
+/**
+ * Reads elements of a top level JSON array one by one without loading the whole document
+ */
+class json_array_reader
+{
+public:
+    json_array_reader(std::istream& in, const std::string& array_name)
+        : _buf(in.rdbuf())
+    {
+        FC_ASSERT(skip_whitespace() == '{', "JSON object expected");
+        while (true)
+        {
+            int c = skip_whitespace();
+            if (c == ',')
+                continue;
+            FC_ASSERT(c == '"', "Array '${a}' is not found", ("a", array_name));
+
+            std::string raw_key;
+            read_value(c, &raw_key);
+            const std::string key = fc::json::from_string(raw_key).as_string();
+
+            FC_ASSERT(skip_whitespace() == ':', "Colon expected after '${k}'", ("k", key));
+            c = skip_whitespace();
+            if (key == array_name)
+            {
+                FC_ASSERT(c == '[', "'${a}' is not an array", ("a", array_name));
+                return;
+            }
+            read_value(c, nullptr);
+        }
+    }
+
+    /// @return false if there are no more elements
+    bool next(std::string& element)
+    {
+        if (_done)
+            return false;
+
+        int c = skip_whitespace();
+        if (c == ',')
+            c = skip_whitespace();
+        if (c == ']')
+        {
+            _done = true;
+            return false;
+        }
+
+        element.clear();
+        read_value(c, &element);
+        return true;
+    }
+
+private:
+    int get()
+    {
+        if (_peeked != EOF)
+        {
+            int c = _peeked;
+            _peeked = EOF;
+            return c;
+        }
+        return _buf->sbumpc();
+    }
+
+    int skip_whitespace()
+    {
+        int c = get();
+        while (c != EOF && std::isspace(c))
+            c = get();
+        FC_ASSERT(c != EOF, "Unexpected end of file");
+        return c;
+    }
+
+    void read_value(int c, std::string* out)
+    {
+        uint32_t depth = 0;
+        bool in_string = false;
+        for (;; c = get())
+        {
+            FC_ASSERT(c != EOF, "Unexpected end of file");
+            if (!in_string && depth == 0 && (c == ',' || c == '}' || c == ']' || std::isspace(c)))
+            {
+                // end of a scalar value
+                _peeked = c;
+                return;
+            }
+
+            if (out)
+                out->push_back(static_cast<char>(c));
+
+            if (in_string)
+            {
+                if (c == '\\')
+                {
+                    c = get();
+                    FC_ASSERT(c != EOF, "Unexpected end of file");
+                    if (out)
+                        out->push_back(static_cast<char>(c));
+                }
+                else if (c == '"')
+                {
+                    in_string = false;
+                    if (depth == 0)
+                        return;
+                }
+                continue;
+            }
+
+            if (c == '"')
+                in_string = true;
+            else if (c == '{' || c == '[')
+                ++depth;
+            else if ((c == '}' || c == ']') && --depth == 0)
+                return;
+        }
+    }
+
+    std::streambuf* _buf;
+    int _peeked = EOF;
+    bool _done = false;
+};
+
+struct mapped_user
+{
+    account_type account;
+    address account_address;
+    share_type balance;
+};
+
+mapped_user map_user(const std::string& json)
+{
+    const auto user = fc::json::from_string(json).as<file_format_type::user>(3);
+
+    validate_user_name(user.name);
+
+    mapped_user result;
+    result.account = account_type(user.name,
+                                  public_key_type{ user.owner_key.empty() ? user.key : user.owner_key },
+                                  public_key_type{ user.key },
+                                  true);
+    result.account_address = address{ result.account.active_key };
+    result.balance = user.balance;
+    return result;
+}
+
+/// Parses the users and converts their keys in parallel, the order of the users is kept
+std::vector<mapped_user> map_users(const std::vector<std::string>& chunk, uint32_t threads)
+{
+    std::vector<mapped_user> result(chunk.size());
+
+    const size_t slice = (chunk.size() + threads - 1) / threads;
+    std::vector<std::future<void>> workers;
+    for (size_t from = 0; from < chunk.size(); from += slice)
+    {
+        const size_t to = std::min(chunk.size(), from + slice);
+        workers.emplace_back(std::async(std::launch::async, [&chunk, &result, from, to]() {
+            for (size_t ci = from; ci < to; ++ci)
+            {
+                result[ci] = map_user(chunk[ci]);
+            }
+        }));
+    }
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+
+    return result;
+}
+
+/**
+ * Accounts sorted by address, spilled to temporary files whenever a chunk is collected
+ * and merged when the genesis is written
+ */
+class sorted_accounts
+{
+public:
+    sorted_accounts(const boost::filesystem::path& prefix, size_t chunk_size)
+        : _prefix(prefix)
+        , _chunk_size(chunk_size)
+    {
+    }
+
+    ~sorted_accounts()
+    {
+        for (const auto& path : _runs)
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove(path, ec);
+        }
+    }
+
+    void add(const address& account_address, const account_type& account)
+    {
+        // the hex of the address bytes orders as the addresses do
+        _chunk.emplace_back(account_address.addr.str(), fc::json::to_string(account));
+        if (_chunk.size() >= _chunk_size)
+            spill();
+    }
+
+    /// Writes the accounts as the elements of a JSON array in the address order
+    void write(std::ostream& out)
+    {
+        spill();
+
+        std::vector<std::unique_ptr<boost::filesystem::ifstream>> runs;
+        // next line of every run by its address
+        std::multimap<std::string, std::pair<std::string, size_t>> heads;
+        auto read_next = [&](size_t ri) {
+            std::string line;
+            if (std::getline(*runs[ri], line))
+            {
+                const size_t separator = line.find(' ');
+                FC_ASSERT(separator != std::string::npos);
+                heads.emplace(line.substr(0, separator), std::make_pair(line.substr(separator + 1), ri));
+            }
+        };
+
+        for (size_t ri = 0; ri < _runs.size(); ++ri)
+        {
+            runs.emplace_back(new boost::filesystem::ifstream(_runs[ri], std::ios::in | std::ios::binary));
+            FC_ASSERT((bool)*runs.back(), "Can't read file ${p}.", ("p", _runs[ri].string()));
+            read_next(ri);
+        }
+
+        bool first = true;
+        while (!heads.empty())
+        {
+            auto head = heads.begin();
+            out << (first ? "" : ",") << head->second.first;
+            first = false;
+
+            const size_t ri = head->second.second;
+            heads.erase(head);
+            read_next(ri);
+        }
+    }
+
+private:
+    void spill()
+    {
+        if (_chunk.empty())
+            return;
+
+        std::sort(_chunk.begin(), _chunk.end());
+
+        boost::filesystem::path path(_prefix.string() + ".accounts." + fc::to_string(_runs.size()));
+        boost::filesystem::ofstream run(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        FC_ASSERT((bool)run, "Can't write to file ${p}.", ("p", path.string()));
+        _runs.push_back(path);
+        for (const auto& account : _chunk)
+        {
+            run << account.first << ' ' << account.second << '\n';
+        }
+        run.close();
+        FC_ASSERT((bool)run, "Can't write to file ${p}.", ("p", path.string()));
+
+        _chunk.clear();
+    }
+
+    boost::filesystem::path _prefix;
+    size_t _chunk_size;
+    std::vector<std::pair<std::string, std::string>> _chunk;
+    std::vector<boost::filesystem::path> _runs;
+};
+
+/**
+ * Follows the rules of genesis_mapper: the first account with a name or an address wins,
+ * the last balance of an address wins
+ */
+class streaming_mapper
+{
+public:
+    explicit streaming_mapper(sorted_accounts& accounts)
+        : _accounts(accounts)
+    {
+    }
+
+    void update(const account_type& account, const address& account_address, const share_type& balance)
+    {
+        auto it = _account_addresses.find(account.name);
+        if (_account_addresses.end() == it)
+        {
+            it = _account_addresses.emplace(account.name, account_address).first;
+
+            if (_addresses.insert(account_address).second)
+            {
+                _accounts.add(account_address, account);
+                ++_accounts_count;
+            }
+            else
+            {
+                wlog("Conflict account address for '${new}'. First has been chosen", ("new", account.name));
+            }
+        }
+
+        if (balance > 0)
+        {
+            update(balance_type{ it->second, GRAPHENE_ADDRESS_PREFIX, balance });
+        }
+    }
+
+    void update(const balance_type& balance)
+    {
+        balance_type& item = _balances[balance.owner];
+        _accounts_supply -= item.amount;
+        item = balance;
+        _accounts_supply += item.amount;
+    }
+
+    uint64_t accounts_count() const
+    {
+        return _accounts_count;
+    }
+
+    const std::map<address, balance_type>& balances() const
+    {
+        return _balances;
+    }
+
+    share_type accounts_supply() const
+    {
+        return _accounts_supply;
+    }
+
+private:
+    sorted_accounts& _accounts;
+    std::unordered_map<std::string, address> _account_addresses;
+    std::unordered_set<address> _addresses;
+    std::map<address, balance_type> _balances;
+    share_type _accounts_supply = 0;
+    uint64_t _accounts_count = 0;
+};
+}
+
+streaming_file_parser::streaming_file_parser(const boost::filesystem::path& import_path, const streaming_options& options)
+    : _path(import_path)
+    , _options(options)
+{
+    FC_ASSERT(boost::filesystem::exists(_path), "Path ${p} does not exists.", ("p", _path.string()));
+    FC_ASSERT(_options.chunk_size > 0);
+
+    _path.normalize();
+
+    if (!_options.threads)
+        _options.threads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+void streaming_file_parser::write(const genesis_state_type& base, const boost::filesystem::path& output_path)
+{
+    boost::filesystem::path path_to_save(output_path);
+    path_to_save.normalize();
+
+    ilog("Streaming ${file} to ${out} by ${n} users with ${t} threads.",
+         ("file", _path.string())("out", path_to_save.string())("n", _options.chunk_size)("t", _options.threads));
+
+    boost::filesystem::ifstream in;
+    in.open(_path, std::ios::in | std::ios::binary);
+    FC_ASSERT((bool)in, "Can't read file ${p}.", ("p", _path.string()));
+
+    sorted_accounts accounts(path_to_save, _options.chunk_size);
+    streaming_mapper mapper(accounts);
+    for (const auto& account : base.initial_accounts)
+    {
+        mapper.update(account, address{ account.active_key }, 0);
+    }
+    for (const auto& balance : base.initial_balances)
+    {
+        mapper.update(balance);
+    }
+
+    json_array_reader reader(in, "users");
+    std::vector<std::string> chunk;
+    chunk.reserve(_options.chunk_size);
+    uint64_t users_count = 0;
+    bool more = true;
+    while (more)
+    {
+        chunk.clear();
+        std::string element;
+        while (chunk.size() < _options.chunk_size && (more = reader.next(element)))
+        {
+            chunk.emplace_back(std::move(element));
+        }
+
+        for (const auto& user : map_users(chunk, _options.threads))
+        {
+            mapper.update(user.account, user.account_address, user.balance);
+        }
+
+        users_count += chunk.size();
+        if (!chunk.empty())
+            ilog("Mapped ${n} users.", ("n", users_count));
+    }
+
+    ilog("MAX_CORE_SUPPLY - ACCOUNTS_SUPPLY = ${d}", ("d", base.max_core_supply - mapper.accounts_supply()));
+
+    FC_ASSERT(base.max_core_supply >= mapper.accounts_supply(),
+              "Invalid actual accounts supply. Received '${as}', but required '${rs}'",
+              ("as", mapper.accounts_supply())("rs", base.max_core_supply));
+
+    boost::filesystem::ofstream out;
+    out.open(path_to_save, std::ios::out | std::ios::binary | std::ios::trunc);
+    FC_ASSERT((bool)out, "Can't write to file ${p}.", ("p", path_to_save.string()));
+
+    // the output is the same as save_to_file() writes for the mapped genesis without pretty printing,
+    // so the chain id (the hash of the file) does not depend on the mode
+    genesis_state_type header = base;
+    header.initial_accounts.clear();
+    header.initial_balances.clear();
+
+    fc::variant vo;
+    fc::to_variant(header, vo, 20);
+    bool first = true;
+    for (const auto& entry : vo.get_object())
+    {
+        out << (first ? "{" : ",") << fc::json::to_string(fc::variant(entry.key())) << ":";
+        first = false;
+
+        if (entry.key() == "initial_accounts")
+        {
+            out << "[";
+            accounts.write(out);
+            out << "]";
+        }
+        else if (entry.key() == "initial_balances")
+        {
+            out << "[";
+            bool first_balance = true;
+            for (const auto& balance : mapper.balances())
+            {
+                out << (first_balance ? "" : ",") << fc::json::to_string(balance.second);
+                first_balance = false;
+            }
+            out << "]";
+        }
+        else
+        {
+            out << fc::json::to_string(entry.value());
+        }
+    }
+    out << "}";
+    out.close();
+    FC_ASSERT((bool)out, "Can't write to file ${p}.", ("p", path_to_save.string()));
+
+    ilog("Saved ${a} accounts and ${b} balances.", ("a", mapper.accounts_count())("b", mapper.balances().size()));
+}
+}
+}
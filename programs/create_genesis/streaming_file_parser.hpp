@@ -0,0 +1,41 @@
+#pragma once
+
+#include "file_parser.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+
+namespace playchain {
+namespace util {
+
+struct streaming_options
+{
+    /// number of imported users mapped at once
+    uint32_t chunk_size = 100000;
+    /// threads parsing the users and converting their keys, 0 - hardware concurrency
+    uint32_t threads = 0;
+};
+
+/**
+ * Maps the users of the import file to the genesis entries in bounded-size chunks
+ * and writes the result genesis JSON incrementally.
+ *
+ * Only the names, addresses and balances of the users stay in memory, the mapped accounts
+ * are sorted in chunks on disk next to the output. The result is written byte for byte as
+ * genesis_mapper saves it without pretty printing, so both give the same chain id.
+ */
+class streaming_file_parser
+{
+public:
+    streaming_file_parser(const boost::filesystem::path& import_path, const streaming_options& options);
+
+    /// Writes the base genesis extended by the imported users to the output path
+    void write(const genesis_state_type& base, const boost::filesystem::path& output_path);
+
+private:
+    boost::filesystem::path _path;
+    streaming_options _options;
+};
+}
+}
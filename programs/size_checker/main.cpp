@@ -23,9 +23,11 @@
  */
 
 #include <fc/io/json.hpp>
+#include <fc/reflect/variant.hpp>
 #include <fc/variant.hpp>
 #include <fc/variant_object.hpp>
 
+#include <graphene/chain/database.hpp>
 #include <graphene/chain/protocol/block.hpp>
 #include <graphene/chain/protocol/fee_schedule.hpp>
 
@@ -64,8 +66,61 @@ struct size_check_type_visitor
    }
 };
 
+/**
+ * Loads the object database saved in data_dir (the "blockchain" directory of a node) and prints
+ * the estimated memory usage of every index, biggest first. Nothing is written to data_dir.
+ */
+int print_memory_usage( const fc::path& data_dir )
+{
+   try
+   {
+      database db;
+      db.object_database::open( data_dir );
+
+      vector<index_memory_usage> usage = db.get_memory_usage();
+      std::stable_sort( usage.begin(), usage.end(),
+      [](const index_memory_usage& a, const index_memory_usage& b) {
+      return a.total_bytes() > b.total_bytes();
+      });
+
+      index_memory_usage total;
+      std::cout << "[\n";
+      for( size_t i=0; i<usage.size(); i++ )
+      {
+         fc::variant v;
+         fc::to_variant( usage[i], v, 2 );
+         fc::mutable_variant_object vo( v.get_object() );
+         vo["total_bytes"] = usage[i].total_bytes();
+         std::cout << "   " << fc::json::to_string( vo );
+         if( i < usage.size()-1 )
+            std::cout << ",\n";
+         else
+            std::cout << "\n";
+
+         total.object_count += usage[i].object_count;
+         total.object_bytes += usage[i].object_bytes;
+         total.dynamic_bytes += usage[i].dynamic_bytes;
+         total.container_bytes += usage[i].container_bytes;
+         total.secondary_index_bytes += usage[i].secondary_index_bytes;
+         total.undo_entries += usage[i].undo_entries;
+         total.undo_bytes += usage[i].undo_bytes;
+      }
+      std::cout << "]\n";
+      std::cerr << "Total: " << total.object_count << " objects, " << total.total_bytes() << " bytes\n";
+   }
+   catch ( const fc::exception& e )
+   {
+      edump((e.to_detail_string()));
+      return 1;
+   }
+   return 0;
+}
+
 int main( int argc, char** argv )
 {
+   if( argc == 3 && std::string( argv[1] ) == "--memory-usage" )
+      return print_memory_usage( fc::path( argv[2] ) );
+
    try
    {
       graphene::chain::operation op;
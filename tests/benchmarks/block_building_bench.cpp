@@ -0,0 +1,402 @@
+#include "../playchain/playchain_common.hpp"
+
+#include <playchain/chain/schema/table_object.hpp>
+#include <playchain/chain/schema/pending_buy_in_object.hpp>
+#include <playchain/chain/evaluators/validators.hpp>
+#include <playchain/chain/playchain_config.hpp>
+#include <graphene/chain/hardfork.hpp>
+
+namespace block_building_bench
+{
+struct block_building_fixture: public playchain_common::playchain_fixture
+{
+    const int64_t registrator_init_balance = 3000*GRAPHENE_BLOCKCHAIN_PRECISION;
+    const uint32_t operations_per_block = 5000;
+
+    DECLARE_ACTOR(richregistrator)
+    DECLARE_ACTOR(alice)
+    DECLARE_ACTOR(bob)
+
+    block_building_fixture()
+    {
+        actor(richregistrator).supply(asset(registrator_init_balance));
+    }
+
+    void push_table_transactions(const room_id_type &room, const std::string &prefix)
+    {
+        for (uint32_t ci = 0; ci < operations_per_block; ++ci)
+        {
+            signed_transaction tx;
+            tx.operations.push_back(create_table_op(richregistrator, room, 0u, prefix + fc::to_string(ci)));
+            test::set_expiration(db, tx);
+            sign(tx, richregistrator.private_key);
+            db.push_transaction(tx, ~0);
+        }
+    }
+
+    fc::microseconds measure_block_generation(uint32_t &transactions)
+    {
+        // let the witness re-verify transaction signatures as a block producer does
+        const uint32_t skip = ~0u & ~database::skip_transaction_signatures;
+
+        fc::time_point start = fc::time_point::now();
+        auto block = generate_block(skip);
+        fc::microseconds elapsed = fc::time_point::now() - start;
+
+        transactions = (uint32_t)block.transactions.size();
+        return elapsed;
+    }
+
+    fc::microseconds measure_heartbeat_apply(const std::vector<operation> &ops)
+    {
+        signed_transaction tx;
+        tx.operations = ops;
+        test::set_expiration(db, tx);
+        sign(tx, richregistrator.private_key);
+
+        fc::time_point start = fc::time_point::now();
+        db.push_transaction(tx, ~0);
+        fc::microseconds elapsed = fc::time_point::now() - start;
+
+        generate_block();
+        return elapsed;
+    }
+
+    ///signs and pushes every operation by separate transaction as the game witness does
+    fc::microseconds measure_votes_push(const std::vector<operation> &ops)
+    {
+        //let the node verify transaction signatures as it does for the incoming transactions
+        const uint32_t skip = ~0u & ~database::skip_transaction_signatures;
+
+        fc::time_point start = fc::time_point::now();
+        for (const auto &op: ops)
+        {
+            signed_transaction tx;
+            tx.operations.push_back(op);
+            test::set_expiration(db, tx);
+            sign(tx, richregistrator.private_key);
+            db.push_transaction(tx, skip);
+        }
+        fc::microseconds elapsed = fc::time_point::now() - start;
+
+        generate_block();
+        return elapsed;
+    }
+
+    std::vector<table_id_type> create_tables_with_players(const room_id_type &room, const std::string &prefix,
+                                                          const uint32_t tables_count, const asset &stake)
+    {
+        std::vector<table_id_type> tables;
+        for (uint32_t ci = 0; ci < tables_count; ++ci)
+        {
+            table_id_type table = create_new_table(richregistrator, room, 0u, prefix + fc::to_string(ci));
+            buy_in_table(alice, richregistrator, table, stake);
+            buy_in_table(bob, richregistrator, table, stake);
+            tables.push_back(table);
+        }
+        generate_block();
+        return tables;
+    }
+
+    struct block_apply_stats
+    {
+        fc::microseconds apply_time;
+        uint64_t         allocations = 0;
+        uint64_t         heap_allocations = 0;
+        uint32_t         allocated_buy_ins = 0;
+    };
+
+    ///reserves buy-ins for the new players and measures the block allocating the tables for them
+    block_apply_stats measure_buy_in_allocation(const std::string &prefix, const std::string &meta,
+                                                const uint32_t players_count, const uint32_t tables_count)
+    {
+        room_id_type room = create_new_room(richregistrator, prefix);
+
+        generate_block();
+
+        for (uint32_t ci = 0; ci < tables_count; ++ci)
+        {
+            signed_transaction tx;
+            tx.operations.push_back(create_table_op(richregistrator, room, 0u, meta));
+            test::set_expiration(db, tx);
+            sign(tx, richregistrator.private_key);
+            db.push_transaction(tx, ~0);
+        }
+
+        auto stake = asset(player_init_balance/2);
+
+        std::vector<Actor> players;
+        for (uint32_t ci = 0; ci < players_count; ++ci)
+        {
+            players.emplace_back(create_new_player(richregistrator, prefix + fc::to_string(ci), asset(player_init_balance)));
+        }
+
+        next_maintenance();
+
+        for (const auto &player: players)
+        {
+            buy_in_reserve(player, get_next_uid(actor(player)), stake, meta);
+        }
+
+        const block_arena &arena = db.get_block_arena();
+
+        block_apply_stats result;
+        uint64_t allocations = arena.allocations();
+        uint64_t heap_allocations = arena.heap_allocations();
+        fc::time_point start = fc::time_point::now();
+        generate_block();
+        result.apply_time = fc::time_point::now() - start;
+        result.allocations = arena.allocations() - allocations;
+        result.heap_allocations = arena.heap_allocations() - heap_allocations;
+
+        for (const auto &buy_in: db.get_index_type<pending_buy_in_index>().indices())
+        {
+            if (buy_in.id != PLAYCHAIN_NULL_PENDING_BUYIN && buy_in.is_allocated() && buy_in.metadata == meta)
+                ++result.allocated_buy_ins;
+        }
+        return result;
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE( block_building_bench, block_building_fixture)
+
+PLAYCHAIN_TEST_CASE(parallel_block_building_bench)
+{
+    room_id_type room = create_new_room(richregistrator);
+
+    generate_block();
+
+    uint32_t serial_transactions = 0;
+    push_table_transactions(room, "serial #");
+    db.enable_parallel_block_building(false);
+    auto serial_time = measure_block_generation(serial_transactions);
+
+    uint32_t parallel_transactions = 0;
+    push_table_transactions(room, "parallel #");
+    db.enable_parallel_block_building(true);
+    auto parallel_time = measure_block_generation(parallel_transactions);
+    db.enable_parallel_block_building(false);
+
+    BOOST_CHECK_EQUAL(serial_transactions, operations_per_block);
+    BOOST_CHECK_EQUAL(parallel_transactions, operations_per_block);
+
+    const auto &tables_by_room = db.get_index_type<table_index>().indices().get<by_room>();
+    BOOST_CHECK_EQUAL(tables_by_room.count(room), 2 * operations_per_block);
+
+    ilog("Block with ${n} table_create operations: serial ${s} ms, parallel ${p} ms",
+         ("n", operations_per_block)
+         ("s", serial_time.count() / 1000)
+         ("p", parallel_time.count() / 1000));
+}
+
+PLAYCHAIN_TEST_CASE(room_heartbeat_apply_bench)
+{
+    generate_blocks(HARDFORK_PLAYCHAIN_12_TIME);
+
+    //separate rooms so that the heartbeats of the one kind do not affect the others
+    room_id_type tables_room = create_new_room(richregistrator, "tables");
+    room_id_type room = create_new_room(richregistrator, "room");
+
+    generate_block();
+
+    push_table_transactions(tables_room, "table #");
+    generate_block();
+    push_table_transactions(room, "table #");
+    generate_block();
+
+    std::vector<operation> tables_alive_ops;
+    std::set<table_id_type> tables;
+    const auto &tables_by_room = db.get_index_type<table_index>().indices().get<by_room>();
+    auto range = tables_by_room.equal_range(std::make_tuple(tables_room));
+    for (auto itr = range.first; itr != range.second; ++itr)
+    {
+        tables.insert(itr->id);
+        if (tables.size() == PLAYCHAIN_MAX_SIZE_FOR_TABLES_ALIVE_PER_OP)
+        {
+            tables_alive_ops.emplace_back(tables_alive_op(richregistrator, tables));
+            tables.clear();
+        }
+    }
+    if (!tables.empty())
+        tables_alive_ops.emplace_back(tables_alive_op(richregistrator, tables));
+
+    std::vector<operation> room_alive_ops{room_alive_op(richregistrator, room)};
+
+    //the first heartbeats create the alive objects and update weights, the next ones only prolong them
+    auto tables_first_time = measure_heartbeat_apply(tables_alive_ops);
+    auto tables_renew_time = measure_heartbeat_apply(tables_alive_ops);
+
+    auto room_first_time = measure_heartbeat_apply(room_alive_ops);
+    auto room_renew_time = measure_heartbeat_apply(room_alive_ops);
+
+    BOOST_CHECK(is_table_alive(db, range.first->id));
+    BOOST_CHECK(is_room_alive(db, room));
+    BOOST_CHECK(is_table_alive(db, tables_by_room.lower_bound(std::make_tuple(room))->id));
+
+    ilog("Heartbeat for ${n} tables: ${ops} tables_alive operations ${tf}/${tr} us, room_alive operation ${rf}/${rr} us (first/renewal)",
+         ("n", operations_per_block)
+         ("ops", tables_alive_ops.size())
+         ("tf", tables_first_time.count())
+         ("tr", tables_renew_time.count())
+         ("rf", room_first_time.count())
+         ("rr", room_renew_time.count()));
+}
+
+PLAYCHAIN_TEST_CASE(batched_game_votes_bench)
+{
+    const uint32_t tables_count = 500;
+
+    generate_blocks(HARDFORK_PLAYCHAIN_13_TIME);
+
+    CREATE_PLAYER(richregistrator, alice);
+    CREATE_PLAYER(richregistrator, bob);
+
+    room_id_type room = create_new_room(richregistrator);
+
+    generate_block();
+
+    //separate tables because the owner can vote only once for the table
+    auto stake = asset(player_init_balance / (4 * tables_count));
+    auto single_tables = create_tables_with_players(room, "single #", tables_count, stake);
+    auto batch_tables = create_tables_with_players(room, "batch #", tables_count, stake);
+
+    game_initial_data initial;
+    initial.cash[actor(alice)] = stake;
+    initial.cash[actor(bob)] = stake;
+    initial.info = "alice is diller";
+
+    std::vector<operation> single_ops;
+    for (const auto &table: single_tables)
+    {
+        single_ops.emplace_back(game_start_playing_check_op(richregistrator, richregistrator, table, initial));
+    }
+
+    std::vector<operation> batch_ops;
+    std::map<table_id_type, voting_data_type> votes;
+    for (const auto &table: batch_tables)
+    {
+        votes[table] = initial;
+        if (votes.size() == PLAYCHAIN_MAX_SIZE_FOR_GAME_VOTES_PER_OP)
+        {
+            batch_ops.emplace_back(game_votes_check_op(richregistrator, richregistrator, votes));
+            votes.clear();
+        }
+    }
+    if (!votes.empty())
+        batch_ops.emplace_back(game_votes_check_op(richregistrator, richregistrator, votes));
+
+    auto single_time = measure_votes_push(single_ops);
+    auto batch_time = measure_votes_push(batch_ops);
+
+    for (const auto &table: single_tables)
+    {
+        BOOST_CHECK(is_table_voting(db, table));
+    }
+    for (const auto &table: batch_tables)
+    {
+        BOOST_CHECK(is_table_voting(db, table));
+    }
+
+    ilog("Votes for ${n} tables: ${s} game_start_playing_check transactions ${st} ms, ${b} game_votes_check transactions ${bt} ms",
+         ("n", tables_count)
+         ("s", single_ops.size())
+         ("st", single_time.count() / 1000)
+         ("b", batch_ops.size())
+         ("bt", batch_time.count() / 1000));
+}
+
+PLAYCHAIN_TEST_CASE(buy_in_allocation_bench)
+{
+    const std::string meta = "Game";
+    const uint32_t players_count = PLAYCHAIN_DEFAULT_PENDING_BUY_IN_ALLOCATE_PER_BLOCK;
+    const uint32_t tables_count = 1000;
+
+    room_id_type room = create_new_room(richregistrator);
+
+    generate_block();
+
+    for (uint32_t ci = 0; ci < tables_count; ++ci)
+    {
+        signed_transaction tx;
+        tx.operations.push_back(create_table_op(richregistrator, room, 0u, meta));
+        test::set_expiration(db, tx);
+        sign(tx, richregistrator.private_key);
+        db.push_transaction(tx, ~0);
+    }
+
+    auto stake = asset(player_init_balance/2);
+
+    std::vector<Actor> players;
+    for (uint32_t ci = 0; ci < players_count; ++ci)
+    {
+        players.emplace_back(create_new_player(richregistrator, "allocplayer" + fc::to_string(ci), asset(player_init_balance)));
+    }
+
+    next_maintenance();
+
+    //the evaluators look up the player of every reserving account
+    fc::time_point start = fc::time_point::now();
+    for (const auto &player: players)
+    {
+        buy_in_reserve(player, get_next_uid(actor(player)), stake, meta);
+    }
+    fc::microseconds reserve_time = fc::time_point::now() - start;
+
+    //the block allocates tables for all pending buy-ins
+    start = fc::time_point::now();
+    generate_block();
+    fc::microseconds allocation_time = fc::time_point::now() - start;
+
+    const auto &pending_buy_ins = db.get_index_type<pending_buy_in_index>().indices();
+    uint32_t allocated = 0;
+    for (const auto &buy_in: pending_buy_ins)
+    {
+        if (buy_in.id != PLAYCHAIN_NULL_PENDING_BUYIN && buy_in.is_allocated())
+            ++allocated;
+    }
+    BOOST_CHECK_EQUAL(allocated, players_count);
+
+    ilog("Buy-in reserving for ${n} players among ${t} tables: reserve ${r} us, allocation block ${a} us (${p} us per buy-in)",
+         ("n", players_count)
+         ("t", tables_count)
+         ("r", reserve_time.count())
+         ("a", allocation_time.count())
+         ("p", allocation_time.count() / players_count));
+}
+
+PLAYCHAIN_TEST_CASE(block_arena_bench)
+{
+    const uint32_t players_count = PLAYCHAIN_DEFAULT_PENDING_BUY_IN_ALLOCATE_PER_BLOCK;
+    const uint32_t tables_count = 1000;
+
+    //the arena is switched after the next applied block
+    db.enable_block_arena(false);
+    generate_block();
+    BOOST_REQUIRE(!db.get_block_arena().enabled());
+
+    auto heap_stats = measure_buy_in_allocation("heapplayer", "heap tables", players_count, tables_count);
+
+    db.enable_block_arena(true);
+    generate_block();
+    BOOST_REQUIRE(db.get_block_arena().enabled());
+
+    auto arena_stats = measure_buy_in_allocation("arenaplayer", "arena tables", players_count, tables_count);
+
+    BOOST_CHECK_EQUAL(heap_stats.heap_allocations, heap_stats.allocations);
+    BOOST_CHECK_LT(arena_stats.heap_allocations, heap_stats.heap_allocations);
+    BOOST_CHECK_EQUAL(heap_stats.allocated_buy_ins, players_count);
+    BOOST_CHECK_EQUAL(arena_stats.allocated_buy_ins, players_count);
+
+    ilog("Block allocating ${n} buy-ins: heap ${ha} of ${hr} allocations ${ht} us, arena ${aa} of ${ar} allocations ${at} us (${c} bytes)",
+         ("n", players_count)
+         ("ha", heap_stats.heap_allocations)
+         ("hr", heap_stats.allocations)
+         ("ht", heap_stats.apply_time.count())
+         ("aa", arena_stats.heap_allocations)
+         ("ar", arena_stats.allocations)
+         ("at", arena_stats.apply_time.count())
+         ("c", db.get_block_arena().capacity()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2015 Cryptonomex, Inc., and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "streaming_file_parser.hpp"
+
+#include <graphene/chain/genesis_state.hpp>
+#include <graphene/utilities/tempdir.hpp>
+
+#include <fc/crypto/digest.hpp>
+#include <fc/crypto/sha256.hpp>
+#include <fc/io/json.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include <iterator>
+#include <set>
+
+using namespace graphene::chain;
+
+namespace
+{
+   // every 100th user repeats the name of the previous one and every 101st one repeats its key
+   int name_id_of( int i ) { return ( i % 100 == 1 ) ? i - 1 : i; }
+   int key_id_of( int i ) { return ( i % 101 == 2 ) ? i - 1 : i; }
+
+   void write_import_file( const boost::filesystem::path& path, const int user_count )
+   {
+      boost::filesystem::ofstream out( path, std::ios::out | std::ios::binary | std::ios::trunc );
+      out << "{\"users\": [";
+      for( int i = 0; i < user_count; ++i )
+      {
+         playchain::util::file_format_type::user user;
+         user.name = "user" + fc::to_string( name_id_of( i ) );
+         user.key = std::string( public_key_type( fc::ecc::private_key::regenerate( fc::digest( key_id_of( i ) ) ).get_public_key() ) );
+         user.balance = ( i % 3 ) * 1000;
+         out << ( i ? ",\n" : "\n" ) << fc::json::to_string( user );
+      }
+      out << "\n]}\n";
+   }
+
+   std::string read_file( const boost::filesystem::path& path )
+   {
+      boost::filesystem::ifstream in( path, std::ios::in | std::ios::binary );
+      return std::string( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+   }
+}
+
+BOOST_AUTO_TEST_CASE( create_genesis_streaming_bench )
+{
+   try {
+#ifdef NDEBUG
+      const int user_count = 2000000;
+#else
+      const int user_count = 20000;
+#endif
+
+      fc::temp_directory data_dir( graphene::utilities::temp_directory_path() );
+      const boost::filesystem::path import_path = data_dir.path() / "import.json";
+      const boost::filesystem::path output_path = data_dir.path() / "genesis.json";
+
+      write_import_file( import_path, user_count );
+
+      genesis_state_type base;
+
+      playchain::util::streaming_options options;
+      options.chunk_size = 10000;
+
+      fc::time_point start_time = fc::time_point::now();
+      playchain::util::streaming_file_parser( import_path, options ).write( base, output_path );
+      const fc::microseconds streaming_time = fc::time_point::now() - start_time;
+
+      genesis_state_type streamed;
+      playchain::util::load( output_path.string(), streamed );
+
+      // the first user with a name or a key wins
+      std::set<int> names, keys;
+      int expected_accounts = 0;
+      for( int i = 0; i < user_count; ++i )
+      {
+         if( names.insert( name_id_of( i ) ).second && keys.insert( key_id_of( i ) ).second )
+            ++expected_accounts;
+      }
+      BOOST_CHECK_EQUAL( streamed.initial_accounts.size(), (size_t)expected_accounts );
+      for( const auto& balance : streamed.initial_balances )
+         BOOST_CHECK( balance.amount > 0 );
+
+      ilog( "Streamed ${n} users in ${t} ms, peak RSS ${m} MB.",
+            ("n", user_count)("t", streaming_time.count() / 1000)
+            ("m", playchain::util::get_peak_rss() / ( 1024 * 1024 )) );
+
+      // the legacy mapper keeps the whole import in memory, compare on a part only
+      if( user_count <= 20000 )
+      {
+         const boost::filesystem::path legacy_path = data_dir.path() / "legacy_genesis.json";
+
+         genesis_state_type mapped = base;
+         playchain::util::file_parser( import_path ).update( mapped );
+         playchain::util::save_to_file( mapped, legacy_path.string(), false );
+
+         // the chain id is the hash of the genesis file
+         const std::string legacy_genesis = read_file( legacy_path );
+         const std::string streamed_genesis = read_file( output_path );
+         BOOST_CHECK_EQUAL( legacy_genesis.size(), streamed_genesis.size() );
+         BOOST_CHECK( legacy_genesis == streamed_genesis );
+         BOOST_CHECK_EQUAL( fc::sha256::hash( legacy_genesis ).str(), fc::sha256::hash( streamed_genesis ).str() );
+      }
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
@@ -25,7 +25,10 @@
 #include <graphene/chain/account_object.hpp>
 #include <graphene/utilities/tempdir.hpp>
 
+#include <playchain/chain/schema/player_object.hpp>
+
 #include <fc/crypto/digest.hpp>
+#include <fc/io/json.hpp>
 
 #include <boost/test/auto_unit_test.hpp>
 
@@ -127,3 +130,78 @@ BOOST_AUTO_TEST_CASE( genesis_and_persistence_bench )
       throw;
    }
 }
+
+BOOST_AUTO_TEST_CASE( bulk_genesis_load_bench )
+{
+   try {
+#ifdef NDEBUG
+      const uint32_t account_count = 2000000;
+#else
+      const uint32_t account_count = 30000;
+#endif
+      const auto init_key = fc::ecc::private_key::regenerate(fc::sha256::hash(string("null_key"))).get_public_key();
+
+      genesis_state_type genesis_state;
+      genesis_state.initial_timestamp = time_point_sec( fc::time_point::now().sec_since_epoch()
+                                                        / GRAPHENE_DEFAULT_BLOCK_INTERVAL * GRAPHENE_DEFAULT_BLOCK_INTERVAL );
+      for( uint64_t i = 0; i < genesis_state.initial_active_witnesses; ++i )
+      {
+         auto name = "init" + fc::to_string(i);
+         genesis_state.initial_accounts.emplace_back(name, init_key, init_key, true);
+         genesis_state.initial_committee_candidates.push_back({name});
+         genesis_state.initial_witness_candidates.push_back({name, init_key});
+      }
+      genesis_state.initial_parameters.get_mutable_fees().zero_all_fees();
+
+      // every lifetime member with a balance becomes a player
+      public_key_type key;
+      for( uint32_t i = 0; i < account_count; ++i )
+      {
+         key = fc::ecc::private_key::regenerate(fc::digest(i)).get_public_key();
+         genesis_state.initial_accounts.emplace_back("player" + fc::to_string(i), key, key, true);
+         genesis_state_type::initial_balance_type balance;
+         balance.owner = address(key);
+         balance.asset_symbol = GRAPHENE_SYMBOL;
+         balance.amount = 1000;
+         genesis_state.initial_balances.emplace_back(balance);
+      }
+
+      const std::string genesis_json = fc::json::to_string( genesis_state );
+      ilog("Genesis JSON with ${n} accounts takes ${s} MB", ("n", account_count)("s", genesis_json.size() / (1024 * 1024)));
+
+      fc::time_point start_time = fc::time_point::now();
+      genesis_state_type variant_genesis = fc::json::from_string( genesis_json ).as<genesis_state_type>( 20 );
+      ilog("Parsed genesis through variant in ${t} milliseconds.", ("t", (fc::time_point::now() - start_time).count() / 1000));
+
+      start_time = fc::time_point::now();
+      genesis_state_type parsed_genesis = parse_genesis_state( genesis_json, 20 );
+      ilog("Parsed genesis element by element in ${t} milliseconds.", ("t", (fc::time_point::now() - start_time).count() / 1000));
+
+      BOOST_CHECK( fc::json::to_string( parsed_genesis ) == fc::json::to_string( variant_genesis ) );
+
+      fc::temp_directory data_dir( graphene::utilities::temp_directory_path() );
+
+      database db;
+      start_time = fc::time_point::now();
+      db.open(data_dir.path(), [&]{return parsed_genesis;}, "test");
+      ilog("Initialized genesis with ${n} accounts in ${t} milliseconds.",
+           ("n", account_count)("t", (fc::time_point::now() - start_time).count() / 1000));
+
+      const auto& accounts_by_name = db.get_index_type<account_index>().indices().get<by_name>();
+      BOOST_CHECK( accounts_by_name.find( "player" + fc::to_string(account_count - 1) ) != accounts_by_name.end() );
+      // plus PLAYCHAIN_NULL_PLAYER
+      BOOST_CHECK_EQUAL( db.get_index_type<playchain::chain::player_index>().indices().size(), account_count + 1 );
+
+      const auto& members = dynamic_cast<const base_primary_index&>( db.get_index_type<account_index>() )
+                                                                   .get_secondary_index<account_member_index>();
+      // the keys of the accounts are indexed after the bulk insertion
+      auto key_itr = members.account_to_key_memberships.find( key );
+      BOOST_REQUIRE( key_itr != members.account_to_key_memberships.end() );
+      BOOST_CHECK_EQUAL( key_itr->second.size(), 1u );
+
+      db.close();
+   } catch(fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
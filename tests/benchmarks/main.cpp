@@ -21,5 +21,28 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#define BOOST_TEST_MODULE "C++ Benchmarks for Graphene Blockchain Database"
+#include <cstdlib>
+#include <iostream>
 #include <boost/test/included/unit_test.hpp>
+#include <boost/make_unique.hpp>
+
+#include <playchain/chain/playchain_config.hpp>
+
+extern uint32_t GRAPHENE_TESTING_GENESIS_TIMESTAMP;
+
+boost::unit_test::test_suite* init_unit_test_suite(int argc, char* argv[]) {
+
+    using namespace playchain::protocol;
+    // the playchain benchmarks run with the configuration of the playchain tests
+    detail::override_config(boost::make_unique<detail::config>(detail::config::test));
+
+    boost::unit_test::framework::master_test_suite().p_name.value = "C++ Benchmarks for Graphene Blockchain Database";
+
+    const char* genesis_timestamp_str = getenv("GRAPHENE_TESTING_GENESIS_TIMESTAMP");
+    if( genesis_timestamp_str != nullptr )
+    {
+        GRAPHENE_TESTING_GENESIS_TIMESTAMP = std::stoul( genesis_timestamp_str );
+    }
+    std::cout << "GRAPHENE_TESTING_GENESIS_TIMESTAMP is " << GRAPHENE_TESTING_GENESIS_TIMESTAMP << std::endl;
+    return nullptr;
+}
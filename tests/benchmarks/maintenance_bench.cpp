@@ -0,0 +1,170 @@
+#include "../playchain/playchain_common.hpp"
+
+#include <playchain/chain/schema/room_object.hpp>
+#include <playchain/chain/schema/player_object.hpp>
+#include <playchain/chain/schema/game_witness_object.hpp>
+#include <playchain/chain/evaluators/db_helpers.hpp>
+#include <playchain/chain/evaluators/player_evaluators.hpp>
+#include <playchain/chain/playchain_config.hpp>
+#include <graphene/chain/hardfork.hpp>
+
+namespace maintenance_bench
+{
+struct maintenance_fixture: public playchain_common::playchain_fixture
+{
+    const int64_t registrator_init_balance = 3000*GRAPHENE_BLOCKCHAIN_PRECISION;
+#ifdef NDEBUG
+    const uint32_t players_count = 100000;
+#else
+    const uint32_t players_count = 10000;
+#endif
+    const share_type player_fee = 100;
+
+    DECLARE_ACTOR(richregistrator1)
+    DECLARE_ACTOR(richregistrator2)
+    DECLARE_ACTOR(alice)
+
+    std::vector<player_id_type> players;
+
+    maintenance_fixture()
+    {
+        actor(richregistrator1).supply(asset(registrator_init_balance));
+        actor(richregistrator2).supply(asset(registrator_init_balance));
+    }
+
+    //the players are registered accounts invited by Alice
+    void create_players()
+    {
+        const player_id_type inviter = get_player(alice);
+        const uint32_t accounts_per_transaction = 1000;
+
+        for (uint32_t ci = 0; ci < players_count; ci += accounts_per_transaction)
+        {
+            signed_transaction trx;
+            for (uint32_t pi = ci; pi < std::min(ci + accounts_per_transaction, players_count); ++pi)
+            {
+                trx.operations.emplace_back(make_account("player" + fc::to_string(pi)));
+            }
+            set_expiration(db, trx);
+            processed_transaction ptx = PUSH_TX(db, trx, ~0);
+
+            for (const auto &result: ptx.operation_results)
+            {
+                players.emplace_back(create_player(db, result.get<object_id_type>(), inviter));
+            }
+
+            generate_block();
+        }
+    }
+
+    void fill_pending_fees(const room_id_type &room, const game_witness_id_type &witness)
+    {
+        const account_id_type getter = actor(alice);
+
+        const player_pending_fee_data fee{getter, "table", asset(player_fee), room, game_witnesses_type{witness}};
+
+        for (const auto &player: players)
+        {
+            db.modify(player(db), [&](player_object &obj)
+            {
+                obj.pending_fees.emplace_back(fee);
+            });
+        }
+
+        //the rake is taken from the room owner to keep the supply
+        const asset total(player_fee.value * players_count);
+        db.adjust_balance(actor(richregistrator1), -total);
+        db.modify(room(db), [&](room_object &obj)
+        {
+            obj.pending_rake += total;
+        });
+    }
+
+    fc::microseconds measure_maintenance()
+    {
+        const auto maintenance_time = db.get_dynamic_global_properties().next_maintenance_time;
+
+        fc::time_point start = fc::time_point::now();
+        generate_blocks(maintenance_time);
+        return fc::time_point::now() - start;
+    }
+
+    std::map<account_id_type, share_type> get_vesting_balances()
+    {
+        std::map<account_id_type, share_type> result;
+        for (const vesting_balance_object &vb: db.get_index_type<vesting_balance_index>().indices())
+        {
+            result[vb.owner] += vb.balance.amount;
+        }
+        return result;
+    }
+
+    std::map<account_id_type, share_type> get_rewards(const std::map<account_id_type, share_type> &before)
+    {
+        auto result = get_vesting_balances();
+        for (const auto &balance: before)
+        {
+            result[balance.first] -= balance.second;
+        }
+        return result;
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE( maintenance_bench, maintenance_fixture)
+
+PLAYCHAIN_TEST_CASE(deposit_pending_fees_bench)
+{
+    generate_blocks(HARDFORK_PLAYCHAIN_15_TIME);
+
+    CREATE_PLAYER(richregistrator1, alice);
+
+    room_id_type room = create_new_room(richregistrator1);
+    create_new_room(richregistrator2);
+
+    const auto& params = get_playchain_parameters(db);
+
+    //inviter cuts do not depend on the growing balance of Alice
+    actor(alice).supply(asset(params.player_referrer_balance_max_threshold));
+
+    game_witness_id_type witness = get_witness(richregistrator2);
+
+    create_players();
+
+    //the same fees deposited cut by cut and once per recipient
+    auto balances = get_vesting_balances();
+    test::pending_fees_hooks::enable_accumulation(db, false);
+    fill_pending_fees(room, witness);
+    auto per_fee_time = measure_maintenance();
+    auto per_fee_rewards = get_rewards(balances);
+
+    balances = get_vesting_balances();
+    test::pending_fees_hooks::enable_accumulation(db, true);
+    fill_pending_fees(room, witness);
+    auto per_recipient_time = measure_maintenance();
+    auto per_recipient_rewards = get_rewards(balances);
+
+    const auto &players_by_pending_fees = db.get_index_type<player_index>().indices().get<by_pending_fees>();
+    BOOST_CHECK(players_by_pending_fees.begin()->is_not_pending());
+
+    share_type total_rewards;
+    for (const auto &reward: per_fee_rewards)
+    {
+        total_rewards += reward.second;
+    }
+    BOOST_CHECK_EQUAL(total_rewards.value, player_fee.value * players_count);
+
+    BOOST_REQUIRE_EQUAL(per_recipient_rewards.size(), per_fee_rewards.size());
+    for (const auto &reward: per_fee_rewards)
+    {
+        BOOST_CHECK_EQUAL(per_recipient_rewards[reward.first].value, reward.second.value);
+    }
+    BOOST_CHECK_EQUAL(room(db).pending_rake.amount.value, 0);
+
+    ilog("Maintenance with pending fees of ${n} players: deposit per fee ${f} ms, deposit per recipient ${r} ms",
+         ("n", players_count)
+         ("f", per_fee_time.count() / 1000)
+         ("r", per_recipient_time.count() / 1000));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/market_history/market_history_plugin.hpp>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "../common/database_fixture.hpp"
+
+using namespace graphene::chain;
+using namespace graphene::chain::test;
+using namespace graphene::market_history;
+
+BOOST_FIXTURE_TEST_SUITE( market_history_bench, database_fixture )
+
+BOOST_AUTO_TEST_CASE( high_fill_block_bench )
+{
+   try {
+      const uint32_t orders_count = 2000;
+
+      ACTORS( (maker)(taker) );
+
+      const auto& usd  = create_user_issued_asset( "USDUIA" );
+      const auto& core = asset_id_type()(db);
+
+      transfer( committee_account, maker_id, asset( 100 * orders_count * 100 ) );
+      issue_uia( taker, usd.amount( 10 * orders_count * 100 ) );
+      generate_block();
+
+      for( uint32_t i = 0; i < orders_count; ++i )
+         create_sell_order( maker, core.amount( 100 ), usd.amount( 10 + i % 100 ) );
+      generate_block();
+
+      // one taker order fills every maker order, the block holds 2 fill operations per maker order
+      create_sell_order( taker, usd.amount( 10 * orders_count * 100 ), core.amount( 100 * orders_count ) );
+
+      fc::time_point start = fc::time_point::now();
+      generate_block();
+      const fc::microseconds block_time = fc::time_point::now() - start;
+
+      const auto& buckets = db.get_index_type<bucket_index>().indices().get<by_key>();
+      share_type bucket_volume;
+      for( const auto& bucket : buckets )
+         if( bucket.key.seconds == 15 )
+            bucket_volume += bucket.base_volume;
+      BOOST_CHECK_EQUAL( bucket_volume.value, 100 * orders_count );
+
+      const auto& tickers = db.get_index_type<market_ticker_index>().indices();
+      BOOST_REQUIRE_EQUAL( tickers.size(), 1u );
+
+      ilog( "Block with ${n} maker fills applied with the market history in ${t} ms",
+            ("n", orders_count)("t", block_time.count() / 1000) );
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/net/message_oriented_connection.hpp>
+#include <graphene/net/core_messages.hpp>
+
+#include <fc/network/tcp_socket.hpp>
+#include <fc/thread/thread.hpp>
+#include <fc/thread/future.hpp>
+
+#include <boost/test/auto_unit_test.hpp>
+
+using namespace graphene::net;
+
+namespace
+{
+   class counting_delegate : public message_oriented_connection_delegate
+   {
+   public:
+      counting_delegate( uint32_t expected_messages ):
+         _expected_messages( expected_messages ),
+         _done( new fc::promise<void>( "counting_delegate::done" ) )
+      {}
+
+      void on_message( message_oriented_connection*, const message& received_message ) override
+      {
+         _bytes += received_message.size;
+         if( ++_messages == _expected_messages )
+            _done->set_value();
+      }
+
+      void on_connection_closed( message_oriented_connection* ) override {}
+
+      void wait() { fc::future<void>( _done ).wait(); }
+
+      uint64_t bytes() const { return _bytes; }
+
+   private:
+      uint32_t _expected_messages;
+      uint32_t _messages = 0;
+      uint64_t _bytes = 0;
+      fc::promise<void>::ptr _done;
+   };
+
+   void run_loopback( const uint32_t message_count, const size_t payload_size )
+   {
+      counting_delegate receiver_delegate( message_count );
+      counting_delegate sender_delegate( 0 );
+      message_oriented_connection receiver( &receiver_delegate );
+      message_oriented_connection sender( &sender_delegate );
+
+      fc::tcp_server server;
+      server.listen( fc::ip::endpoint( fc::ip::address( "127.0.0.1" ), 0 ) );
+      fc::ip::endpoint server_endpoint( fc::ip::address( "127.0.0.1" ), server.get_port() );
+
+      fc::future<void> accepted = fc::async( [&](){
+         server.accept( receiver.get_socket() );
+         receiver.accept();
+      }, "loopback accept" );
+      sender.connect_to( server_endpoint );
+      accepted.wait();
+
+      message msg;
+      msg.msg_type = block_message_type;
+      msg.data.resize( payload_size );
+      msg.size = (uint32_t)payload_size;
+
+      // the connections run on this thread, so their receive buffers are counted here
+      const uint64_t acquired_before = message_oriented_connection::get_receive_buffers_acquired();
+      const uint64_t allocations_before = message_oriented_connection::get_receive_buffers_allocated();
+      fc::time_point start = fc::time_point::now();
+
+      fc::future<void> sent = fc::async( [&](){
+         for( uint32_t i = 0; i < message_count; ++i )
+            sender.send_message( msg );
+      }, "loopback send" );
+      receiver_delegate.wait();
+      sent.wait();
+
+      const fc::microseconds elapsed = fc::time_point::now() - start;
+      const uint64_t acquired = message_oriented_connection::get_receive_buffers_acquired() - acquired_before;
+      const uint64_t allocations = message_oriented_connection::get_receive_buffers_allocated() - allocations_before;
+      const double seconds = std::max<double>( elapsed.count(), 1 ) / 1000000.;
+
+      BOOST_CHECK_EQUAL( receiver_delegate.bytes(), uint64_t( message_count ) * payload_size );
+      BOOST_CHECK_EQUAL( acquired, message_count );
+
+      ilog( "Loopback ${n} x ${s} bytes: ${mbs} MB/s, ${a} receive buffer allocations per message",
+            ("n", message_count)("s", payload_size)
+            ("mbs", double( receiver_delegate.bytes() ) / seconds / ( 1024 * 1024 ))
+            ("a", double( allocations ) / message_count) );
+
+      sender.close_connection();
+      receiver.close_connection();
+      sender.destroy_connection();
+      receiver.destroy_connection();
+      server.close();
+   }
+}
+
+BOOST_AUTO_TEST_CASE( message_oriented_connection_loopback_bench )
+{
+   try {
+#ifdef NDEBUG
+      const uint32_t message_count = 100000;
+#else
+      const uint32_t message_count = 10000;
+#endif
+      run_loopback( message_count, 256 );
+      run_loopback( message_count / 10, 64 * 1024 );
+      run_loopback( message_count / 100, 1024 * 1024 );
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
@@ -0,0 +1,156 @@
+#include "../playchain/playchain_common.hpp"
+
+#include <playchain/chain/schema/table_object.hpp>
+#include <playchain/chain/schema/pending_buy_in_object.hpp>
+#include <playchain/chain/playchain_config.hpp>
+
+namespace metadata_interning_bench
+{
+struct metadata_interning_bench_fixture: public playchain_common::playchain_fixture
+{
+    const int64_t registrator_init_balance = 3000*GRAPHENE_BLOCKCHAIN_PRECISION;
+    const uint32_t metadata_count = 20;
+
+    DECLARE_ACTOR(richregistrator)
+
+    metadata_interning_bench_fixture()
+    {
+        actor(richregistrator).supply(asset(registrator_init_balance));
+    }
+
+    std::string metadata_for(const uint32_t ci) const
+    {
+        //the same long prefix makes the string comparisons as expensive as for the real JSON metadata
+        return "{\"game\":\"holdem\",\"limit\":\"no limit\",\"blinds\":" + fc::to_string(ci % metadata_count) + "}";
+    }
+
+    void push_tables(const room_id_type &room, const uint32_t tables_count)
+    {
+        for (uint32_t ci = 0; ci < tables_count; ++ci)
+        {
+            signed_transaction tx;
+            tx.operations.push_back(create_table_op(richregistrator, room, 0u, metadata_for(ci)));
+            test::set_expiration(db, tx);
+            sign(tx, richregistrator.private_key);
+            db.push_transaction(tx, ~0);
+        }
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE( metadata_interning_bench, metadata_interning_bench_fixture)
+
+PLAYCHAIN_TEST_CASE(buy_in_allocation_by_metadata_bench)
+{
+    const uint32_t players_count = PLAYCHAIN_DEFAULT_PENDING_BUY_IN_ALLOCATE_PER_BLOCK;
+    const uint32_t tables_count = 2000;
+
+    room_id_type room = create_new_room(richregistrator);
+
+    generate_block();
+
+    push_tables(room, tables_count);
+
+    auto stake = asset(player_init_balance/2);
+
+    std::vector<Actor> players;
+    for (uint32_t ci = 0; ci < players_count; ++ci)
+    {
+        players.emplace_back(create_new_player(richregistrator, "metaplayer" + fc::to_string(ci), asset(player_init_balance)));
+    }
+
+    next_maintenance();
+
+    //every player asks for the metadata of the tables, one of them asks for the metadata that no table has
+    for (uint32_t ci = 0; ci < players_count; ++ci)
+    {
+        const auto &player = players[ci];
+        buy_in_reserve(player, get_next_uid(actor(player)), stake, (ci > 0) ? metadata_for(ci) : std::string{"no such tables"});
+    }
+
+    fc::time_point start = fc::time_point::now();
+    generate_block();
+    fc::microseconds allocation_time = fc::time_point::now() - start;
+
+    //the allocated tables are checked by the string comparison
+    uint32_t allocated = 0;
+    const auto &pending_buy_ins = db.get_index_type<pending_buy_in_index>().indices();
+    for (const auto &buy_in: pending_buy_ins)
+    {
+        if (buy_in.id == PLAYCHAIN_NULL_PENDING_BUYIN || !buy_in.is_allocated())
+            continue;
+
+        BOOST_CHECK_EQUAL(buy_in.table(db).metadata.str(), buy_in.metadata);
+        ++allocated;
+    }
+    BOOST_CHECK_EQUAL(allocated, players_count - 1);
+
+    ilog("Buy-in allocation for ${n} players among ${t} tables with ${m} metadata: ${a} us (${p} us per buy-in)",
+         ("n", players_count)
+         ("t", tables_count)
+         ("m", metadata_count)
+         ("a", allocation_time.count())
+         ("p", allocation_time.count() / players_count));
+}
+
+PLAYCHAIN_TEST_CASE(tables_info_by_metadata_bench)
+{
+    const uint32_t tables_count = 20000;
+    const uint32_t calls = 1000;
+
+    room_id_type room = create_new_room(richregistrator);
+
+    generate_block();
+
+    push_tables(room, tables_count);
+
+    generate_block();
+
+    //the expected results are collected by the string comparison
+    std::map<std::string, std::set<table_id_type>> expected;
+    for (const auto &table: db.get_index_type<table_index>().indices())
+    {
+        if (table.room == room)
+            expected[table.metadata.str()].insert(table.id);
+    }
+    BOOST_REQUIRE_EQUAL(expected.size(), metadata_count);
+
+    const std::string room_id = id_to_string(room);
+    for (const auto &item: expected)
+    {
+        auto tables = pplaychain_api->get_tables_info_by_metadata(room_id, item.first, PLAYCHAIN_MAX_SIZE_FOR_RESULT_API_LIST);
+        std::set<table_id_type> found;
+        for (const auto &info: tables)
+        {
+            found.insert(info.id);
+        }
+        BOOST_CHECK(found == item.second || tables.size() == PLAYCHAIN_MAX_SIZE_FOR_RESULT_API_LIST);
+        BOOST_CHECK(std::includes(item.second.begin(), item.second.end(), found.begin(), found.end()));
+    }
+
+    uint64_t listed = 0;
+    fc::time_point start = fc::time_point::now();
+    for (uint32_t ci = 0; ci < calls; ++ci)
+    {
+        listed += pplaychain_api->get_tables_info_by_metadata(room_id, metadata_for(ci), 1).size();
+    }
+    fc::microseconds lookup_time = fc::time_point::now() - start;
+
+    start = fc::time_point::now();
+    for (uint32_t ci = 0; ci < calls; ++ci)
+    {
+        listed += pplaychain_api->get_tables_info_by_metadata(room_id, "no such tables #" + fc::to_string(ci), 1).size();
+    }
+    fc::microseconds miss_time = fc::time_point::now() - start;
+
+    BOOST_CHECK_EQUAL(listed, calls);
+
+    ilog("${c} get_tables_info_by_metadata calls among ${t} tables with ${m} metadata: found ${l} us, not found ${nf} us",
+         ("c", calls)
+         ("t", tables_count)
+         ("m", metadata_count)
+         ("l", lookup_time.count())
+         ("nf", miss_time.count()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/app/database_api.hpp>
+
+#include <fc/thread/thread.hpp>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "../common/database_fixture.hpp"
+
+#include <atomic>
+
+using namespace graphene::chain;
+using namespace graphene::chain::test;
+
+BOOST_FIXTURE_TEST_SUITE( notification_bus_bench, database_fixture )
+
+BOOST_AUTO_TEST_CASE( database_api_subscribers_bench )
+{
+   try {
+      const uint32_t subscribers_count = 1000;
+      const uint32_t accounts_count = 100;
+      const uint32_t blocks_count = 20;
+
+      vector<account_id_type> accounts;
+      for( uint32_t i = 0; i < accounts_count; ++i )
+      {
+         const account_object& account = create_account( "subscribed" + fc::to_string(i) );
+         accounts.push_back( account.id );
+      }
+      generate_block();
+
+      std::atomic<uint64_t> notifications( 0 );
+      auto callback = [&notifications]( const variant& ) { ++notifications; };
+
+      // every API instance follows a few accounts as a wallet does
+      vector<std::unique_ptr<graphene::app::database_api>> apis;
+      for( uint32_t i = 0; i < subscribers_count; ++i )
+      {
+         apis.emplace_back( new graphene::app::database_api( db ) );
+         apis.back()->set_subscribe_callback( callback, false );
+
+         vector<object_id_type> ids;
+         for( uint32_t j = 0; j < 5; ++j )
+            ids.push_back( accounts[(i + j) % accounts_count] );
+         apis.back()->get_objects( ids );
+      }
+
+      fc::microseconds chain_time;
+      for( uint32_t b = 0; b < blocks_count; ++b )
+      {
+         for( const auto& account : accounts )
+            transfer( account_id_type(), account, asset(1) );
+
+         fc::time_point start = fc::time_point::now();
+         generate_block();
+         chain_time += fc::time_point::now() - start;
+      }
+
+      // the callbacks are delivered asynchronously
+      fc::usleep( fc::seconds(1) );
+      uint64_t delivered = notifications;
+
+      BOOST_CHECK( delivered > 0 );
+
+      ilog( "${s} subscribed database APIs, ${b} blocks with ${t} transfers: ${c} us per block on the chain thread, ${n} notifications delivered",
+            ("s", subscribers_count)("b", blocks_count)("t", accounts_count)
+            ("c", chain_time.count() / blocks_count)("n", delivered) );
+
+      apis.clear();
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+#include "../playchain/playchain_common.hpp"
+
+#include <playchain/chain/schema/table_object.hpp>
+#include <playchain/chain/playchain_config.hpp>
+
+namespace playchain_api_bench
+{
+struct playchain_api_bench_fixture: public playchain_common::playchain_fixture
+{
+    const int64_t registrator_init_balance = 3000*GRAPHENE_BLOCKCHAIN_PRECISION;
+
+    DECLARE_ACTOR(richregistrator)
+
+    playchain_api_bench_fixture()
+    {
+        actor(richregistrator).supply(asset(registrator_init_balance));
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE( playchain_api_bench, playchain_api_bench_fixture)
+
+PLAYCHAIN_TEST_CASE(tables_crawl_bench)
+{
+    const uint32_t tables_count = 100000;
+
+    room_id_type room = create_new_room(richregistrator);
+
+    generate_block();
+
+    //objects are created directly, only the reading is measured
+    for (uint32_t ci = 0; ci < tables_count; ++ci)
+    {
+        db.create<table_object>([&](table_object &table) {
+            table.room = room;
+            table.metadata = db.interned_strings().intern("table #" + fc::to_string(ci));
+        });
+    }
+
+    uint32_t listed = 0;
+    uint32_t calls = 0;
+    fc::time_point start = fc::time_point::now();
+    {
+        string last_page_id;
+        while (true)
+        {
+            auto tables = pplaychain_api->list_all_tables(last_page_id, PLAYCHAIN_MAX_SIZE_FOR_RESULT_API_LIST);
+            ++calls;
+            if (tables.empty())
+                break;
+            listed += tables.size();
+            last_page_id = id_to_string(tables.back().id);
+        }
+    }
+    fc::microseconds list_all_time = fc::time_point::now() - start;
+    uint32_t list_all_calls = calls;
+
+    BOOST_CHECK_EQUAL(listed, tables_count);
+
+    listed = 0;
+    calls = 0;
+    start = fc::time_point::now();
+    {
+        optional<table_id_type> last_page_id;
+        do
+        {
+            auto page = pplaychain_api->list_tables_page(last_page_id, PLAYCHAIN_MAX_SIZE_FOR_RESULT_API_PAGE);
+            ++calls;
+            listed += page.items.size();
+            last_page_id = page.next_page_id;
+        } while (last_page_id.valid());
+    }
+    fc::microseconds page_time = fc::time_point::now() - start;
+
+    BOOST_CHECK_EQUAL(listed, tables_count);
+
+    auto per_second = [](uint32_t n, const fc::microseconds &t) {
+        return (uint64_t)n * 1000000 / std::max<int64_t>(t.count(), 1);
+    };
+
+    ilog("Crawl of ${n} tables: list_all_tables ${lc} calls ${lt} ms (${ls} tables/s), list_tables_page ${pc} calls ${pt} ms (${ps} tables/s)",
+         ("n", tables_count)
+         ("lc", list_all_calls)
+         ("lt", list_all_time.count() / 1000)
+         ("ls", per_second(tables_count, list_all_time))
+         ("pc", calls)
+         ("pt", page_time.count() / 1000)
+         ("ps", per_second(tables_count, page_time)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/chain/proposal_object.hpp>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "../common/database_fixture.hpp"
+
+using namespace graphene::chain;
+using namespace graphene::chain::test;
+
+BOOST_FIXTURE_TEST_SUITE( proposal_expiration_bench, database_fixture )
+
+BOOST_AUTO_TEST_CASE( pending_multi_level_proposals_bench )
+{
+   try {
+      const uint32_t proposals_count = 2000;
+      const uint32_t members_count = 5;
+
+      ACTORS( (treasury)(receiver) );
+      fund( treasury, asset( 10 * proposals_count ) );
+
+      // the treasury is controlled by the members, every member is controlled by its own signers
+      authority treasury_authority;
+      treasury_authority.weight_threshold = members_count / 2 + 1;
+      vector<account_id_type> members;
+      for( uint32_t i = 0; i < members_count; ++i )
+      {
+         const account_object& signer = create_account( "signer" + fc::to_string(i) );
+         const account_object& member = create_account( "member" + fc::to_string(i) );
+
+         account_update_operation op;
+         op.account = member.id;
+         op.active = authority( 1, signer.id, 1 );
+         trx.operations.push_back( op );
+
+         treasury_authority.account_auths[member.id] = 1;
+         members.push_back( member.id );
+      }
+      account_update_operation op;
+      op.account = treasury_id;
+      op.active = treasury_authority;
+      trx.operations.push_back( op );
+      PUSH_TX( db, trx, ~0 );
+      trx.clear();
+      generate_block();
+
+      // every proposal is approved by a single member, so none of them can be executed before the expiration
+      const time_point_sec expiration = db.head_block_time() + fc::minutes(10);
+      vector<proposal_id_type> proposals;
+      for( uint32_t i = 0; i < proposals_count; ++i )
+      {
+         transfer_operation top;
+         top.from = treasury_id;
+         top.to = receiver_id;
+         top.amount = asset( 1 + i % 10 );
+
+         proposal_create_operation pop;
+         pop.proposed_ops.emplace_back( top );
+         pop.fee_paying_account = receiver_id;
+         pop.expiration_time = expiration;
+         trx.operations.push_back( pop );
+         proposals.push_back( PUSH_TX( db, trx, ~0 ).operation_results[0].get<object_id_type>() );
+         trx.clear();
+
+         proposal_update_operation pup;
+         pup.fee_paying_account = receiver_id;
+         pup.proposal = proposals.back();
+         pup.active_approvals_to_add.insert( members[i % members_count] );
+         trx.operations.push_back( pup );
+         PUSH_TX( db, trx, ~0 );
+         trx.clear();
+      }
+      generate_block();
+
+      // a change of any account authority drops the cached checks
+      account_update_operation touch;
+      touch.account = receiver_id;
+      touch.active = authority( 1, public_key_type( generate_private_key( "receiver2" ).get_public_key() ), 1 );
+      trx.operations.push_back( touch );
+      PUSH_TX( db, trx, ~0 );
+      trx.clear();
+
+      fc::time_point start = fc::time_point::now();
+      for( const auto& id : proposals )
+         BOOST_CHECK( !id(db).is_authorized_to_execute(db) );
+      const fc::microseconds full_check_time = fc::time_point::now() - start;
+
+      start = fc::time_point::now();
+      for( const auto& id : proposals )
+         BOOST_CHECK( !id(db).is_authorized_to_execute(db) );
+      const fc::microseconds cached_check_time = fc::time_point::now() - start;
+
+      generate_blocks( expiration - db.get_global_properties().parameters.block_interval );
+      start = fc::time_point::now();
+      generate_block();
+      const fc::microseconds expiration_time = fc::time_point::now() - start;
+
+      BOOST_CHECK( db.get_index_type<proposal_index>().indices().empty() );
+
+      ilog( "${n} pending proposals of ${m} members: full checks ${f} us, cached checks ${c} us, expiration block ${e} us",
+            ("n", proposals_count)("m", members_count)
+            ("f", full_check_time.count())("c", cached_check_time.count())("e", expiration_time.count()) );
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
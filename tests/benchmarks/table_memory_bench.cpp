@@ -0,0 +1,163 @@
+#include "../playchain/playchain_common.hpp"
+
+#include <playchain/chain/schema/table_object.hpp>
+
+#include <graphene/db/memory_usage.hpp>
+
+namespace table_memory_bench
+{
+///the members of table_object changed by the metadata interning and the inline seats as they were before
+struct legacy_table_layout
+{
+    room_id_type room;
+    std::string metadata;
+    flat_map<player_id_type, pending_buy_in_id_type> pending_proposals;
+    flat_map<player_id_type, asset> cash;
+    flat_map<player_id_type, asset> playing_cash;
+};
+
+template<typename Member>
+uint64_t member_memory_usage(const Member &member)
+{
+    return sizeof(member) + graphene::db::estimate_dynamic_memory_usage(member);
+}
+
+uint64_t changed_members_memory_usage(const legacy_table_layout &table)
+{
+    return member_memory_usage(table.metadata) + member_memory_usage(table.pending_proposals)
+            + member_memory_usage(table.cash) + member_memory_usage(table.playing_cash);
+}
+
+uint64_t changed_members_memory_usage(const table_object &table)
+{
+    return member_memory_usage(table.metadata) + member_memory_usage(table.pending_proposals)
+            + member_memory_usage(table.cash) + member_memory_usage(table.playing_cash);
+}
+
+struct by_legacy_room_and_metadata;
+typedef multi_index_container<
+   legacy_table_layout,
+   indexed_by<
+      ordered_non_unique< tag<by_legacy_room_and_metadata>,
+         composite_key<legacy_table_layout,
+            member<legacy_table_layout, room_id_type, &legacy_table_layout::room>,
+            member<legacy_table_layout, std::string, &legacy_table_layout::metadata>>>
+   >
+> legacy_table_multi_index_type;
+
+struct table_memory_bench_fixture: public playchain_common::playchain_fixture
+{
+    const int64_t registrator_init_balance = 3000*GRAPHENE_BLOCKCHAIN_PRECISION;
+    const uint32_t tables_count = 100000;
+    const uint32_t metadata_count = 10;
+    const uint32_t players_per_table = 4;
+
+    DECLARE_ACTOR(richregistrator)
+
+    table_memory_bench_fixture()
+    {
+        actor(richregistrator).supply(asset(registrator_init_balance));
+    }
+
+    std::string metadata_for(const uint32_t ci) const
+    {
+        //the length is out of the short string optimization as the JSON metadata of the real tables
+        return "{\"game\":\"holdem\",\"limit\":\"no limit\",\"blinds\":" + fc::to_string(ci % metadata_count) + "}";
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE( table_memory_bench, table_memory_bench_fixture)
+
+PLAYCHAIN_TEST_CASE(table_layout_memory_bench)
+{
+    room_id_type room = create_new_room(richregistrator);
+
+    generate_block();
+
+    legacy_table_multi_index_type legacy_tables;
+    uint64_t legacy_bytes = 0;
+
+    //objects are created directly, only the layout is measured
+    for (uint32_t ci = 0; ci < tables_count; ++ci)
+    {
+        legacy_table_layout legacy;
+        legacy.room = room;
+        legacy.metadata = metadata_for(ci);
+
+        const auto &table = db.create<table_object>([&](table_object &obj) {
+            obj.room = room;
+            obj.metadata = db.interned_strings().intern(legacy.metadata);
+            for (uint32_t pi = 0; pi < players_per_table; ++pi)
+            {
+                obj.adjust_cash(player_id_type(pi), asset(pi + 1));
+                legacy.cash[player_id_type(pi)] = asset(pi + 1);
+                obj.adjust_playing_cash(player_id_type(pi), asset(pi + 1));
+                legacy.playing_cash[player_id_type(pi)] = asset(pi + 1);
+            }
+        });
+
+        BOOST_REQUIRE(fc::raw::pack(table.cash) == fc::raw::pack(legacy.cash));
+
+        legacy_bytes += changed_members_memory_usage(legacy);
+        legacy_tables.insert(std::move(legacy));
+    }
+
+    uint64_t compact_bytes = 0;
+    const auto &tables = db.get_index_type<table_index>().indices().get<by_room_and_metadata>();
+    for (const auto &table: tables)
+    {
+        compact_bytes += changed_members_memory_usage(table);
+    }
+    //the interned strings are shared by all tables
+    for (uint32_t ci = 0; ci < metadata_count; ++ci)
+    {
+        compact_bytes += graphene::db::estimate_dynamic_memory_usage(metadata_for(ci));
+    }
+
+    const uint32_t lookups = 100000;
+    std::vector<std::string> requests;
+    for (uint32_t ci = 0; ci < lookups; ++ci)
+    {
+        requests.emplace_back(metadata_for(ci));
+    }
+
+    uint64_t legacy_found = 0;
+    const auto &legacy_index = legacy_tables.get<by_legacy_room_and_metadata>();
+    fc::time_point start = fc::time_point::now();
+    for (const auto &metadata: requests)
+    {
+        auto range = legacy_index.equal_range(std::make_tuple(room, metadata));
+        legacy_found += (range.first != range.second);
+    }
+    fc::microseconds legacy_time = fc::time_point::now() - start;
+
+    //the request string is mapped to the handle once per lookup as get_tables_info_by_metadata does
+    uint64_t compact_found = 0;
+    start = fc::time_point::now();
+    for (const auto &metadata: requests)
+    {
+        auto interned_metadata = db.interned_strings().find(metadata);
+        if (!interned_metadata.valid())
+            continue;
+        auto range = tables.equal_range(std::make_tuple(room, *interned_metadata));
+        compact_found += (range.first != range.second);
+    }
+    fc::microseconds compact_time = fc::time_point::now() - start;
+
+    BOOST_CHECK_EQUAL(legacy_found, lookups);
+    BOOST_CHECK_EQUAL(compact_found, lookups);
+    BOOST_CHECK_LT(compact_bytes, legacy_bytes);
+
+    ilog("${n} tables with ${m} metadata and ${p} players: memory ${lb} -> ${cb} bytes, ${l} metadata lookups ${lt} -> ${ct} us",
+         ("n", tables_count)
+         ("m", metadata_count)
+         ("p", players_per_table)
+         ("lb", legacy_bytes)
+         ("cb", compact_bytes)
+         ("l", lookups)
+         ("lt", legacy_time.count())
+         ("ct", compact_time.count()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
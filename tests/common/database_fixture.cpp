@@ -245,6 +245,11 @@ database_fixture::database_fixture(const fc::time_point_sec &initial_timestamp)
       esobjects_plugin->plugin_startup();
    }
 
+   if( current_test_name == "market_history_multi_fill_block" )
+   {
+      options.insert(std::make_pair("max-order-his-records-per-market", boost::program_options::variable_value((uint32_t)5, false)));
+      options.insert(std::make_pair("max-order-his-seconds-per-market", boost::program_options::variable_value((uint32_t)0, false)));
+   }
    options.insert(std::make_pair("bucket-size", boost::program_options::variable_value(string("[15]"),false)));
    mhplugin->plugin_set_app(&app);
    mhplugin->plugin_initialize(options);
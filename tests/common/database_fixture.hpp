@@ -373,6 +373,13 @@ void set_expiration( const database& db, transaction& tx );
 
 bool _push_block( database& db, const signed_block& b, uint32_t skip_flags = 0 );
 processed_transaction _push_transaction( database& db, const signed_transaction& tx, uint32_t skip_flags = 0 );
+
+/// switches the database to the per-fee paths of the pending fees to compare the payouts with them
+struct pending_fees_hooks {
+   /// set it before the database is opened
+   static void enable_aggregation( database& db, bool enable ) { db._aggregate_pending_fees = enable; }
+   static void enable_accumulation( database& db, bool enable ) { db._accumulate_pending_fees = enable; }
+};
 }
 
 } }
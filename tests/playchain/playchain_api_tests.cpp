@@ -1,5 +1,6 @@
 #include "playchain_common.hpp"
 
+#include <fc/io/json.hpp>
 #include <fc/variant.hpp>
 #include <vector>
 
@@ -665,6 +666,52 @@ PLAYCHAIN_TEST_CASE(check_list_all_tables) {
   BOOST_CHECK_EQUAL(tables[0].room(db).owner(db).name, alice.name);
 }
 
+PLAYCHAIN_TEST_CASE(check_list_tables_page) {
+  using namespace playchain::app;
+
+  BOOST_CHECK_THROW(pplaychain_api->list_tables_page(
+                        {}, PLAYCHAIN_MAX_SIZE_FOR_RESULT_API_PAGE + 1),
+                    fc::exception);
+  BOOST_CHECK_THROW(pplaychain_api->list_tables_page({}, 0), fc::exception);
+
+  BOOST_CHECK(pplaychain_api->list_tables_page({}, 10).items.empty());
+  BOOST_CHECK(!pplaychain_api->list_tables_page({}, 10).next_page_id.valid());
+
+  auto room = create_new_room(registrator);
+  for (size_t ci = 0; ci < 5; ++ci) {
+    create_table(registrator, room);
+  }
+
+  auto tables = pplaychain_api->list_all_tables("", 5);
+  BOOST_REQUIRE_EQUAL(tables.size(), 5u);
+
+  vector<playchain_table_summary> crawled;
+  optional<table_id_type> last_page_id;
+  do {
+    auto page = pplaychain_api->list_tables_page(last_page_id, 2);
+    BOOST_REQUIRE(!page.items.empty());
+    crawled.insert(crawled.end(), page.items.begin(), page.items.end());
+    last_page_id = page.next_page_id;
+  } while (last_page_id.valid());
+
+  BOOST_REQUIRE_EQUAL(crawled.size(), tables.size());
+  for (size_t ci = 0; ci < tables.size(); ++ci) {
+    BOOST_CHECK(crawled[ci].id == tables[ci].id);
+    BOOST_CHECK(crawled[ci].room == room);
+    BOOST_CHECK_EQUAL(crawled[ci].metadata, tables[ci].metadata);
+    BOOST_CHECK_EQUAL(crawled[ci].playing, tables[ci].is_playing());
+  }
+
+  // the page after the last table is empty
+  BOOST_CHECK(pplaychain_api->list_tables_page(tables.back().id, 2).items.empty());
+
+  auto rooms = pplaychain_api->list_rooms_page({}, 10);
+  BOOST_REQUIRE_EQUAL(rooms.items.size(), 1u);
+  BOOST_CHECK(rooms.items[0].id == room);
+  BOOST_CHECK(rooms.items[0].owner == actor(registrator));
+  BOOST_CHECK(!rooms.next_page_id.valid());
+}
+
 PLAYCHAIN_TEST_CASE(check_negative_list_tables) {
   BOOST_CHECK_THROW(
       pplaychain_api->list_tables(id_to_string(PLAYCHAIN_NULL_PLAYER), "",
@@ -1694,6 +1741,124 @@ PLAYCHAIN_TEST_CASE(check_list_tables_with_player_and_buyouting) {
   }
 }
 
+PLAYCHAIN_TEST_CASE(check_batch_reads_match_single_calls) {
+  using namespace playchain::app;
+
+  static const std::string game = "Game";
+  static const std::string pending = "Pending";
+  static const std::string unknown = "abracadabra";
+
+  room_id_type room = create_new_room(registrator);
+  create_new_room(registrator, "next1");
+
+  table_id_type table_with_game = create_new_table(registrator, room, 0u, game);
+  table_id_type table_with_alice =
+      create_new_table(registrator, room, 0u, pending);
+
+  Actor bob = create_new_player(registrator, "bob", asset(big_init_balance));
+  Actor sam = create_new_player(registrator, "sam", asset(big_init_balance));
+
+  auto stake = asset(big_init_balance / 2);
+
+  BOOST_REQUIRE_NO_THROW(table_alive(registrator, table_with_game));
+  BOOST_REQUIRE_NO_THROW(table_alive(registrator, table_with_alice));
+
+  const std::string alice_uid = get_next_uid(actor(alice));
+  BOOST_REQUIRE_NO_THROW(buy_in_reserve(alice, alice_uid, stake, pending));
+
+  BOOST_REQUIRE_NO_THROW(buy_in_table(bob, registrator, table_with_game, stake));
+  BOOST_REQUIRE_NO_THROW(buy_in_table(sam, registrator, table_with_game, stake));
+
+  generate_block();
+
+  BOOST_REQUIRE(!is_account_exists(unknown));
+
+  {
+    const vector<string> names{alice, id_to_string(alice), registrator, bob,
+                               unknown, alice};
+    auto players = pplaychain_api->get_players(names);
+    BOOST_REQUIRE_EQUAL(players.size(), names.size());
+
+    for (size_t ci = 0; ci < names.size(); ++ci) {
+      if (names[ci] == unknown) {
+        BOOST_CHECK(!players[ci].valid());
+        continue;
+      }
+      BOOST_CHECK_EQUAL(
+          fc::json::to_string(players[ci]),
+          fc::json::to_string(pplaychain_api->get_player(names[ci])));
+    }
+    BOOST_CHECK(!players[2].valid());
+  }
+
+  {
+    const vector<std::pair<string, string>> keys{
+        {registrator, default_room_metadata},
+        {registrator, "next1"},
+        {id_to_string(registrator), default_room_metadata},
+        {registrator, unknown},
+        {unknown, default_room_metadata}};
+    auto rooms = pplaychain_api->get_rooms_info(keys);
+    BOOST_REQUIRE_EQUAL(rooms.size(), keys.size());
+
+    for (size_t ci = 0; ci < keys.size(); ++ci) {
+      if (keys[ci].first == unknown) {
+        BOOST_CHECK(!rooms[ci].valid());
+        continue;
+      }
+      BOOST_CHECK_EQUAL(fc::json::to_string(rooms[ci]),
+                        fc::json::to_string(pplaychain_api->get_room_info(
+                            keys[ci].first, keys[ci].second)));
+    }
+    BOOST_CHECK(rooms[0].valid());
+    BOOST_CHECK(!rooms[3].valid());
+  }
+
+  {
+    const vector<std::pair<string, string>> keys{
+        {alice, alice_uid}, {id_to_string(alice), alice_uid}, {alice, unknown},
+        {unknown, alice_uid}};
+    auto tables = pplaychain_api->get_tables_info_for_pending_buy_in_proposals(keys);
+    BOOST_REQUIRE_EQUAL(tables.size(), keys.size());
+
+    BOOST_REQUIRE(tables[0].valid());
+    BOOST_CHECK(tables[0]->id == table_with_alice);
+    BOOST_CHECK_EQUAL(fc::json::to_string(tables[0]),
+                      fc::json::to_string(
+                          pplaychain_api->get_table_info_for_pending_buy_in_proposal(
+                              alice, alice_uid)));
+    BOOST_CHECK_EQUAL(fc::json::to_string(tables[1]),
+                      fc::json::to_string(tables[0]));
+    BOOST_CHECK(!tables[2].valid());
+    BOOST_CHECK(!tables[3].valid());
+  }
+
+  {
+    const vector<string> names{alice, bob, sam, unknown, id_to_string(bob)};
+    auto tables = pplaychain_api->list_tables_with_players(names, 10);
+    BOOST_REQUIRE_EQUAL(tables.size(), names.size());
+
+    for (size_t ci = 0; ci < names.size(); ++ci) {
+      if (names[ci] == unknown) {
+        BOOST_CHECK(tables[ci].empty());
+        continue;
+      }
+      BOOST_CHECK_EQUAL(fc::json::to_string(tables[ci]),
+                        fc::json::to_string(pplaychain_api->list_tables_with_player(
+                            names[ci], 10)));
+      BOOST_CHECK_EQUAL(tables[ci].size(), 1u);
+    }
+  }
+
+  BOOST_CHECK_THROW(pplaychain_api->list_tables_with_players(
+                        {alice}, PLAYCHAIN_MAX_SIZE_FOR_RESULT_API_LIST + 1),
+                    fc::exception);
+  BOOST_CHECK_THROW(
+      pplaychain_api->get_players(vector<string>(
+          PLAYCHAIN_MAX_SIZE_FOR_RESULT_API_LIST + 1, alice.name)),
+      fc::exception);
+}
+
 PLAYCHAIN_TEST_CASE(check_version_ext_conversions) {
   static const char *VER_EXP = "1.2.3+20190501";
   std::string ver_str{VER_EXP};
@@ -180,18 +180,27 @@ fc::ecc::private_key playchain_fixture::create_private_key_from_password(const s
 
 void playchain_fixture::print_block_operations()
 {
-    auto history = db.get_applied_operations();
+    //the applied operations live until the block observers are called, so the next block is printed from one
+    db.add_applied_operations_consumer();
+    auto connection = db.applied_block.connect([&](const signed_block &b)
+    {
+        ilog("--> block ${b}:", ("b", b.block_num()));
 
-    ilog("--> block ${b}:", ("b", db.head_block_num()));
+        size_t ci = 0;
+        for(const auto &rec: db.get_applied_operations())
+        {
+           if (rec.removed)
+               continue;
 
-    for(const auto &rec: history)
-    {
-       if (!rec.valid())
-           continue;
+           playchain_common::get_operation_name get;
+           ilog("${ci}: ${n} -> ${op}", ("ci", ci++)("n", rec.op.visit(get))("op", rec.op));
+        }
+    });
 
-       playchain_common::get_operation_name get;
-       ilog("${id}: ${n} -> ${op}", ("id", (object_id_type)rec->id)("n", rec->op.visit(get))("op", rec->op));
-    }
+    generate_block();
+
+    connection.disconnect();
+    db.remove_applied_operations_consumer();
 }
 
 operation_history_id_type playchain_fixture::print_last_operations(const account_id_type& who,
@@ -734,6 +743,38 @@ game_result_check_operation playchain_fixture::game_result_check(
     return op;
 }
 
+game_votes_check_operation playchain_fixture::game_votes_check_op(
+                                    const account_id_type& voter,
+                                    const account_id_type& owner,
+                                    const std::map<table_id_type, voting_data_type> &votes)
+{
+    game_votes_check_operation op;
+
+    op.voter = voter;
+    for (const auto &vote: votes)
+    {
+        op.votes[vote.first] = game_table_vote{owner, vote.second};
+    }
+
+    return op;
+}
+
+game_votes_check_operation playchain_fixture::game_votes_check(
+                                    const Actor& voter,
+                                    const std::map<table_id_type, voting_data_type> &votes)
+{
+    game_votes_check_operation op;
+
+    op.voter = actor(voter);
+    for (const auto &vote: votes)
+    {
+        op.votes[vote.first] = game_table_vote{vote.first(db).room(db).owner, vote.second};
+    }
+
+    actor(voter).push_operation(op);
+    return op;
+}
+
 game_reset_operation playchain_fixture::game_reset_op(
                                     const account_id_type& owner,
                                     const table_id_type &table,
@@ -894,4 +935,24 @@ tables_alive_operation playchain_fixture::tables_alive(const Actor& room_owner,
     actor(room_owner).push_operation(op);
     return op;
 }
+
+room_alive_operation playchain_fixture::room_alive_op(const account_id_type& room_owner,
+                                  const room_id_type &room)
+{
+    room_alive_operation op;
+
+    op.owner = room_owner;
+    op.room = room;
+
+    return op;
+}
+
+room_alive_operation playchain_fixture::room_alive(const Actor& room_owner,
+                                  const room_id_type &room)
+{
+    auto op = room_alive_op(actor(room_owner), room);
+
+    actor(room_owner).push_operation(op);
+    return op;
+}
 }
@@ -10,6 +10,7 @@
 #include "actor.hpp"
 #include "defines.hpp"
 
+#include <map>
 #include <set>
 
 namespace playchain_common
@@ -151,6 +152,7 @@ namespace playchain_common
 
         fc::ecc::private_key create_private_key_from_password(const string &password, const string &salt);
 
+        ///generates the next block and prints its operations
         void print_block_operations();
 
         operation_history_id_type print_last_operations(const account_id_type& who,
@@ -376,6 +378,20 @@ namespace playchain_common
                                                        const table_id_type &table,
                                                        const game_result &result);
 
+        game_votes_check_operation  game_votes_check_op(const account_id_type& voter,
+                                                        const account_id_type& owner,
+                                                        const std::map<table_id_type, voting_data_type> &votes);
+
+        game_votes_check_operation  game_votes_check_op(const Actor& voter,
+                                                        const Actor& owner,
+                                                        const std::map<table_id_type, voting_data_type> &votes)
+        {
+            return game_votes_check_op(actor(voter), actor(owner), votes);
+        }
+
+        game_votes_check_operation  game_votes_check(const Actor& voter,
+                                                     const std::map<table_id_type, voting_data_type> &votes);
+
         game_reset_operation  game_reset_op(const account_id_type& owner,
                                             const table_id_type &table,
                                             const bool rollback_table);
@@ -454,6 +470,12 @@ namespace playchain_common
 
         tables_alive_operation tables_alive(const Actor& room_owner,
                                           const std::set<table_id_type> &tables);
+
+        room_alive_operation room_alive_op(const account_id_type& room_owner,
+                                          const room_id_type &room);
+
+        room_alive_operation room_alive(const Actor& room_owner,
+                                       const room_id_type &room);
     };
 }
 
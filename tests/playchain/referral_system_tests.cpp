@@ -7,6 +7,9 @@
 
 #include <playchain/chain/evaluators/db_helpers.hpp>
 
+#include <graphene/chain/hardfork.hpp>
+#include <graphene/utilities/tempdir.hpp>
+
 namespace referral_system_tests
 {
 struct referral_system_fixture: public playchain_common::playchain_fixture
@@ -569,5 +572,197 @@ PLAYCHAIN_TEST_CASE(check_rewards_in_several_rooms)
                       to_string(witness_reward_at_room2) );
 }
 
+PLAYCHAIN_TEST_CASE(check_pending_fees_aggregation)
+{
+    generate_blocks(HARDFORK_PLAYCHAIN_14_TIME);
+
+    room_id_type room = create_new_room(richregistrator1);
+    table_id_type table = create_new_table(richregistrator1, room);
+    create_new_room(richregistrator2);
+
+    auto rake1 = create_rake_with_bob(table, richregistrator1, richregistrator2, alice);
+    auto rake2 = create_rake_with_bob(table, richregistrator1, richregistrator2, alice);
+
+    const player_object &alice_obj = get_player(alice)(db);
+
+    //the same table, witnesses and asset give the single entry
+    BOOST_REQUIRE_EQUAL(alice_obj.pending_fees.size(), 1u);
+    BOOST_CHECK_EQUAL(to_string(asset(alice_obj.pending_fees.front().amount)), to_string(rake1 + rake2));
+    BOOST_REQUIRE_EQUAL(alice_obj.pending_rakes.size(), 2u);
+
+    next_maintenance();
+
+    BOOST_CHECK(alice_obj.pending_fees.empty());
+    BOOST_CHECK(alice_obj.pending_rakes.empty());
+
+    //every rake is cut on its own
+    asset expected_witness_reward = percent(rake1, PLAYCHAIN_DEFAULT_WITNESS_PERCENT_OF_FEE) +
+                                    percent(rake2, PLAYCHAIN_DEFAULT_WITNESS_PERCENT_OF_FEE);
+    asset expected_table_owner_reward = rake1 + rake2;
+    expected_table_owner_reward -= expected_witness_reward;
+
+    BOOST_CHECK_EQUAL(to_string(get_table_owner_reward_balance(richregistrator1)),
+                      to_string(expected_table_owner_reward));
+
+    BOOST_CHECK_EQUAL(to_string(get_witness_reward_balance(richregistrator2)),
+                      to_string(expected_witness_reward));
+}
+
+PLAYCHAIN_TEST_CASE(check_pending_fees_replay)
+{
+    //there is no maintenance in the last hour before the hardfork
+    generate_blocks(HARDFORK_PLAYCHAIN_14_TIME - 60*60);
+
+    room_id_type room1 = create_new_room(richregistrator1);
+    table_id_type table1 = create_new_table(richregistrator1, room1);
+    room_id_type room2 = create_new_room(richregistrator2);
+    table_id_type table2 = create_new_table(richregistrator2, room2);
+
+    CREATE_PLAYER(alice, sam);
+
+    const auto& params = get_playchain_parameters(db);
+
+    //to have the inviter's cut depending on balance
+    supply(alice, asset(params.player_referrer_balance_max_threshold / 2) - get_account_balance(alice));
+
+    //the fee taken before the aggregation is paid out with the aggregated ones
+    create_rake_with_bob(table1, richregistrator1, richregistrator2, sam);
+
+    generate_blocks(HARDFORK_PLAYCHAIN_14_TIME);
+
+    create_rake_with_bob(table2, richregistrator2, richregistrator1, sam);
+    create_rake_with_bob(table1, richregistrator1, richregistrator2, sam);
+    create_rake_with_bob(table2, richregistrator2, richregistrator1, sam);
+
+    BOOST_REQUIRE_EQUAL(get_player(sam)(db).pending_fees.size(), 2u);
+    BOOST_REQUIRE_EQUAL(get_player(sam)(db).pending_rakes.size(), 4u);
+
+    const auto games_block_num = db.head_block_num();
+
+    next_maintenance();
+
+    //the same blocks with a separate pending fee for every game
+    fc::temp_directory replay_dir( graphene::utilities::temp_directory_path() );
+
+    database replay_db;
+    test::pending_fees_hooks::enable_aggregation(replay_db, false);
+    replay_db.open(replay_dir.path(), [this]{return genesis_state;}, "test");
+
+    auto replay_to = [&](const uint32_t block_num)
+    {
+        while( replay_db.head_block_num() < block_num )
+        {
+            optional< signed_block > b = db.fetch_block_by_number( replay_db.head_block_num()+1 );
+            replay_db.push_block(*b, ~0);
+        }
+    };
+
+    replay_to(games_block_num);
+
+    const auto &replayed_sam = replay_db.get<player_object>(get_player(sam));
+    BOOST_CHECK_EQUAL(replayed_sam.pending_fees.size(), 4u);
+    BOOST_CHECK(replayed_sam.pending_rakes.empty());
+
+    replay_to(db.head_block_num());
+
+    BOOST_CHECK(replayed_sam.is_not_pending());
+
+    for (const account_object &account: db.get_index_type<account_index>().indices())
+    {
+        BOOST_CHECK_EQUAL(to_string(replay_db.get_balance(account.id, asset_id_type())),
+                          to_string(db.get_balance(account.id, asset_id_type())));
+    }
+
+    //every cashback lands to the vesting balances
+    const auto &vbs = db.get_index_type<vesting_balance_index>().indices().get<by_id>();
+    const auto &replayed_vbs = replay_db.get_index_type<vesting_balance_index>().indices().get<by_id>();
+    BOOST_REQUIRE_EQUAL(vbs.size(), replayed_vbs.size());
+    for (const vesting_balance_object &vb: vbs)
+    {
+        const auto &replayed_vb = replay_db.get<vesting_balance_object>(vb.id);
+        BOOST_CHECK(replayed_vb.owner == vb.owner);
+        BOOST_CHECK_EQUAL(to_string(replayed_vb.balance), to_string(vb.balance));
+    }
+
+    BOOST_CHECK_EQUAL(to_string(replay_db.get<room_object>(room1).pending_rake),
+                      to_string(room1(db).pending_rake));
+    BOOST_CHECK_EQUAL(to_string(replay_db.get<room_object>(room2).pending_rake),
+                      to_string(room2(db).pending_rake));
+
+    replay_db.close();
+}
+
+PLAYCHAIN_TEST_CASE(check_pending_fees_deposit_replay)
+{
+    generate_blocks(HARDFORK_PLAYCHAIN_15_TIME);
+
+    room_id_type room1 = create_new_room(richregistrator1);
+    table_id_type table1 = create_new_table(richregistrator1, room1);
+    room_id_type room2 = create_new_room(richregistrator2);
+    table_id_type table2 = create_new_table(richregistrator2, room2);
+
+    const auto& params = get_playchain_parameters(db);
+
+    //the inviter cuts depend on the balances and the remainders are passed beyond the maximum depth
+    auto &latest_player = create_embedded_playes_depth_8(alice, asset(params.player_referrer_balance_max_threshold / 2));
+    CREATE_PLAYER(player4, sam);
+
+    create_rake_with_bob(table1, richregistrator1, richregistrator2, latest_player);
+    create_rake_with_bob(table2, richregistrator2, richregistrator1, sam);
+    create_rake_with_bob(table1, richregistrator1, richregistrator2, sam);
+    create_rake_with_bob(table2, richregistrator2, richregistrator1, latest_player);
+
+    next_maintenance();
+
+    create_rake_with_bob(table1, richregistrator1, richregistrator2, latest_player);
+    create_rake_with_bob(table2, richregistrator2, richregistrator1, sam);
+
+    next_maintenance();
+
+    //the same blocks with every cut deposited at once
+    fc::temp_directory replay_dir( graphene::utilities::temp_directory_path() );
+
+    database replay_db;
+    test::pending_fees_hooks::enable_accumulation(replay_db, false);
+    replay_db.open(replay_dir.path(), [this]{return genesis_state;}, "test");
+
+    while( replay_db.head_block_num() < db.head_block_num() )
+    {
+        optional< signed_block > b = db.fetch_block_by_number( replay_db.head_block_num()+1 );
+        replay_db.push_block(*b, ~0);
+    }
+
+    for (const account_object &account: db.get_index_type<account_index>().indices())
+    {
+        BOOST_CHECK_EQUAL(to_string(replay_db.get_balance(account.id, asset_id_type())),
+                          to_string(db.get_balance(account.id, asset_id_type())));
+    }
+
+    const auto &vbs = db.get_index_type<vesting_balance_index>().indices().get<by_id>();
+    const auto &replayed_vbs = replay_db.get_index_type<vesting_balance_index>().indices().get<by_id>();
+    BOOST_REQUIRE_EQUAL(vbs.size(), replayed_vbs.size());
+    for (const vesting_balance_object &vb: vbs)
+    {
+        const auto &replayed_vb = replay_db.get<vesting_balance_object>(vb.id);
+        BOOST_CHECK(replayed_vb.owner == vb.owner);
+        BOOST_CHECK_EQUAL(to_string(replayed_vb.balance), to_string(vb.balance));
+    }
+
+    for (const player_object &player: db.get_index_type<player_index>().indices())
+    {
+        const auto &replayed_player = replay_db.get<player_object>(player.id);
+        BOOST_CHECK(replayed_player.balance == player.balance);
+        BOOST_CHECK_EQUAL(fc::json::to_string(replayed_player.pending_parent_invitation_fees),
+                          fc::json::to_string(player.pending_parent_invitation_fees));
+    }
+
+    BOOST_CHECK_EQUAL(to_string(replay_db.get<room_object>(room1).pending_rake),
+                      to_string(room1(db).pending_rake));
+    BOOST_CHECK_EQUAL(to_string(replay_db.get<room_object>(room2).pending_rake),
+                      to_string(room2(db).pending_rake));
+
+    replay_db.close();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }
@@ -156,5 +156,101 @@ PLAYCHAIN_TEST_CASE(check_room_with_version_creation)
     BOOST_CHECK_THROW(create_room(richregistrator, "test6", "..1"), fc::exception);
 }
 
+PLAYCHAIN_TEST_CASE(check_room_metadata_uniqueness)
+{
+    const std::string metadata = "unique room metadata";
+
+    room_id_type room_id = create_new_room(richregistrator, metadata);
+
+    BOOST_CHECK_EQUAL(room_id(db).metadata, metadata);
+    BOOST_CHECK_THROW(create_room(richregistrator, metadata), fc::exception);
+
+    //the equal strings share the handle of the room metadata
+    room_id_type next_room_id = create_new_room(richregistrator, std::string{"next "} + metadata);
+    BOOST_CHECK(room_id(db).metadata != next_room_id(db).metadata);
+    BOOST_CHECK(room_id(db).metadata == db.interned_strings().intern(metadata));
+
+    update_room(richregistrator, next_room_id, default_room_server, "updated room metadata");
+    BOOST_CHECK_THROW(update_room(richregistrator, next_room_id, default_room_server, metadata), fc::exception);
+
+    auto info = pplaychain_api->get_room_info(richregistrator.name, "updated room metadata");
+    BOOST_REQUIRE(info.valid());
+    BOOST_CHECK(info->id == next_room_id);
+}
+
+PLAYCHAIN_TEST_CASE(check_table_object_serialization)
+{
+    auto room_id = create_new_room(richregistrator);
+    auto table_id = create_new_table(richregistrator, room_id);
+
+    const auto &table = table_id(db);
+    db.modify(table, [&](table_object &obj)
+    {
+        for (uint32_t ci = 0; ci < 2 * table_inline_seats; ++ci)
+        {
+            obj.adjust_cash(player_id_type(ci), asset(ci + 1));
+        }
+        obj.adjust_playing_cash(player_id_type(1), asset(2));
+    });
+
+    //the interned metadata and the seats are serialized as a string and plain maps
+    BOOST_CHECK(fc::raw::pack(table.metadata) == fc::raw::pack(table.metadata.str()));
+    flat_map<player_id_type, asset> cash(table.cash.begin(), table.cash.end());
+    BOOST_CHECK(fc::raw::pack(table.cash) == fc::raw::pack(cash));
+
+    fc::variant var(table, 5);
+    BOOST_CHECK_EQUAL(var["metadata"].as_string(), default_table_metadata);
+    BOOST_CHECK_EQUAL(var["cash"].get_array().size(), cash.size());
+
+    table_object restored = fc::raw::unpack<table_object>(fc::raw::pack(table));
+    BOOST_CHECK(restored.metadata == table.metadata);
+    BOOST_CHECK(restored.cash == table.cash);
+    BOOST_CHECK(restored.playing_cash == table.playing_cash);
+    BOOST_CHECK(fc::raw::pack(restored) == fc::raw::pack(table));
+
+    restored = var.as<table_object>(5);
+    BOOST_CHECK(restored.metadata == table.metadata);
+    BOOST_CHECK(restored.cash == table.cash);
+
+    //the lookup does not intern unknown strings
+    auto &strings = db.interned_strings();
+    auto symbols = strings.size();
+    BOOST_CHECK(!strings.find("never used table metadata").valid());
+    BOOST_CHECK_EQUAL(strings.size(), symbols);
+    BOOST_CHECK(pplaychain_api->get_tables_info_by_metadata(id_to_string(room_id), "never used table metadata", 10).empty());
+    BOOST_CHECK_EQUAL(pplaychain_api->get_tables_info_by_metadata(id_to_string(room_id), default_table_metadata, 10).size(), 1u);
+
+    //the strings are released with the last handle, the ones unpacked out of the database do not go to its table
+    {
+        table_object transient = table;
+        transient.metadata = strings.intern("transient table metadata");
+        BOOST_CHECK_EQUAL(strings.size(), symbols + 1);
+
+        table_object unpacked = fc::raw::unpack<table_object>(fc::raw::pack(transient));
+        table_object converted = fc::variant(transient, 5).as<table_object>(5);
+        BOOST_CHECK(unpacked.metadata == transient.metadata);
+        BOOST_CHECK(converted.metadata == transient.metadata);
+        BOOST_CHECK_EQUAL(strings.size(), symbols + 1);
+    }
+    BOOST_CHECK_EQUAL(strings.size(), symbols);
+
+    //the handles are ordered the same way in every table
+    {
+        auto other_strings = interned_string_table::create();
+        std::vector<std::string> values{"metadata a", "metadata b", "metadata c", "metadata d"};
+        for (const auto &a: values)
+        {
+            for (const auto &b: values)
+            {
+                BOOST_CHECK_EQUAL(strings.intern(a) < strings.intern(b), other_strings->intern(a) < other_strings->intern(b));
+                BOOST_CHECK_EQUAL(strings.intern(a) < other_strings->intern(b), other_strings->intern(a) < strings.intern(b));
+            }
+            BOOST_CHECK(strings.intern(a) == other_strings->intern(a));
+        }
+    }
+    BOOST_CHECK_EQUAL(strings.size(), symbols);
+    BOOST_CHECK(table.metadata == default_table_metadata);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }
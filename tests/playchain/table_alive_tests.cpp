@@ -5,6 +5,7 @@
 
 #include <playchain/chain/evaluators/db_helpers.hpp>
 #include <playchain/chain/evaluators/validators.hpp>
+#include <playchain/chain/evaluators/table_evaluators.hpp>
 #include <graphene/chain/hardfork.hpp>
 
 #include <algorithm>
@@ -372,5 +373,147 @@ PLAYCHAIN_TEST_CASE(check_table_find_with_game_witnesses)
                 table3(db).get_pending_proposals() == 2u);
 }
 
+PLAYCHAIN_TEST_CASE(check_room_alive_before_hardfork)
+{
+    room_id_type room = create_new_room(richregistrator);
+
+    create_new_table(richregistrator, room);
+
+    BOOST_CHECK_NO_THROW(room_alive_op(richregistrator, room).validate());
+
+    BOOST_CHECK_THROW(room_alive(richregistrator, room), fc::exception);
+}
+
+PLAYCHAIN_TEST_CASE(check_negative_room_alive_operation)
+{
+    generate_blocks(HARDFORK_PLAYCHAIN_12_TIME);
+
+    room_id_type room = create_new_room(richregistrator);
+
+    BOOST_CHECK_THROW(room_alive_op(GRAPHENE_COMMITTEE_ACCOUNT, room).validate(), fc::exception);
+    BOOST_CHECK_THROW(room_alive_op(richregistrator, PLAYCHAIN_NULL_ROOM).validate(), fc::exception);
+
+    BOOST_CHECK_THROW(room_alive(richregistrator2, room), fc::exception);
+
+    BOOST_CHECK_NO_THROW(room_alive(richregistrator, room));
+}
+
+PLAYCHAIN_TEST_CASE(check_room_alive_object_lifetime)
+{
+    generate_blocks(HARDFORK_PLAYCHAIN_12_TIME);
+
+    room_id_type room = create_new_room(richregistrator, "room");
+    room_id_type other_room = create_new_room(richregistrator2, "other room");
+
+    std::vector<table_id_type> tables;
+    for (int ci = 0; ci < 3; ++ci)
+    {
+        tables.emplace_back(create_new_table(richregistrator, room));
+    }
+    table_id_type other_table = create_new_table(richregistrator2, other_room);
+
+    generate_block();
+
+    for (const auto &table: tables)
+    {
+        BOOST_CHECK(!is_table_alive(db, table));
+    }
+
+    BOOST_REQUIRE_NO_THROW(room_alive(richregistrator, room));
+
+    generate_block();
+
+    BOOST_REQUIRE(is_room_alive(db, room));
+    BOOST_CHECK(!is_room_alive(db, other_room));
+
+    for (const auto &table: tables)
+    {
+        BOOST_CHECK(is_table_alive(db, table));
+        BOOST_CHECK_EQUAL(table(db).weight, room(db).rating);
+    }
+    BOOST_CHECK(!is_table_alive(db, other_table));
+
+    const auto& alive_idx = db.get_index_type<room_alive_index>().indices().get<by_room>();
+    BOOST_REQUIRE(alive_idx.find(room) != alive_idx.end());
+
+    const auto& params = get_playchain_parameters(db);
+
+    auto prev_ping = db.get_dynamic_global_properties().time;
+
+    generate_blocks(prev_ping + fc::seconds(params.table_alive_expiration_seconds / 2 ));
+
+    prev_ping = db.get_dynamic_global_properties().time;
+
+    BOOST_REQUIRE_NO_THROW(room_alive(richregistrator, room));
+
+    generate_block();
+
+    BOOST_CHECK_EQUAL((alive_idx.find(room)->expiration - prev_ping).to_seconds(), params.table_alive_expiration_seconds);
+
+    generate_blocks(prev_ping + fc::seconds(params.table_alive_expiration_seconds / 2 ));
+
+    //the table with own heartbeat keeps alive after the room heartbeat expiration
+    BOOST_REQUIRE_NO_THROW(tables_alive(richregistrator, {tables[0]}));
+
+    generate_blocks(prev_ping + fc::seconds(params.table_alive_expiration_seconds));
+    generate_block();
+
+    BOOST_CHECK(!is_room_alive(db, room));
+    BOOST_CHECK(alive_idx.find(room) == alive_idx.end());
+
+    BOOST_CHECK(is_table_alive(db, tables[0]));
+    BOOST_CHECK_EQUAL(tables[0](db).weight, room(db).rating);
+
+    for (size_t ci = 1; ci < tables.size(); ++ci)
+    {
+        BOOST_CHECK(!is_table_alive(db, tables[ci]));
+        BOOST_CHECK_LT(tables[ci](db).weight, 0);
+    }
+}
+
+PLAYCHAIN_TEST_CASE(check_room_alive_renewal_does_not_touch_tables)
+{
+    generate_blocks(HARDFORK_PLAYCHAIN_12_TIME);
+
+    room_id_type room = create_new_room(richregistrator);
+
+    const size_t tables_count = 10;
+    for (size_t ci = 0; ci < tables_count; ++ci)
+    {
+        create_new_table(richregistrator, room);
+    }
+
+    generate_block();
+
+    auto count_modified_tables = [&]()
+    {
+        size_t result = 0;
+        for (const auto &item: db._undo_db.head().old_values)
+        {
+            if (item.first.is<table_id_type>())
+                ++result;
+        }
+        return result;
+    };
+
+    {
+        auto session = db._undo_db.start_undo_session();
+
+        alive_for_room(db, room);
+
+        BOOST_CHECK_EQUAL(count_modified_tables(), tables_count);
+
+        session.merge();
+    }
+
+    {
+        auto session = db._undo_db.start_undo_session();
+
+        alive_for_room(db, room);
+
+        BOOST_CHECK_EQUAL(count_modified_tables(), 0u);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }
@@ -2463,5 +2463,183 @@ PLAYCHAIN_TEST_CASE(playing_results_pending_vote_with_witness_check)
     BOOST_REQUIRE(table_obj.is_free());
 }
 
+PLAYCHAIN_TEST_CASE(check_negative_game_votes_check_operation)
+{
+    room_id_type room = create_new_room(richregistrator1);
+    table_id_type table = create_new_table(richregistrator1, room);
+    game_initial_data data;
+    auto stake = asset(player_init_balance/2);
+    data.cash[actor(alice)] = stake;
+    data.cash[actor(bob)] = stake;
+    data.info = "alice is diller";
+
+    std::map<table_id_type, voting_data_type> votes;
+
+    BOOST_CHECK_THROW(game_votes_check_op(richregistrator1, richregistrator1, votes).validate(), fc::exception);
+
+    votes[table] = data;
+
+    BOOST_CHECK_NO_THROW(game_votes_check_op(richregistrator1, richregistrator1, votes).validate());
+    BOOST_CHECK_THROW(game_votes_check_op(actor(richregistrator1), GRAPHENE_COMMITTEE_ACCOUNT, votes).validate(), fc::exception);
+    BOOST_CHECK_THROW(game_votes_check_op(GRAPHENE_COMMITTEE_ACCOUNT, actor(richregistrator1), votes).validate(), fc::exception);
+
+    votes[PLAYCHAIN_NULL_TABLE] = data;
+
+    BOOST_CHECK_THROW(game_votes_check_op(richregistrator1, richregistrator1, votes).validate(), fc::exception);
+
+    votes.erase(PLAYCHAIN_NULL_TABLE);
+    data.cash.erase(actor(alice));
+    votes[table] = data;
+
+    BOOST_CHECK_THROW(game_votes_check_op(richregistrator1, richregistrator1, votes).validate(), fc::exception);
+
+    votes.clear();
+    for (size_t ci = 0; ci <= PLAYCHAIN_MAX_SIZE_FOR_GAME_VOTES_PER_OP; ++ci)
+    {
+        votes[table_id_type(ci + 1)] = game_result();
+    }
+
+    BOOST_CHECK_THROW(game_votes_check_op(richregistrator1, richregistrator1, votes).validate(), fc::exception);
+}
+
+PLAYCHAIN_TEST_CASE(check_game_votes_check_before_hardfork)
+{
+    room_id_type room = create_new_room(richregistrator1);
+    table_id_type table = create_new_table(richregistrator1, room);
+
+    auto stake = asset(player_init_balance/2);
+
+    BOOST_CHECK_NO_THROW(buy_in_table(alice, richregistrator1, table, stake));
+    BOOST_CHECK_NO_THROW(buy_in_table(bob, richregistrator1, table, stake));
+
+    game_initial_data initial;
+    initial.cash[actor(alice)] = stake;
+    initial.cash[actor(bob)] = stake;
+    initial.info = "alice is diller";
+
+    BOOST_CHECK_THROW(game_votes_check(richregistrator1, {{table, initial}}), fc::exception);
+
+    generate_blocks(HARDFORK_PLAYCHAIN_13_TIME);
+
+    BOOST_CHECK_NO_THROW(game_votes_check(richregistrator1, {{table, initial}}));
+
+    BOOST_CHECK(is_table_voting(db, table));
+}
+
+PLAYCHAIN_TEST_CASE(check_game_votes_for_many_tables)
+{
+    generate_blocks(HARDFORK_PLAYCHAIN_13_TIME);
+
+    room_id_type room = create_new_room(richregistrator1);
+    table_id_type table1 = create_new_table(richregistrator1, room);
+    table_id_type table2 = create_new_table(richregistrator1, room);
+    //no buy-ins here
+    table_id_type table3 = create_new_table(richregistrator1, room);
+
+    auto stake = asset(player_init_balance/2);
+
+    BOOST_CHECK_NO_THROW(buy_in_table(alice, richregistrator1, table1, stake));
+    BOOST_CHECK_NO_THROW(buy_in_table(bob, richregistrator1, table1, stake));
+    BOOST_CHECK_NO_THROW(buy_in_table(sam, richregistrator1, table2, stake));
+    BOOST_CHECK_NO_THROW(buy_in_table(jon, richregistrator1, table2, stake));
+
+    game_initial_data initial1;
+    initial1.cash[actor(alice)] = stake;
+    initial1.cash[actor(bob)] = stake;
+    initial1.info = "alice is diller";
+
+    game_initial_data initial2;
+    initial2.cash[actor(sam)] = stake;
+    initial2.cash[actor(jon)] = stake;
+    initial2.info = "sam is diller";
+
+    //players should vote by single operations
+    BOOST_CHECK_NO_THROW(game_votes_check(alice, {{table1, initial1}}));
+    BOOST_CHECK(!is_table_voting(db, table1));
+
+    //invalid vote for table3 does not break votes for other tables
+    BOOST_CHECK_NO_THROW(game_votes_check(richregistrator1, {{table1, initial1},
+                                                             {table2, initial2},
+                                                             {table3, initial1}}));
+
+    BOOST_CHECK(is_table_voting(db, table1));
+    BOOST_CHECK(is_table_voting(db, table2));
+    BOOST_CHECK(!is_table_voting(db, table3));
+
+    generate_block();
+
+    //only the rejected table is reported
+    auto history = phistory_api->get_account_history(richregistrator1.name,
+                                                operation_history_id_type(),
+                                                100,
+                                                operation_history_id_type());
+
+    std::map<table_id_type, size_t> fail_votes;
+    for (const auto &rec: history)
+    {
+        if (rec.op.which() != game_event_id)
+            continue;
+
+        const auto &event_op = rec.op.get<game_event_operation>();
+        if (event_op.event.which() != game_event_type_id.fail_vote_id)
+            continue;
+
+        if (event_op.event.get<fail_vote>().voter == actor(richregistrator1))
+            ++fail_votes[event_op.table];
+    }
+
+    BOOST_CHECK_EQUAL(fail_votes.size(), 1u);
+    BOOST_CHECK_EQUAL(fail_votes[table3], 1u);
+
+    //owner has already voted
+    BOOST_CHECK_NO_THROW(game_votes_check(richregistrator1, {{table1, initial1}}));
+    const auto &voting_by_table = db.get_index_type<table_voting_index>().indices().get<by_table>();
+    BOOST_CHECK_EQUAL(voting_by_table.find(table1)->votes.size(), 1u);
+
+    BOOST_CHECK_NO_THROW(game_start_playing_check(alice, table1, initial1));
+    BOOST_CHECK_NO_THROW(game_start_playing_check(bob, table1, initial1));
+    BOOST_CHECK_NO_THROW(game_start_playing_check(sam, table2, initial2));
+    BOOST_CHECK_NO_THROW(game_start_playing_check(jon, table2, initial2));
+
+    generate_block();
+
+    BOOST_REQUIRE(table1(db).is_playing());
+    BOOST_REQUIRE(table2(db).is_playing());
+
+    game_result result1;
+    auto win = asset(stake.amount/2);
+    auto win_rake = asset(win.amount/20);
+    auto &alice_result = result1.cash[actor(alice)];
+    alice_result.cash = stake + win - win_rake;
+    alice_result.rake = win_rake;
+    auto &bob_result = result1.cash[actor(bob)];
+    bob_result.cash = stake - win;
+    result1.log = "alice has A 4";
+
+    game_result result2;
+    auto &sam_result = result2.cash[actor(sam)];
+    sam_result.cash = stake - win;
+    auto &jon_result = result2.cash[actor(jon)];
+    jon_result.cash = stake + win - win_rake;
+    jon_result.rake = win_rake;
+    result2.log = "jon has A 4";
+
+    BOOST_CHECK_NO_THROW(game_votes_check(richregistrator1, {{table1, result1},
+                                                             {table2, result2}}));
+
+    BOOST_CHECK_NO_THROW(game_result_check(alice, table1, result1));
+    BOOST_CHECK_NO_THROW(game_result_check(bob, table1, result1));
+    BOOST_CHECK_NO_THROW(game_result_check(sam, table2, result2));
+    BOOST_CHECK_NO_THROW(game_result_check(jon, table2, result2));
+
+    generate_block();
+
+    BOOST_CHECK(table1(db).is_free());
+    BOOST_CHECK(table2(db).is_free());
+
+    BOOST_CHECK(table1(db).is_waiting_at_table(get_player(alice)));
+    BOOST_CHECK(table2(db).is_waiting_at_table(get_player(jon)));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }
@@ -2249,4 +2249,54 @@ BOOST_AUTO_TEST_CASE( self_deleting_proposal )
    db.get<proposal_object>(pid1);
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE( proposal_authorization_follows_account_authorities )
+{ try {
+   ACTORS( (alice)(bob) );
+   fund( alice );
+   fund( bob );
+
+   transfer_operation top;
+   top.from = alice_id;
+   top.to = bob_id;
+   top.amount = asset( 500 );
+
+   proposal_create_operation pop;
+   pop.proposed_ops.emplace_back( top );
+   pop.fee_paying_account = bob_id;
+   pop.expiration_time = db.head_block_time() + fc::minutes(1);
+   trx.operations.push_back( pop );
+   const proposal_id_type pid = PUSH_TX( db, trx, ~0 ).operation_results[0].get<object_id_type>();
+   trx.clear();
+
+   BOOST_CHECK( !pid(db).is_authorized_to_execute(db) );
+
+   proposal_update_operation pup;
+   pup.fee_paying_account = bob_id;
+   pup.proposal = pid;
+   pup.active_approvals_to_add.insert( bob_id );
+   trx.operations.push_back( pup );
+   PUSH_TX( db, trx, ~0 );
+   trx.clear();
+
+   // bob does not control alice yet
+   BOOST_CHECK( !pid(db).is_authorized_to_execute(db) );
+   BOOST_CHECK( !pid(db).is_authorized_to_execute(db) );
+
+   account_update_operation uop;
+   uop.account = alice_id;
+   uop.active = authority( 1, bob_id, 1 );
+   trx.operations.push_back( uop );
+   PUSH_TX( db, trx, ~0 );
+   trx.clear();
+
+   // the cached result of the check is dropped with the authority change
+   BOOST_CHECK( pid(db).is_authorized_to_execute(db) );
+
+   const auto bob_balance = get_balance( bob_id, asset_id_type() );
+   generate_blocks( pid(db).expiration_time + db.get_global_properties().parameters.block_interval );
+
+   BOOST_CHECK( db.find( pid ) == nullptr );
+   BOOST_CHECK_EQUAL( get_balance( bob_id, asset_id_type() ), bob_balance + 500 );
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
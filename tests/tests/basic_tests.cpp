@@ -34,6 +34,7 @@
 
 #include <fc/crypto/digest.hpp>
 #include <fc/crypto/hex.hpp>
+#include <fc/io/json.hpp>
 #include "../common/database_fixture.hpp"
 
 #include <algorithm>
@@ -607,4 +608,32 @@ BOOST_AUTO_TEST_CASE( bitasset_feed_expiration_test )
    BOOST_CHECK( !o.feed_is_expired( now ) );
 }
 
+BOOST_AUTO_TEST_CASE( parse_genesis_state_test )
+{ try {
+   genesis_state_type genesis;
+   genesis.initial_timestamp = time_point_sec( 1500000000 );
+   const auto key = public_key_type( fc::ecc::private_key::regenerate( fc::digest( 1 ) ).get_public_key() );
+   genesis.initial_accounts.emplace_back( "alice", key, key, true );
+   genesis.initial_accounts.emplace_back( "bob", key );
+   genesis_state_type::initial_asset_type uia;
+   uia.symbol = "UIA";
+   uia.issuer_name = "alice";
+   uia.description = "{\"quoted\": [\"braces\", \"}]\"]} \\";
+   genesis.initial_assets.push_back( uia );
+   genesis.initial_balances.push_back( { address( key ), GRAPHENE_SYMBOL, 100 } );
+   genesis.initial_committee_candidates.push_back( { "alice" } );
+
+   const std::string json = fc::json::to_pretty_string( genesis );
+   const genesis_state_type parsed = parse_genesis_state( json, 20 );
+   const genesis_state_type expected = fc::json::from_string( json ).as<genesis_state_type>( 20 );
+
+   BOOST_CHECK_EQUAL( parsed.initial_accounts.size(), 2u );
+   BOOST_CHECK_EQUAL( parsed.initial_balances.size(), 1u );
+   BOOST_CHECK_EQUAL( parsed.initial_assets.size(), 1u );
+   BOOST_CHECK_EQUAL( parsed.initial_assets[0].description, uia.description );
+   BOOST_CHECK( fc::json::to_string( parsed ) == fc::json::to_string( expected ) );
+
+   BOOST_CHECK_THROW( parse_genesis_state( json.substr( 0, json.size() / 2 ), 20 ), fc::exception );
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
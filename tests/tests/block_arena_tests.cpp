@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/chain/database.hpp>
+#include <graphene/chain/block_arena.hpp>
+#include <graphene/chain/applied_operation_log.hpp>
+
+#include "../common/database_fixture.hpp"
+
+using namespace graphene::chain;
+using namespace graphene::chain::test;
+
+BOOST_FIXTURE_TEST_SUITE( block_arena_tests, database_fixture )
+
+BOOST_AUTO_TEST_CASE( arena_containers )
+{
+   block_arena arena( 256 );
+   block_arena::scope arena_scope( arena );
+
+   for( int round = 0; round < 3; ++round )
+   {
+      const uint64_t heap_allocations = arena.heap_allocations();
+      {
+         block_vector<int> v( arena );
+         for( int i = 0; i < 1000; ++i )
+            v.push_back( i );
+         BOOST_CHECK_EQUAL( v[999], 999 );
+
+         block_set<int> s( arena );
+         for( int i = 0; i < 100; ++i )
+            s.insert( i % 37 );
+         BOOST_CHECK_EQUAL( s.size(), 37u );
+
+         block_flat_map<int, std::string> m( arena );
+         m.emplace( 3, "three" );
+         m.emplace( 1, "one" );
+         BOOST_CHECK_EQUAL( m.begin()->second, "one" );
+      }
+      BOOST_CHECK_GT( arena.used(), 0u );
+
+      // the chunks are merged on reset, the next rounds fit into the one chunk
+      if( round > 0 )
+         BOOST_CHECK_EQUAL( arena.heap_allocations(), heap_allocations );
+
+      arena.reset();
+      BOOST_CHECK_EQUAL( arena.used(), 0u );
+   }
+}
+
+BOOST_AUTO_TEST_CASE( disabled_arena_uses_heap )
+{
+   block_arena arena;
+   arena.enable( false );
+   BOOST_CHECK( arena.enabled() );
+
+   arena.reset();
+   BOOST_CHECK( !arena.enabled() );
+
+   {
+      block_vector<int> v( arena );
+      v.assign( 10, 1 );
+   }
+   BOOST_CHECK_EQUAL( arena.allocations(), arena.heap_allocations() );
+   BOOST_CHECK_EQUAL( arena.capacity(), 0u );
+}
+
+BOOST_AUTO_TEST_CASE( arena_outside_scope_uses_heap )
+{
+   block_arena arena;
+   BOOST_CHECK( !arena.active() );
+
+   block_vector<int> outside( arena );
+   outside.assign( 10, 1 );
+   BOOST_CHECK_EQUAL( arena.allocations(), arena.heap_allocations() );
+   BOOST_CHECK_EQUAL( arena.capacity(), 0u );
+
+   {
+      block_arena::scope arena_scope( arena );
+      BOOST_CHECK( arena.active() );
+
+      // the heap buffer is released to the heap when the vector grows into the chunks
+      outside.assign( 1000, 2 );
+      block_vector<int> inside( arena );
+      inside.assign( 10, 3 );
+      BOOST_CHECK_GT( arena.used(), 0u );
+   }
+   BOOST_CHECK( !arena.active() );
+
+   // the chunk buffer is not passed to the heap when the vector grows outside the scope
+   const size_t used = arena.used();
+   outside.assign( 10000, 4 );
+   BOOST_CHECK_EQUAL( arena.used(), used );
+   BOOST_CHECK_EQUAL( outside[9999], 4 );
+}
+
+BOOST_AUTO_TEST_CASE( applied_operation_log_keeps_entries_in_place )
+{
+   block_arena arena;
+   block_arena::scope arena_scope( arena );
+   applied_operation_log log( arena );
+
+   const size_t count = 3 * applied_operation_log::page_size + 5;
+   std::vector<const applied_operation_log::entry*> entries;
+   for( size_t i = 0; i < count; ++i )
+   {
+      transfer_operation op;
+      op.amount = asset( static_cast<int64_t>( i ) );
+      auto& e = log.append( std::move( op ) );
+      e.virtual_op = static_cast<uint32_t>( i );
+      entries.push_back( &e );
+   }
+   BOOST_REQUIRE_EQUAL( log.size(), count );
+
+   // the entries are not relocated when the log grows
+   size_t i = 0;
+   for( const auto& e : log )
+   {
+      BOOST_CHECK_EQUAL( &e, entries[i] );
+      BOOST_CHECK_EQUAL( e.op.get<transfer_operation>().amount.amount.value, static_cast<int64_t>( i ) );
+      ++i;
+   }
+   BOOST_CHECK_EQUAL( i, count );
+
+   log.truncate( applied_operation_log::page_size );
+   BOOST_CHECK_EQUAL( log.size(), applied_operation_log::page_size );
+   BOOST_CHECK_EQUAL( log[applied_operation_log::page_size - 1].virtual_op, applied_operation_log::page_size - 1u );
+
+   log.release();
+   BOOST_CHECK( log.empty() );
+   BOOST_CHECK( log.begin() == log.end() );
+}
+
+BOOST_AUTO_TEST_CASE( arena_is_reset_by_applied_block )
+{
+   try {
+      generate_block();
+      transfer( account_id_type(), GRAPHENE_TEMP_ACCOUNT, asset( 1000 ) );
+      generate_block();
+
+      BOOST_CHECK_EQUAL( db.get_block_arena().used(), 0u );
+      BOOST_CHECK( db.get_applied_operations().empty() );
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+BOOST_AUTO_TEST_CASE( applied_operations_only_for_consumers )
+{
+   try {
+      ACTORS( (alice) );
+      generate_block();
+
+      // the history plugins of the fixture consume the applied operations
+      BOOST_REQUIRE( db.applied_operations_consumed() );
+
+      size_t recorded = 0;
+      auto connection = db.applied_block.connect( [&]( const signed_block& ) {
+         if( !db.applied_operations_recorded() )
+            return;
+         for( const auto& o_op : db.get_applied_operations() )
+            recorded += !o_op.removed;
+      } );
+
+      transfer( account_id_type(), alice_id, asset( 1000 ) );
+      generate_block();
+      BOOST_CHECK_GT( recorded, 0u );
+
+      // without consumers the blocks are applied the same way but nothing is recorded
+      recorded = 0;
+      uint32_t consumers = 0;
+      for( ; db.applied_operations_consumed(); ++consumers )
+         db.remove_applied_operations_consumer();
+
+      // the consumers are counted at the start of the block
+      BOOST_CHECK( db.applied_operations_recorded() );
+
+      transfer( account_id_type(), alice_id, asset( 1000 ) );
+      generate_block();
+      BOOST_CHECK_EQUAL( recorded, 0u );
+      BOOST_CHECK_EQUAL( get_balance( alice_id, asset_id_type() ), 2000 );
+      BOOST_CHECK( !db.applied_operations_recorded() );
+      BOOST_CHECK_THROW( db.get_applied_operations(), fc::exception );
+
+      for( ; consumers > 0; --consumers )
+         db.add_applied_operations_consumer();
+      connection.disconnect();
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -39,6 +39,7 @@
 #include <graphene/utilities/tempdir.hpp>
 
 #include <fc/crypto/digest.hpp>
+#include <fc/thread/thread.hpp>
 
 #include "../common/database_fixture.hpp"
 
@@ -129,6 +130,68 @@ BOOST_AUTO_TEST_CASE( block_database_test )
    }
 }
 
+BOOST_AUTO_TEST_CASE( block_database_cache_test )
+{
+   try {
+      fc::temp_directory data_dir( graphene::utilities::temp_directory_path() );
+
+      block_database bdb;
+      bdb.open( data_dir.path() );
+      bdb.set_cache_limits( 3, 1024 * 1024 );
+
+      vector<block_id_type> ids;
+      clearable_block b;
+      for( uint32_t i = 0; i < 5; ++i )
+      {
+         if( i > 0 ) b.previous = b.id();
+         b.witness = witness_id_type(i+1);
+         b.clear();
+         bdb.store( b.id(), b );
+         ids.push_back( b.id() );
+      }
+
+      auto stats = bdb.get_cache_stats();
+      BOOST_CHECK_EQUAL( stats.cached_headers, 3u );
+      BOOST_CHECK_EQUAL( stats.cached_blocks, 5u );
+
+      // recent headers are served from memory
+      auto header = bdb.fetch_header_by_number( 5 );
+      BOOST_REQUIRE( header.valid() );
+      BOOST_CHECK( header->id() == ids[4] );
+      BOOST_CHECK( bdb.fetch_block_id( 4 ) == ids[3] );
+      stats = bdb.get_cache_stats();
+      BOOST_CHECK_EQUAL( stats.header_hits, 2u );
+      BOOST_CHECK_EQUAL( stats.header_misses, 0u );
+
+      // evicted headers are read back from disk
+      bdb.set_cache_limits( 3, 0 );
+      header = bdb.fetch_header_by_number( 1 );
+      BOOST_REQUIRE( header.valid() );
+      BOOST_CHECK( header->id() == ids[0] );
+      BOOST_CHECK( header->witness == witness_id_type(1) );
+      stats = bdb.get_cache_stats();
+      BOOST_CHECK_EQUAL( stats.header_misses, 1u );
+      BOOST_CHECK_EQUAL( stats.cached_blocks, 0u );
+      BOOST_CHECK_EQUAL( stats.cached_block_bytes, 0u );
+
+      auto blk = bdb.fetch_by_number( 2 );
+      BOOST_REQUIRE( blk.valid() );
+      BOOST_CHECK( blk->id() == ids[1] );
+      BOOST_CHECK_EQUAL( bdb.get_cache_stats().block_misses, 1u );
+
+      // removed blocks must not be served from the cache
+      bdb.remove( ids[4] );
+      BOOST_CHECK( !bdb.fetch_header_by_number( 5 ).valid() );
+      BOOST_CHECK( !bdb.fetch_optional( ids[4] ).valid() );
+
+      bdb.close();
+      BOOST_CHECK_EQUAL( bdb.get_cache_stats().cached_headers, 0u );
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
 BOOST_AUTO_TEST_CASE( generate_empty_blocks )
 {
    try {
@@ -1416,6 +1479,73 @@ BOOST_AUTO_TEST_CASE( genesis_reserve_ids )
    }
 }
 
+BOOST_AUTO_TEST_CASE( genesis_bulk_load_matches_operations )
+{
+   try
+   {
+      genesis_state_type genesis_state = make_genesis();
+      genesis_state.initial_parameters.accounts_per_fee_scale = 64;
+      genesis_state.initial_parameters.account_fee_scale_bitshifts = 1;
+
+      // a few keys are shared by many accounts, so the key memberships hold sets of accounts
+      vector<public_key_type> keys;
+      for( uint32_t i = 0; i < 7; ++i )
+         keys.emplace_back( fc::ecc::private_key::regenerate( fc::sha256::hash( "genesis_key" + fc::to_string(i) ) ).get_public_key() );
+      for( uint32_t i = 0; i < 300; ++i )
+      {
+         const public_key_type& owner_key = keys[i % keys.size()];
+         const public_key_type& active_key = ( i % 3 == 0 ) ? public_key_type() : keys[(i / 2) % keys.size()];
+         genesis_state.initial_accounts.emplace_back( "genesis-user" + fc::to_string(i), owner_key, active_key, i % 4 == 0 );
+      }
+
+      fc::temp_directory bulk_dir( graphene::utilities::temp_directory_path() );
+      database bulk_db;
+      bulk_db.open( bulk_dir.path(), [&genesis_state]() { return genesis_state; }, "TEST" );
+
+      fc::temp_directory evaluated_dir( graphene::utilities::temp_directory_path() );
+      database evaluated_db;
+      evaluated_db.enable_genesis_bulk_load( false );
+      evaluated_db.open( evaluated_dir.path(), [&genesis_state]() { return genesis_state; }, "TEST" );
+
+      BOOST_TEST_MESSAGE( "The account and statistics objects are the same" );
+      const auto& bulk_accounts = bulk_db.get_index_type<account_index>().indices();
+      const auto& evaluated_accounts = evaluated_db.get_index_type<account_index>().indices();
+      BOOST_REQUIRE_EQUAL( bulk_accounts.size(), evaluated_accounts.size() );
+      for( const account_object& account : evaluated_accounts )
+      {
+         const account_object* bulk_account = bulk_db.find( account.get_id() );
+         BOOST_REQUIRE( bulk_account != nullptr );
+         BOOST_CHECK( fc::raw::pack( *bulk_account ) == fc::raw::pack( account ) );
+         BOOST_CHECK( fc::raw::pack( bulk_account->statistics( bulk_db ) ) == fc::raw::pack( account.statistics( evaluated_db ) ) );
+      }
+      BOOST_CHECK( fc::raw::pack( bulk_db.get_dynamic_global_properties() ) == fc::raw::pack( evaluated_db.get_dynamic_global_properties() ) );
+      BOOST_CHECK( fc::raw::pack( bulk_db.get_global_properties() ) == fc::raw::pack( evaluated_db.get_global_properties() ) );
+
+      BOOST_TEST_MESSAGE( "The secondary indexes built at once are the same as the ones built by the evaluators" );
+      const auto& bulk_index = dynamic_cast<const base_primary_index&>( bulk_db.get_index_type<account_index>() );
+      const auto& evaluated_index = dynamic_cast<const base_primary_index&>( evaluated_db.get_index_type<account_index>() );
+
+      const auto& bulk_members = bulk_index.get_secondary_index<account_member_index>();
+      const auto& evaluated_members = evaluated_index.get_secondary_index<account_member_index>();
+      BOOST_CHECK( bulk_members.account_to_account_memberships == evaluated_members.account_to_account_memberships );
+      BOOST_CHECK( bulk_members.account_to_key_memberships == evaluated_members.account_to_key_memberships );
+      BOOST_CHECK( bulk_members.account_to_address_memberships == evaluated_members.account_to_address_memberships );
+      BOOST_CHECK_GE( bulk_members.account_to_key_memberships.size(), keys.size() );
+
+      const auto& bulk_referrers = bulk_index.get_secondary_index<account_referrer_index>();
+      const auto& evaluated_referrers = evaluated_index.get_secondary_index<account_referrer_index>();
+      BOOST_CHECK( bulk_referrers.referred_by == evaluated_referrers.referred_by );
+
+      BOOST_CHECK_EQUAL( bulk_index.get_secondary_index<account_authority_revision_index>().revision(),
+                         evaluated_index.get_secondary_index<account_authority_revision_index>().revision() );
+   }
+   catch (fc::exception& e)
+   {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
 BOOST_FIXTURE_TEST_CASE( miss_some_blocks, database_fixture )
 { try {
    std::vector<witness_id_type> witnesses = witness_schedule_id_type()(db).current_shuffled_witnesses;
@@ -1923,4 +2053,122 @@ BOOST_FIXTURE_TEST_CASE( block_size_test, database_fixture )
    }
 }
 
+BOOST_FIXTURE_TEST_CASE( prepared_block_test, database_fixture )
+{
+   try
+   {
+      ACTORS((alice)(bob));
+
+      const fc::ecc::private_key& key = generate_private_key("null_key");
+      transfer(committee_account, alice_id, asset(10000000));
+      generate_block();
+
+      auto push_transfer = [&]( const asset& amount ) {
+         signed_transaction xfer_tx;
+         transfer_operation xfer_op;
+         xfer_op.from = alice_id;
+         xfer_op.to = bob_id;
+         xfer_op.amount = amount;
+         xfer_tx.operations.push_back( xfer_op );
+         set_expiration( db, xfer_tx );
+         sign( xfer_tx, alice_private_key );
+         PUSH_TX( db, xfer_tx, database::skip_nothing );
+      };
+
+      BOOST_TEST_MESSAGE( "The transactions pushed after the preparation are added to the block" );
+      push_transfer( asset(100) );
+      push_transfer( asset(200) );
+      db.prepare_block( db.get_scheduled_witness(1), database::skip_nothing );
+      push_transfer( asset(300) );
+
+      auto block = db.generate_block( db.get_slot_time(1), db.get_scheduled_witness(1), key, database::skip_nothing );
+      BOOST_CHECK_EQUAL( block.transactions.size(), 3u );
+      BOOST_CHECK_EQUAL( db.get_balance( bob_id, asset_id_type() ).amount.value, 600 );
+
+      BOOST_TEST_MESSAGE( "The prepared block is dropped by a block of another witness" );
+      push_transfer( asset(400) );
+      db.prepare_block( db.get_scheduled_witness(1), database::skip_nothing );
+
+      database db2;
+      fc::temp_directory data_dir2( graphene::utilities::temp_directory_path() );
+      db2.open( data_dir2.path(), make_genesis, "TEST" );
+      for( uint32_t num = 1; num <= db.head_block_num(); ++num )
+         db2.push_block( *db.fetch_block_by_number( num ), database::skip_transaction_signatures );
+      db.push_block( db2.generate_block( db2.get_slot_time(1), db2.get_scheduled_witness(1), key, database::skip_nothing ) );
+
+      // the transfer is still pending and is applied to the new head block state
+      push_transfer( asset(500) );
+      block = db.generate_block( db.get_slot_time(1), db.get_scheduled_witness(1), key, database::skip_nothing );
+      BOOST_CHECK_EQUAL( block.transactions.size(), 2u );
+      BOOST_CHECK_EQUAL( db.get_balance( bob_id, asset_id_type() ).amount.value, 1500 );
+   }
+   catch( fc::exception& e )
+   {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+
+BOOST_FIXTURE_TEST_CASE( parallel_block_building_with_concurrent_push, database_fixture )
+{
+   try
+   {
+      ACTORS((alice)(bob));
+
+      const fc::ecc::private_key& key = generate_private_key("null_key");
+      transfer(committee_account, alice_id, asset(10000000));
+      generate_block();
+
+      db.enable_parallel_block_building( true, 2 );
+
+      auto make_transfer = [&]( const asset& amount ) {
+         signed_transaction xfer_tx;
+         transfer_operation xfer_op;
+         xfer_op.from = alice_id;
+         xfer_op.to = bob_id;
+         xfer_op.amount = amount;
+         xfer_tx.operations.push_back( xfer_op );
+         set_expiration( db, xfer_tx );
+         sign( xfer_tx, alice_private_key );
+         return xfer_tx;
+      };
+
+      int64_t pending_amount = 0;
+      for( int64_t i = 1; i <= 50; ++i )
+      {
+         PUSH_TX( db, make_transfer( asset(i) ), database::skip_nothing );
+         pending_amount += i;
+      }
+
+      BOOST_TEST_MESSAGE( "A transaction is pushed by another task while the pending transactions are verified" );
+      signed_transaction late_tx = make_transfer( asset(10000) );
+      fc::future<void> late_push = fc::async( [&]() {
+         PUSH_TX( db, late_tx, database::skip_nothing );
+      }, "late push" );
+
+      auto block = db.generate_block( db.get_slot_time(1), db.get_scheduled_witness(1), key, database::skip_nothing );
+      late_push.wait();
+
+      BOOST_CHECK_EQUAL( block.transactions.size(), 50u );
+      // the late transfer is applied once, on top of the new head block
+      BOOST_CHECK_EQUAL( db.get_balance( bob_id, asset_id_type() ).amount.value, pending_amount + 10000 );
+
+      block = db.generate_block( db.get_slot_time(1), db.get_scheduled_witness(1), key, database::skip_nothing );
+      BOOST_REQUIRE_EQUAL( block.transactions.size(), 1u );
+      BOOST_CHECK( block.transactions.front().id() == late_tx.id() );
+
+      BOOST_TEST_MESSAGE( "The undo history matches the produced blocks" );
+      db.pop_block();
+      BOOST_CHECK_EQUAL( db.get_balance( bob_id, asset_id_type() ).amount.value, pending_amount );
+      db.pop_block();
+      BOOST_CHECK_EQUAL( db.get_balance( bob_id, asset_id_type() ).amount.value, 0 );
+   }
+   catch( fc::exception& e )
+   {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
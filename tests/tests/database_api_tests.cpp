@@ -1121,4 +1121,123 @@ BOOST_AUTO_TEST_CASE( api_limit_get_key_references ){
    throw;
    }
 }
+BOOST_AUTO_TEST_CASE( get_blocks )
+{ try {
+   graphene::app::database_api db_api( db, &( app.get_options() ));
+
+   generate_blocks( 5 );
+   const uint32_t head_num = db.head_block_num();
+
+   vector<signed_block> blocks = db_api.get_blocks( head_num - 4, 3 );
+   BOOST_REQUIRE_EQUAL( blocks.size(), 3u );
+   for( uint32_t i = 0; i < blocks.size(); ++i )
+   {
+      BOOST_CHECK_EQUAL( blocks[i].block_num(), head_num - 4 + i );
+      BOOST_CHECK( blocks[i].id() == db_api.get_block( head_num - 4 + i )->id() );
+   }
+
+   // the range ends at the head block
+   blocks = db_api.get_blocks( head_num - 1, 10 );
+   BOOST_REQUIRE_EQUAL( blocks.size(), 2u );
+   BOOST_CHECK_EQUAL( blocks.back().block_num(), head_num );
+
+   BOOST_CHECK( db_api.get_blocks( head_num + 1, 10 ).empty() );
+
+   GRAPHENE_CHECK_THROW( db_api.get_blocks( 1, app.get_options().api_limit_get_blocks + 1 ), fc::exception );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( get_order_book_levels )
+{ try {
+   ACTORS( (seller)(buyer) );
+
+   const auto& usd  = create_user_issued_asset( "USDUIA" );
+   const auto& core = asset_id_type()(db);
+   const asset_id_type usd_id = usd.id;
+   const asset_id_type core_id = core.id;
+   const string usd_symbol = usd.symbol;
+   const string core_symbol = core.symbol;
+
+   transfer( committee_account, seller_id, asset(10000000) );
+   issue_uia( buyer, usd.amount(10000) );
+
+   graphene::app::application_options opt;
+   opt.has_market_history_plugin = true;
+   graphene::app::database_api db_api( db, &opt );
+
+   // levels maintained by the plugin should match the levels aggregated from the orders
+   auto check_levels = [&]()
+   {
+      using graphene::market_history::order_book_level;
+      typedef std::map< price, order_book_level, std::greater<price> > side_type;
+      std::map< std::pair<asset_id_type, asset_id_type>, side_type > expected;
+      for( const auto& o : db.get_index_type<limit_order_index>().indices() )
+      {
+         auto& level = expected[ std::make_pair( o.sell_price.base.asset_id, o.sell_price.quote.asset_id ) ][ o.sell_price ];
+         if( level.orders == 0 )
+            level.sell_price = o.sell_price;
+         level.for_sale += o.for_sale;
+         level.to_receive += ( o.for_sale_asset() * o.sell_price ).amount;
+         ++level.orders;
+      }
+
+      const auto& levels_idx = db.get_index_type< primary_index< limit_order_index > >().get_secondary_index< graphene::market_history::order_book_index >();
+      for( const auto& market : { std::make_pair( core_id, usd_id ), std::make_pair( usd_id, core_id ) } )
+      {
+         const auto levels = levels_idx.get_levels( market.first, market.second, 50 );
+         const auto& side = expected[ market ];
+         BOOST_REQUIRE_EQUAL( levels.size(), side.size() );
+         auto itr = side.begin();
+         for( const auto& level : levels )
+         {
+            BOOST_CHECK( level.sell_price == itr->second.sell_price );
+            BOOST_CHECK_EQUAL( level.for_sale.value, itr->second.for_sale.value );
+            BOOST_CHECK_EQUAL( level.to_receive.value, itr->second.to_receive.value );
+            BOOST_CHECK_EQUAL( level.orders, itr->second.orders );
+            ++itr;
+         }
+      }
+
+      // the best levels have the prices of the best orders
+      const auto orders = db_api.get_order_book( core_symbol, usd_symbol, 1 );
+      const auto levels = db_api.get_order_book_levels( core_symbol, usd_symbol, 1 );
+      BOOST_REQUIRE_EQUAL( levels.bids.size(), orders.bids.size() );
+      BOOST_REQUIRE_EQUAL( levels.asks.size(), orders.asks.size() );
+      if( !orders.bids.empty() )
+         BOOST_CHECK_EQUAL( levels.bids[0].price, orders.bids[0].price );
+      if( !orders.asks.empty() )
+         BOOST_CHECK_EQUAL( levels.asks[0].price, orders.asks[0].price );
+   };
+
+   create_sell_order( seller, core.amount(1000), usd.amount(100) );
+   create_sell_order( seller, core.amount(2000), usd.amount(200) );
+   create_sell_order( seller, core.amount(3000), usd.amount(200) );
+   const auto* to_cancel = create_sell_order( seller, core.amount(5000), usd.amount(200) );
+   create_sell_order( buyer, usd.amount(100), core.amount(1100) );
+   create_sell_order( buyer, usd.amount(300), core.amount(3300) );
+   check_levels();
+
+   const auto levels = db_api.get_order_book_levels( core_symbol, usd_symbol );
+   BOOST_REQUIRE_EQUAL( levels.bids.size(), 3u );
+   BOOST_REQUIRE_EQUAL( levels.asks.size(), 1u );
+
+   generate_block();
+   check_levels();
+
+   // partially fills the best bid
+   create_sell_order( buyer, usd.amount(150), core.amount(1000) );
+   check_levels();
+
+   cancel_limit_order( *to_cancel );
+   check_levels();
+
+   generate_block();
+   check_levels();
+
+   db.pop_block();
+   check_levels();
+
+   BOOST_CHECK_THROW( db_api.get_order_book_levels( core_symbol, usd_symbol, 51 ), fc::exception );
+
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -310,4 +310,51 @@ BOOST_AUTO_TEST_CASE( required_approval_index_test ) // see https://github.com/b
 
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE( memory_usage_test )
+{ try {
+   ACTORS( (alice) );
+
+   auto find_usage = [this]( uint8_t space, uint8_t type ) {
+      for( const auto& usage : db.get_memory_usage() )
+         if( usage.space_id == space && usage.type_id == type )
+            return usage;
+      BOOST_FAIL( "index not reported" );
+      return index_memory_usage();
+   };
+
+   const auto before = find_usage( account_object::space_id, account_object::type_id );
+   BOOST_CHECK_EQUAL( before.object_count, db.get_index_type<account_index>().indices().size() );
+   BOOST_CHECK_EQUAL( before.object_bytes, before.object_count * sizeof( account_object ) );
+   BOOST_CHECK_GT( before.dynamic_bytes, 0u );
+   BOOST_CHECK_GT( before.container_bytes, 0u );
+   // account_member_index and account_referrer_index
+   BOOST_CHECK_GT( before.secondary_index_bytes, 0u );
+
+   const std::string long_name = std::string( 200, 'x' );
+   {
+      auto session = db._undo_db.start_undo_session();
+      db.modify( alice, [&]( account_object& a ) {
+         a.name = long_name;
+      });
+
+      const auto modified = find_usage( account_object::space_id, account_object::type_id );
+      BOOST_CHECK_EQUAL( modified.object_count, before.object_count );
+      BOOST_CHECK_GE( modified.dynamic_bytes, before.dynamic_bytes + long_name.size() );
+      BOOST_CHECK_EQUAL( modified.undo_entries, before.undo_entries + 1 );
+      BOOST_CHECK_GT( modified.undo_bytes, before.undo_bytes + sizeof( account_object ) );
+      BOOST_CHECK_GT( modified.total_bytes(), before.total_bytes() );
+
+      session.undo();
+   }
+
+   const auto after = find_usage( account_object::space_id, account_object::type_id );
+   BOOST_CHECK_EQUAL( after.undo_entries, before.undo_entries );
+
+   BOOST_CHECK_EQUAL( estimate_dynamic_memory_usage( std::string() ), 0u );
+   BOOST_CHECK_GE( estimate_dynamic_memory_usage( long_name ), long_name.size() );
+   vector<std::string> names( 4, long_name );
+   BOOST_CHECK_GE( estimate_dynamic_memory_usage( names ), 4 * ( sizeof( std::string ) + long_name.size() ) );
+
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2018 Total Games LLC and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/chain/database.hpp>
+#include <graphene/chain/hardfork.hpp>
+#include <graphene/chain/hardfork_state.hpp>
+
+#include "../common/database_fixture.hpp"
+
+#include <algorithm>
+
+using namespace graphene::chain;
+using namespace graphene::chain::test;
+
+namespace
+{
+   /// every flag must be the same as the time comparison it replaces
+   void check_hardfork_state( const hardfork_state& state, const fc::time_point_sec& now )
+   {
+#define CHECK_HARDFORK_FLAG( NAME, name ) \
+      BOOST_CHECK_MESSAGE( state.name == ( now >= HARDFORK_ ## NAME ## _TIME ), \
+                           #name " at " + now.to_iso_string() );
+      GRAPHENE_HARDFORKS( CHECK_HARDFORK_FLAG )
+#undef CHECK_HARDFORK_FLAG
+   }
+
+   std::vector<fc::time_point_sec> hardfork_times()
+   {
+      std::vector<fc::time_point_sec> times;
+#define ADD_HARDFORK_TIME( NAME, name ) times.push_back( HARDFORK_ ## NAME ## _TIME );
+      GRAPHENE_HARDFORKS( ADD_HARDFORK_TIME )
+#undef ADD_HARDFORK_TIME
+      std::sort( times.begin(), times.end() );
+      times.erase( std::unique( times.begin(), times.end() ), times.end() );
+      return times;
+   }
+}
+
+BOOST_FIXTURE_TEST_SUITE( hardfork_state_tests, database_fixture )
+
+BOOST_AUTO_TEST_CASE( hardfork_flags_at_boundaries )
+{
+   for( const auto& time : hardfork_times() )
+   {
+      for( const auto& now : { time - 1, time, time + 1 } )
+      {
+         hardfork_state state;
+         state.update( now );
+         check_hardfork_state( state, now );
+      }
+   }
+}
+
+BOOST_AUTO_TEST_CASE( hardfork_flags_follow_head_block )
+{
+   try {
+      for( const auto& time : hardfork_times() )
+      {
+         if( time <= db.head_block_time() )
+            continue;
+
+         // the last block before the hardfork and the first one after it
+         generate_blocks( time - db.get_global_properties().parameters.block_interval );
+         check_hardfork_state( db.hardforks(), db.head_block_time() );
+
+         generate_blocks( time );
+         check_hardfork_state( db.hardforks(), db.head_block_time() );
+
+         // the flags are recomputed for the restored head block
+         db.pop_block();
+         check_hardfork_state( db.hardforks(), db.head_block_time() );
+         generate_block();
+         check_hardfork_state( db.hardforks(), db.head_block_time() );
+      }
+   } FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2018 Total Games LLC, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/chain/market_object.hpp>
+#include <graphene/market_history/market_history_plugin.hpp>
+
+#include "../common/database_fixture.hpp"
+
+using namespace graphene::chain;
+using namespace graphene::chain::test;
+using namespace graphene::market_history;
+
+namespace
+{
+   /// the ticker and the bucket of a market with the fills applied one by one, as they were before
+   /// the plugin started to update them once per block
+   struct per_fill_expectation
+   {
+      optional<market_ticker_object> ticker;
+      optional<bucket_object>        bucket;
+
+      void apply( const fill_order_operation& o, const bucket_key& key )
+      {
+         if( !o.is_maker )
+            return;
+
+         price trade_price = o.pays / o.receives;
+         if( o.pays.asset_id > o.receives.asset_id )
+            trade_price = ~trade_price;
+
+         price fill_price = o.fill_price;
+         if( fill_price.base.asset_id > fill_price.quote.asset_id )
+            fill_price = ~fill_price;
+
+         if( !ticker.valid() )
+         {
+            ticker = market_ticker_object();
+            ticker->base = key.base;
+            ticker->quote = key.quote;
+         }
+         ticker->latest_base = fill_price.base.amount;
+         ticker->latest_quote = fill_price.quote.amount;
+         ticker->base_volume += trade_price.base.amount.value;
+         ticker->quote_volume += trade_price.quote.amount.value;
+
+         if( !bucket.valid() )
+         {
+            bucket = bucket_object();
+            bucket->key = key;
+            bucket->open_base = fill_price.base.amount;
+            bucket->open_quote = fill_price.quote.amount;
+            bucket->high_base = fill_price.base.amount;
+            bucket->high_quote = fill_price.quote.amount;
+            bucket->low_base = fill_price.base.amount;
+            bucket->low_quote = fill_price.quote.amount;
+         }
+         else
+         {
+            if( bucket->high() < fill_price )
+            {
+               bucket->high_base = fill_price.base.amount;
+               bucket->high_quote = fill_price.quote.amount;
+            }
+            if( bucket->low() > fill_price )
+            {
+               bucket->low_base = fill_price.base.amount;
+               bucket->low_quote = fill_price.quote.amount;
+            }
+         }
+         bucket->base_volume += trade_price.base.amount;
+         bucket->quote_volume += trade_price.quote.amount;
+         bucket->close_base = fill_price.base.amount;
+         bucket->close_quote = fill_price.quote.amount;
+      }
+   };
+
+   vector<fill_order_operation> get_block_fills( const database& db )
+   {
+      vector<fill_order_operation> fills;
+      for( const auto& o_op : db.get_applied_operations() )
+      {
+         if( !o_op.removed && o_op.op.which() == operation::tag<fill_order_operation>::value )
+            fills.push_back( o_op.op.get<fill_order_operation>() );
+      }
+      return fills;
+   }
+
+   void check_ticker( const database& db, const market_ticker_object& expected )
+   {
+      const auto& ticker_idx = db.get_index_type<market_ticker_index>().indices().get<by_market>();
+      auto itr = ticker_idx.find( std::make_tuple( expected.base, expected.quote ) );
+      BOOST_REQUIRE( itr != ticker_idx.end() );
+      BOOST_CHECK_EQUAL( itr->latest_base.value, expected.latest_base.value );
+      BOOST_CHECK_EQUAL( itr->latest_quote.value, expected.latest_quote.value );
+      BOOST_CHECK( itr->base_volume == expected.base_volume );
+      BOOST_CHECK( itr->quote_volume == expected.quote_volume );
+   }
+
+   void check_bucket( const database& db, const bucket_object& expected )
+   {
+      const auto& bucket_idx = db.get_index_type<bucket_index>().indices().get<by_key>();
+      auto itr = bucket_idx.find( expected.key );
+      BOOST_REQUIRE( itr != bucket_idx.end() );
+      BOOST_CHECK_EQUAL( itr->base_volume.value, expected.base_volume.value );
+      BOOST_CHECK_EQUAL( itr->quote_volume.value, expected.quote_volume.value );
+      BOOST_CHECK_EQUAL( itr->open_base.value, expected.open_base.value );
+      BOOST_CHECK_EQUAL( itr->open_quote.value, expected.open_quote.value );
+      BOOST_CHECK_EQUAL( itr->close_base.value, expected.close_base.value );
+      BOOST_CHECK_EQUAL( itr->close_quote.value, expected.close_quote.value );
+      BOOST_CHECK_EQUAL( itr->high_base.value, expected.high_base.value );
+      BOOST_CHECK_EQUAL( itr->high_quote.value, expected.high_quote.value );
+      BOOST_CHECK_EQUAL( itr->low_base.value, expected.low_base.value );
+      BOOST_CHECK_EQUAL( itr->low_quote.value, expected.low_quote.value );
+   }
+}
+
+BOOST_FIXTURE_TEST_SUITE( market_history_tests, database_fixture )
+
+/**
+ *  The fixture keeps 5 order history records per market and 15 seconds buckets.
+ *  The market of a block with many fills is updated once, the result must be the one of the fills applied one by one.
+ */
+BOOST_AUTO_TEST_CASE( market_history_multi_fill_block )
+{
+   try {
+      const uint32_t max_records = 5;
+
+      ACTORS( (maker)(taker) );
+
+      const auto& usd  = create_user_issued_asset( "USDUIA" );
+      const auto& core = asset_id_type()(db);
+
+      transfer( committee_account, maker_id, asset( 1000000 ) );
+      issue_uia( taker, usd.amount( 1000000 ) );
+      generate_block();
+
+      bucket_key key;
+      key.base = core.id;
+      key.quote = usd.id;
+      key.seconds = 15;
+
+      per_fill_expectation expected;
+
+      auto generate_fills_block = [&]() {
+         // the bucket of the block is known once the block is generated, the one before it is taken from a copy
+         const auto& bucket_idx = db.get_index_type<bucket_index>().indices().get<by_key>();
+         vector<bucket_object> buckets_before( bucket_idx.begin(), bucket_idx.end() );
+
+         generate_block();
+
+         key.open = fc::time_point_sec() + ( db.head_block_time().sec_since_epoch() / key.seconds * key.seconds );
+         expected.bucket.reset();
+         for( const auto& bucket : buckets_before )
+         {
+            if( bucket.key == key )
+               expected.bucket = bucket;
+         }
+
+         const auto fills = get_block_fills( db );
+         for( const auto& fill : fills )
+            expected.apply( fill, key );
+         return fills;
+      };
+
+      BOOST_TEST_MESSAGE( "A taker order fills maker orders of different prices in one block" );
+      for( uint32_t i = 0; i < 8; ++i )
+         create_sell_order( maker, core.amount( 100 ), usd.amount( 10 + ( i * 7 ) % 5 ) );
+      generate_block();
+
+      create_sell_order( taker, usd.amount( 1000 ), core.amount( 800 ) );
+      auto fills = generate_fills_block();
+      BOOST_REQUIRE_EQUAL( fills.size(), 16u );
+
+      check_ticker( db, *expected.ticker );
+      check_bucket( db, *expected.bucket );
+
+      // the newest records go first
+      auto history = get_market_order_history( core.id, usd.id );
+      BOOST_REQUIRE_EQUAL( history.size(), max_records );
+      for( uint32_t i = 0; i < max_records; ++i )
+      {
+         BOOST_CHECK( history[i].op.order_id == fills[fills.size() - 1 - i].order_id );
+         BOOST_CHECK( history[i].op.is_maker == fills[fills.size() - 1 - i].is_maker );
+         BOOST_CHECK( history[i].time == db.head_block_time() );
+      }
+
+      BOOST_TEST_MESSAGE( "The fills of the next block continue the ticker and the records of the previous one" );
+      const auto last_fills = fills;
+      // fills the rest of the taker order
+      create_sell_order( maker, core.amount( 100 ), usd.amount( 12 ) );
+      fills = generate_fills_block();
+      BOOST_REQUIRE_EQUAL( fills.size(), 2u );
+
+      check_ticker( db, *expected.ticker );
+      check_bucket( db, *expected.bucket );
+
+      history = get_market_order_history( core.id, usd.id );
+      BOOST_REQUIRE_EQUAL( history.size(), max_records );
+      BOOST_CHECK( history[0].op.order_id == fills[1].order_id );
+      BOOST_CHECK( history[1].op.order_id == fills[0].order_id );
+      for( uint32_t i = 2; i < max_records; ++i )
+         BOOST_CHECK( history[i].op.order_id == last_fills[last_fills.size() + 1 - i].order_id );
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2018 Total Games LLC, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/net/packed_item_cache.hpp>
+
+using namespace graphene::net;
+
+namespace
+{
+   item_id make_item( uint32_t n )
+   {
+      return item_id( block_message_type, fc::ripemd160::hash( (const char*)&n, sizeof(n) ) );
+   }
+
+   std::shared_ptr<const message> make_packed( size_t size )
+   {
+      auto result = std::make_shared<message>();
+      result->msg_type = block_message_type;
+      result->data.resize( size );
+      result->size = (uint32_t)size;
+      return result;
+   }
+}
+
+BOOST_AUTO_TEST_SUITE(packed_item_cache_tests)
+
+BOOST_AUTO_TEST_CASE( least_recently_used_items_are_evicted )
+{
+   packed_item_cache cache( 1000 );
+
+   for( uint32_t i = 1; i <= 3; ++i )
+      cache.insert( make_item( i ), make_packed( 300 ) );
+   BOOST_CHECK_EQUAL( cache.size(), 3u );
+   BOOST_CHECK_EQUAL( cache.size_in_bytes(), 900u );
+
+   // the lookup makes the first item the most recently used one, so the second is evicted
+   BOOST_REQUIRE( cache.find( make_item( 1 ) ) );
+   cache.insert( make_item( 4 ), make_packed( 300 ) );
+
+   BOOST_CHECK_EQUAL( cache.size(), 3u );
+   BOOST_CHECK_EQUAL( cache.size_in_bytes(), 900u );
+   BOOST_CHECK( !cache.find( make_item( 2 ) ) );
+   BOOST_CHECK( cache.find( make_item( 1 ) ) );
+   BOOST_CHECK( cache.find( make_item( 3 ) ) );
+   BOOST_CHECK( cache.find( make_item( 4 ) ) );
+}
+
+BOOST_AUTO_TEST_CASE( packed_size_stays_within_budget )
+{
+   packed_item_cache cache( 1000 );
+
+   // an item larger than the budget is not cached and does not evict the others
+   cache.insert( make_item( 1 ), make_packed( 400 ) );
+   cache.insert( make_item( 2 ), make_packed( 1001 ) );
+   BOOST_CHECK_EQUAL( cache.size(), 1u );
+   BOOST_CHECK_EQUAL( cache.size_in_bytes(), 400u );
+   BOOST_CHECK( !cache.find( make_item( 2 ) ) );
+
+   // the item inserted again replaces its old size
+   cache.insert( make_item( 1 ), make_packed( 100 ) );
+   BOOST_CHECK_EQUAL( cache.size(), 1u );
+   BOOST_CHECK_EQUAL( cache.size_in_bytes(), 100u );
+
+   // an item of the whole budget evicts everything else
+   cache.insert( make_item( 3 ), make_packed( 1000 ) );
+   BOOST_CHECK_EQUAL( cache.size(), 1u );
+   BOOST_CHECK_EQUAL( cache.size_in_bytes(), 1000u );
+   BOOST_CHECK( cache.find( make_item( 3 ) ) );
+
+   for( uint32_t i = 10; i < 100; ++i )
+   {
+      cache.insert( make_item( i ), make_packed( 70 + i ) );
+      BOOST_CHECK_LE( cache.size_in_bytes(), 1000u );
+   }
+}
+
+BOOST_AUTO_TEST_CASE( repack_counters )
+{
+   packed_item_cache cache( 1000 );
+
+   BOOST_CHECK( !cache.find( make_item( 1 ) ) );
+   cache.insert( make_item( 1 ), make_packed( 250 ) );
+   BOOST_CHECK( cache.find( make_item( 1 ) ) );
+   BOOST_CHECK( cache.find( make_item( 1 ) ) );
+   BOOST_CHECK( !cache.find( make_item( 2 ) ) );
+
+   BOOST_CHECK_EQUAL( cache.hits(), 2u );
+   BOOST_CHECK_EQUAL( cache.misses(), 2u );
+   BOOST_CHECK_EQUAL( cache.bytes_saved(), 500u );
+
+   fc::variant_object stats = cache.get_statistics();
+   BOOST_CHECK_EQUAL( stats["items"].as_uint64(), 1u );
+   BOOST_CHECK_EQUAL( stats["size_in_bytes"].as_uint64(), 250u );
+   BOOST_CHECK_EQUAL( stats["hits"].as_uint64(), 2u );
+   BOOST_CHECK_EQUAL( stats["misses"].as_uint64(), 2u );
+   BOOST_CHECK_EQUAL( stats["repack_bytes_saved"].as_uint64(), 500u );
+}
+
+BOOST_AUTO_TEST_SUITE_END()